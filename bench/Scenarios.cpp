@@ -0,0 +1,217 @@
+#include "Scenarios.hpp"
+#include "main/Component.hpp"
+#include "main/EventSystem.hpp"
+#include "main/GameObject.hpp"
+#include "main/Log.hpp"
+#include "utilities/Quaternion.hpp"
+#include "utilities/Random.hpp"
+#include "utilities/Stream.hpp"
+#include "utilities/Vector3.hpp"
+#ifdef StevEngine_PHYSICS
+#include "physics/Colliders.hpp"
+#include "physics/RigidBody.hpp"
+#endif
+#ifdef StevEngine_NETWORKING
+#include "networking/client.hpp"
+#include "networking/server.hpp"
+#endif
+
+#include <deque>
+#include <format>
+
+using namespace StevEngine;
+using namespace StevEngine::Utilities;
+
+/** @brief Component with a small amount of per frame work */
+class Spinner : public Component {
+	public:
+		std::string GetType() const override { return "Spinner"; }
+		void Update(double deltaTime) override {
+			GameObject& object = GetParent();
+			object.SetRotation(object.GetRotation() * Quaternion::FromAngleAxis(deltaTime, Vector3::up));
+		}
+};
+
+/** @brief Creates and destroys objects with components every frame */
+class SpawnChurn : public Scenario {
+	public:
+		std::string GetName() const override { return "spawn_churn"; }
+		void Frame(Scene& scene) override {
+			for (int i = 0; i < spawnPerFrame; i++) {
+				GameObject& object = scene.GetObject(scene.CreateObject("Churn", Vector3(GetRandomDouble(-100, 100), 0, GetRandomDouble(-100, 100))));
+				object.AddComponent(new Spinner());
+				alive.push_back(object.Handle());
+			}
+			while (alive.size() > maxAlive) {
+				scene.DestroyObject(alive.front());
+				alive.pop_front();
+			}
+		}
+		void Teardown(Scene& scene) override { alive.clear(); }
+	private:
+		static constexpr int spawnPerFrame = 256;
+		static constexpr size_t maxAlive = 4096;
+		std::deque<ObjectHandle> alive;
+};
+
+/** @brief Moves the roots of long object chains, so every world transform below them changes */
+class DeepHierarchy : public Scenario {
+	public:
+		std::string GetName() const override { return "deep_hierarchy"; }
+		void Setup(Scene& scene) override {
+			for (int chain = 0; chain < chains; chain++) {
+				ID parent = scene.CreateObject("Root", Vector3(chain, 0, 0));
+				roots.push_back(scene.GetObject(parent).Handle());
+				for (int depth = 1; depth < chainDepth; depth++) {
+					ID child = scene.CreateObject("Link", Vector3(0, 1, 0), Quaternion::FromAngleAxis(0.01, Vector3::forward));
+					scene.GetObject(parent).AddChild(child);
+					parent = child;
+				}
+				leaves.push_back(scene.GetObject(parent).Handle());
+			}
+		}
+		void Frame(Scene& scene) override {
+			for (ObjectHandle root : roots) {
+				GameObject& object = scene.GetObject(root);
+				object.SetRotation(object.GetRotation() * Quaternion::FromAngleAxis(0.01, Vector3::up));
+			}
+			//Read back leaf transforms, as rendering would
+			for (ObjectHandle leaf : leaves) sink += scene.GetObject(leaf).GetWorldPosition().X;
+		}
+		void Teardown(Scene& scene) override { roots.clear(); leaves.clear(); }
+	private:
+		static constexpr int chains = 32;
+		static constexpr int chainDepth = 128;
+		std::vector<ObjectHandle> roots;
+		std::vector<ObjectHandle> leaves;
+		double sink = 0;
+};
+
+#ifdef StevEngine_PHYSICS
+/** @brief Drops columns of boxes onto a floor, so they collide and come to rest in piles */
+class PhysicsPileup : public Scenario {
+	public:
+		std::string GetName() const override { return "physics_pileup"; }
+		void Setup(Scene& scene) override {
+			GameObject& floor = scene.GetObject(scene.CreateObject("Floor", Vector3(0), Quaternion(), Vector3(100, 1, 100)));
+			floor.AddComponent(new Physics::CubeCollider());
+			floor.AddComponent(new Physics::RigidBody(JPH::EMotionType::Static, Physics::LayerManager::STATIC));
+			for (int column = 0; column < columns; column++) {
+				double x = (column % 10) * 4 - 18, z = (column / 10) * 4 - 18;
+				for (int i = 0; i < columnHeight; i++) {
+					GameObject& box = scene.GetObject(scene.CreateObject("Box", Vector3(x + GetRandomDouble(-0.2, 0.2), 2 + i * 1.5, z + GetRandomDouble(-0.2, 0.2))));
+					box.AddComponent(new Physics::CubeCollider());
+					box.AddComponent(new Physics::RigidBody(JPH::EMotionType::Dynamic, Physics::LayerManager::DEFAULT));
+				}
+			}
+		}
+	private:
+		static constexpr int columns = 100;
+		static constexpr int columnHeight = 10;
+};
+#endif
+
+/** @brief Event published by the fan-out scenario */
+class BenchEvent : public Event {
+	public:
+		BenchEvent(int value) : value(value) {}
+		const std::string GetEventType() const override { return GetStaticEventType(); };
+		static const std::string GetStaticEventType() {  return "BenchEvent"; }
+		const int value;
+};
+
+/** @brief Publishes events to a large number of subscribers */
+class EventFanout : public Scenario {
+	public:
+		std::string GetName() const override { return "event_fanout"; }
+		void Setup(Scene& scene) override {
+			events = std::make_unique<EventManager>();
+			for (int i = 0; i < subscribers; i++) {
+				events->Subscribe<BenchEvent>([this] (const BenchEvent& e) { sum += e.value; });
+			}
+		}
+		void Frame(Scene& scene) override {
+			for (int i = 0; i < publishesPerFrame; i++) events->Publish(BenchEvent(i));
+		}
+		void Teardown(Scene& scene) override { events.reset(); }
+	private:
+		static constexpr int subscribers = 10000;
+		static constexpr int publishesPerFrame = 16;
+		std::unique_ptr<EventManager> events;
+		int64_t sum = 0;
+};
+
+/** @brief Serializes a scene with nested objects and loads it back every frame */
+class SceneSerialize : public Scenario {
+	public:
+		std::string GetName() const override { return "scene_serialize"; }
+		void Setup(Scene& scene) override {
+			for (int i = 0; i < roots; i++) {
+				ID root = scene.CreateObject("Root", Vector3(GetRandomDouble(-100, 100), 0, GetRandomDouble(-100, 100)));
+				for (int j = 0; j < childrenPerRoot; j++) {
+					ID child = scene.CreateObject("Child", Vector3(j, 0, 0));
+					scene.GetObject(root).AddChild(child);
+					scene.GetObject(child).AddChild(scene.CreateObject("Grandchild", Vector3(0, 1, 0)));
+				}
+			}
+		}
+		void Frame(Scene& scene) override {
+			Stream stream = scene.Export(StreamType::Binary);
+			std::string name;
+			stream >> name;
+			Scene copy(name + " copy", stream);
+		}
+	private:
+		static constexpr int roots = 200;
+		static constexpr int childrenPerRoot = 4;
+};
+
+#ifdef StevEngine_NETWORKING
+/**
+ * @brief Sends reliable messages from a server to a client in the same process
+ *
+ * The server only reads one message per client each update, while the client reads every waiting message,
+ * so messages are sent to the client to not fill up the socket buffers.
+ */
+class NetworkThroughput : public Scenario {
+	public:
+		std::string GetName() const override { return "network_throughput"; }
+		void Setup(Scene& scene) override {
+			server = std::make_unique<Networking::Server::Manager>(port);
+			client = std::make_unique<Networking::Client::Manager>("127.0.0.1", port);
+			client->listen(messageID, [this] (Networking::MessageData data) { received++; });
+		}
+		void Frame(Scene& scene) override {
+			Stream payload;
+			for (int i = 0; i < 16; i++) payload << (uint32_t)i;
+			//Messages are only sent to clients that have finished the connection handshake
+			for (int i = 0; i < messagesPerFrame; i++) server->send(messageID, payload, true);
+		}
+		void Teardown(Scene& scene) override {
+			//The managers stay subscribed to engine events, so they are kept until the engine has stopped
+			Log::Normal(std::format("Network throughput: received {} messages", received));
+		}
+	private:
+		static constexpr int port = 40123;
+		static constexpr Networking::MessageID messageID = 100;
+		static constexpr int messagesPerFrame = 256;
+		std::unique_ptr<Networking::Server::Manager> server;
+		std::unique_ptr<Networking::Client::Manager> client;
+		uint64_t received = 0;
+};
+#endif
+
+std::vector<std::unique_ptr<Scenario>> CreateScenarios() {
+	std::vector<std::unique_ptr<Scenario>> scenarios;
+	scenarios.push_back(std::make_unique<SpawnChurn>());
+	scenarios.push_back(std::make_unique<DeepHierarchy>());
+	#ifdef StevEngine_PHYSICS
+	scenarios.push_back(std::make_unique<PhysicsPileup>());
+	#endif
+	scenarios.push_back(std::make_unique<EventFanout>());
+	scenarios.push_back(std::make_unique<SceneSerialize>());
+	#ifdef StevEngine_NETWORKING
+	scenarios.push_back(std::make_unique<NetworkThroughput>());
+	#endif
+	return scenarios;
+}
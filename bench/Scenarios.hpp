@@ -0,0 +1,46 @@
+#pragma once
+#include "main/Scene.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reproducible workload run for a fixed number of frames
+ *
+ * Scenarios are set up in an empty scene, and every object left in the scene is destroyed after teardown.
+ */
+class Scenario {
+	public:
+		virtual ~Scenario() = default;
+
+		/**
+		 * @brief Get name used to select and report the scenario
+		 * @return Scenario name
+		 */
+		virtual std::string GetName() const = 0;
+
+		/**
+		 * @brief Create the scenario's objects, not measured
+		 * @param scene Scene to create objects in
+		 */
+		virtual void Setup(StevEngine::Scene& scene) {}
+
+		/**
+		 * @brief Run work of one frame, on top of the regular engine update
+		 * @param scene Scene of the scenario
+		 */
+		virtual void Frame(StevEngine::Scene& scene) {}
+
+		/**
+		 * @brief Release anything not owned by the scene, not measured
+		 * @param scene Scene of the scenario
+		 */
+		virtual void Teardown(StevEngine::Scene& scene) {}
+};
+
+/**
+ * @brief Create every scenario supported by the current build
+ * @return List of scenarios
+ */
+std::vector<std::unique_ptr<Scenario>> CreateScenarios();
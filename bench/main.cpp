@@ -0,0 +1,268 @@
+#include "Scenarios.hpp"
+#include "main/Engine.hpp"
+#include "main/EngineEvents.hpp"
+#include "main/SceneManager.hpp"
+#include "utilities/Random.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+
+using namespace StevEngine;
+
+//Count every heap allocation in the process
+static std::atomic<uint64_t> allocationCount = 0;
+void* operator new(std::size_t size) {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+	throw std::bad_alloc();
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+/** @brief Reset peak resident memory to the current resident memory, returns false if not supported */
+bool ResetPeakRSS() {
+	#ifdef __linux__
+	std::ofstream file("/proc/self/clear_refs");
+	file << "5";
+	file.flush();
+	return file.good();
+	#else
+	return false;
+	#endif
+}
+
+/** @brief Get peak resident memory in KB since the last ResetPeakRSS, or of the whole process if it could not be reset, 0 if unknown */
+long GetPeakRSS() {
+	#ifdef __linux__
+	std::ifstream file("/proc/self/status");
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.rfind("VmHWM:", 0) == 0) return std::atol(line.c_str() + 6);
+	}
+	#endif
+	#ifdef __unix__
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+	#else
+	return 0;
+	#endif
+}
+
+/** @brief Measurements of one scenario */
+struct Result {
+	std::string name;
+	uint32_t frames = 0;
+	double mean = 0, p50 = 0, p99 = 0, max = 0;	///< Frame times in ms
+	uint64_t allocations = 0;					///< Heap allocations during measured frames
+	long peakRSS = 0;							///< Peak resident memory during the scenario in KB
+};
+
+/** @brief Command line options */
+struct Options {
+	uint32_t frames = 300;							///< Measured frames per scenario
+	uint32_t warmup = 30;							///< Unmeasured frames before measuring
+	unsigned int seed = 1234;						///< Random seed
+	std::vector<std::string> scenarios;				///< Scenarios to run, all if empty
+	std::string output = "bench_results.csv";		///< CSV file to write results to
+	std::string baseline;							///< CSV file of earlier results to compare against
+	double tolerance = 0.15;						///< Allowed relative increase over the baseline
+};
+
+static const char* header = "scenario,frames,mean_ms,p50_ms,p99_ms,max_ms,allocations,peak_rss_kb";
+
+/** @brief Runs scenarios one after another from engine updates */
+class Runner {
+	public:
+		Runner(const Options& options, std::vector<std::unique_ptr<Scenario>> scenarios) : options(options), scenarios(std::move(scenarios)) {}
+
+		void Update() {
+			Scene& scene = sceneManager.GetActiveScene();
+			auto now = std::chrono::steady_clock::now();
+			if (current == scenarios.size()) {
+				engine->running = false;
+				return;
+			}
+			Scenario& scenario = *scenarios[current];
+			if (frame == 0) {
+				//Only count memory used from this scenario on
+				if (!ResetPeakRSS() && current == 0) std::fprintf(stderr, "Peak RSS can not be reset, it is measured for the whole process\n");
+				Utilities::SetRandomSeed(options.seed);
+				scenario.Setup(scene);
+			}
+			else if (frame == options.warmup) {
+				startAllocations = allocationCount.load();
+				frameTimes.clear();
+			}
+			else if (frame > options.warmup) frameTimes.push_back(std::chrono::duration<double, std::milli>(now - lastFrame).count());
+			lastFrame = now;
+			//Finish after the last measured frame
+			if (frameTimes.size() == options.frames) {
+				Finish(scenario, scene);
+				return;
+			}
+			scenario.Frame(scene);
+			frame++;
+		}
+
+		const std::vector<Result>& GetResults() const { return results; }
+
+	private:
+		void Finish(Scenario& scenario, Scene& scene) {
+			Result result;
+			result.name = scenario.GetName();
+			result.frames = frameTimes.size();
+			result.allocations = allocationCount.load() - startAllocations;
+			std::sort(frameTimes.begin(), frameTimes.end());
+			for (double time : frameTimes) result.mean += time;
+			result.mean /= frameTimes.size();
+			result.p50 = frameTimes[(frameTimes.size() - 1) * 50 / 100];
+			result.p99 = frameTimes[(frameTimes.size() - 1) * 99 / 100];
+			result.max = frameTimes.back();
+			result.peakRSS = GetPeakRSS();
+			results.push_back(result);
+			std::printf("%-20s mean %8.3f ms  p99 %8.3f ms  allocations %10llu  peak RSS %8ld KB\n", result.name.c_str(), result.mean, result.p99, (unsigned long long)result.allocations, result.peakRSS);
+			//Clear the scene for the next scenario
+			scenario.Teardown(scene);
+			std::vector<ObjectHandle> objects;
+			scene.ForEachParentObject([&objects] (GameObject& object) { objects.push_back(object.Handle()); });
+			for (ObjectHandle object : objects) scene.DestroyObject(object);
+			frameTimes.clear();
+			current++;
+			frame = 0;
+		}
+
+		const Options& options;
+		std::vector<std::unique_ptr<Scenario>> scenarios;
+		size_t current = 0;
+		uint32_t frame = 0;
+		std::chrono::steady_clock::time_point lastFrame;
+		std::vector<double> frameTimes;
+		uint64_t startAllocations = 0;
+		std::vector<Result> results;
+};
+
+bool WriteResults(const std::string& path, const std::vector<Result>& results) {
+	std::ofstream file(path);
+	if (!file.is_open()) return false;
+	file << header << "\n";
+	for (const Result& result : results) {
+		file << result.name << "," << result.frames << "," << result.mean << "," << result.p50 << "," << result.p99 << ","
+			<< result.max << "," << result.allocations << "," << result.peakRSS << "\n";
+	}
+	return file.good();
+}
+
+std::map<std::string, Result> ReadResults(const std::string& path) {
+	std::map<std::string, Result> results;
+	std::ifstream file(path);
+	std::string line;
+	if (!std::getline(file, line) || line != header) {
+		std::fprintf(stderr, "Baseline %s is missing or has an unknown format\n", path.c_str());
+		return results;
+	}
+	while (std::getline(file, line)) {
+		std::stringstream row(line);
+		Result result;
+		char comma;
+		if (!std::getline(row, result.name, ',')) continue;
+		row >> result.frames >> comma >> result.mean >> comma >> result.p50 >> comma >> result.p99 >> comma
+			>> result.max >> comma >> result.allocations >> comma >> result.peakRSS;
+		if (row.fail()) continue;
+		results[result.name] = result;
+	}
+	return results;
+}
+
+/** @brief Compare results against a baseline, returns the number of regressions */
+int CompareResults(const std::vector<Result>& results, const std::map<std::string, Result>& baseline, double tolerance) {
+	int regressions = 0;
+	auto check = [&] (const std::string& scenario, const char* metric, double value, double base) {
+		if (value <= base * (1 + tolerance)) return;
+		if (base == 0) std::fprintf(stderr, "REGRESSION %s %s: 0 -> %.3f\n", scenario.c_str(), metric, value);
+		else std::fprintf(stderr, "REGRESSION %s %s: %.3f -> %.3f (+%.1f%%)\n", scenario.c_str(), metric, base, value, (value / base - 1) * 100);
+		regressions++;
+	};
+	for (const Result& result : results) {
+		auto base = baseline.find(result.name);
+		if (base == baseline.end()) continue;
+		check(result.name, "mean_ms", result.mean, base->second.mean);
+		check(result.name, "p99_ms", result.p99, base->second.p99);
+		check(result.name, "allocations", result.allocations, base->second.allocations);
+	}
+	return regressions;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (i + 1 == argc) {
+			std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--frames") options.frames = std::max(1, std::stoi(value));
+		else if (arg == "--warmup") options.warmup = std::max(1, std::stoi(value));
+		else if (arg == "--seed") options.seed = std::stoul(value);
+		else if (arg == "--scenario") options.scenarios.push_back(value);
+		else if (arg == "--output") options.output = value;
+		else if (arg == "--baseline") options.baseline = value;
+		else if (arg == "--tolerance") options.tolerance = std::stod(value);
+		else {
+			std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		std::fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--seed N] [--scenario NAME]... [--output FILE] [--baseline FILE] [--tolerance FRACTION]\n", argv[0]);
+		return 2;
+	}
+	//Select scenarios
+	std::vector<std::unique_ptr<Scenario>> scenarios;
+	for (std::unique_ptr<Scenario>& scenario : CreateScenarios()) {
+		if (options.scenarios.empty() || std::find(options.scenarios.begin(), options.scenarios.end(), scenario->GetName()) != options.scenarios.end())
+			scenarios.push_back(std::move(scenario));
+	}
+	if (scenarios.empty()) {
+		std::fprintf(stderr, "No matching scenarios\n");
+		return 2;
+	}
+
+	//Run unlimited frames, with one fixed update of the same length every frame
+	CreateEngine("StevEngine Bench", { .targetFPS = -1, .tickRate = 60, .maxSubsteps = 1 });
+	engine->SetTargetFPS(-1);
+	engine->SetTickRate(60, 1);
+	engine->SetFixedFrameTime(1.0 / 60);
+	sceneManager.CreateScene("Bench");
+	sceneManager.SetActiveScene("Bench");
+	Runner runner(options, std::move(scenarios));
+	engine->GetEvents().Subscribe<UpdateEvent>([&runner] (UpdateEvent) { runner.Update(); });
+	engine->Start();
+
+	if (!WriteResults(options.output, runner.GetResults())) {
+		std::fprintf(stderr, "Failed to write results to %s\n", options.output.c_str());
+		return 2;
+	}
+	if (!options.baseline.empty()) {
+		int regressions = CompareResults(runner.GetResults(), ReadResults(options.baseline), options.tolerance);
+		if (regressions > 0) return 1;
+	}
+	return 0;
+}
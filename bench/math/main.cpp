@@ -0,0 +1,181 @@
+#include "utilities/Matrix4.hpp"
+#include "utilities/Quaternion.hpp"
+#include "utilities/Random.hpp"
+#include "utilities/SIMD.hpp"
+#include "utilities/Vector3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace StevEngine::Utilities;
+
+/** @brief Keep a value from being optimized away, without storing it */
+template<typename T> inline void DoNotOptimize(const T& value) {
+	#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+	#else
+	static volatile const void* sink;
+	sink = &value;
+	#endif
+}
+
+/** @brief Number of inputs looped over, small enough to stay in cache */
+static constexpr size_t inputCount = 1024;
+
+/** @brief Random inputs, so results can not be computed at compile time */
+struct Inputs {
+	std::array<Vector3, inputCount> vectors;
+	std::array<Quaternion, inputCount> rotations;
+	std::array<Matrix4, inputCount> matrices;
+	std::array<double, inputCount> factors;
+	std::array<Vector3, inputCount> outVectors;
+	std::array<Matrix4, inputCount> outMatrices;
+	std::array<Matrix4f, inputCount> outFloats;
+
+	Inputs() {
+		SetRandomSeed(1234);
+		for (size_t i = 0; i < inputCount; i++) {
+			vectors[i] = Vector3(GetRandomDouble(-100, 100), GetRandomDouble(-100, 100), GetRandomDouble(-100, 100));
+			rotations[i] = Quaternion::FromAngleAxis(GetRandomDouble(-3, 3), Vector3(GetRandomDouble(-1, 1), GetRandomDouble(-1, 1), GetRandomDouble(-1, 1)).Normalized());
+			matrices[i] = Matrix4::FromTranslationRotationScale(vectors[i], rotations[i], Vector3(GetRandomDouble(0.5, 2)));
+			factors[i] = GetRandomDouble(1);
+		}
+	}
+};
+
+/** @brief Number of elements per batch call, batch benchmarks report time per element */
+static constexpr size_t batchSize = 16;
+
+/** @brief Timing of one benchmark */
+struct Result {
+	std::string name;
+	double nsPerOp;
+};
+
+class Runner {
+	public:
+		Runner(std::string filter, double minSeconds) : filter(filter), minSeconds(minSeconds) {}
+
+		/**
+		 * @brief Time a function running one operation on input i
+		 *
+		 * The number of iterations is doubled until one run takes long enough, and the fastest of several runs is kept.
+		 */
+		template<typename Function> void Run(const std::string& name, Function&& function) {
+			if (!filter.empty() && name.find(filter) == std::string::npos) return;
+			size_t iterations = inputCount;
+			double seconds = 0;
+			while (true) {
+				seconds = Time(function, iterations);
+				if (seconds >= minSeconds) break;
+				iterations *= 2;
+			}
+			double best = seconds;
+			for (int run = 1; run < runs; run++) best = std::min(best, Time(function, iterations));
+			Result result = { name, best * 1e9 / iterations };
+			std::printf("%-36s %10.2f ns/op %10.1f Mop/s\n", name.c_str(), result.nsPerOp, 1e3 / result.nsPerOp);
+			results.push_back(result);
+		}
+
+		const std::vector<Result>& GetResults() const { return results; }
+
+	private:
+		template<typename Function> static double Time(Function& function, size_t iterations) {
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < iterations; i++) function(i % inputCount);
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		static constexpr int runs = 5;
+		std::string filter;
+		double minSeconds;
+		std::vector<Result> results;
+};
+
+int main(int argc, char** argv) {
+	std::string filter, output;
+	double minSeconds = 0.1;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		std::string arg = argv[i];
+		if (arg == "--filter") filter = argv[i + 1];
+		else if (arg == "--output") output = argv[i + 1];
+		else if (arg == "--min-time") minSeconds = std::stod(argv[i + 1]);
+	}
+
+	static Inputs in;
+	Runner runner(filter, minSeconds);
+	auto next = [] (size_t i) { return (i + 1) % inputCount; };
+	std::printf("Math backend: %s\n", SIMD::backend);
+
+	//Vector3
+	runner.Run("Vector3 add", [&] (size_t i) { DoNotOptimize(in.vectors[i] + in.vectors[next(i)]); });
+	runner.Run("Vector3 scale", [&] (size_t i) { DoNotOptimize(in.vectors[i] * in.factors[i]); });
+	runner.Run("Vector3 dot", [&] (size_t i) { DoNotOptimize(Vector3::Dot(in.vectors[i], in.vectors[next(i)])); });
+	runner.Run("Vector3 cross", [&] (size_t i) { DoNotOptimize(Vector3::Cross(in.vectors[i], in.vectors[next(i)])); });
+	runner.Run("Vector3 normalize", [&] (size_t i) { DoNotOptimize(in.vectors[i].Normalized()); });
+	runner.Run("Vector3 slerp", [&] (size_t i) { DoNotOptimize(Vector3::Slerp(in.vectors[i], in.vectors[next(i)], in.factors[i])); });
+
+	//Quaternion
+	runner.Run("Quaternion multiply", [&] (size_t i) { DoNotOptimize(in.rotations[i] * in.rotations[next(i)]); });
+	runner.Run("Quaternion rotate vector", [&] (size_t i) { DoNotOptimize(in.rotations[i] * in.vectors[i]); });
+	runner.Run("Quaternion normalize", [&] (size_t i) { DoNotOptimize((in.rotations[i] * 1.5).Normalized()); });
+	runner.Run("Quaternion slerp", [&] (size_t i) { DoNotOptimize(Quaternion::Slerp(in.rotations[i], in.rotations[next(i)], in.factors[i])); });
+	runner.Run("Quaternion from angle axis", [&] (size_t i) { DoNotOptimize(Quaternion::FromAngleAxis(in.factors[i], Vector3::up)); });
+
+	//Matrix4
+	runner.Run("Matrix4 multiply", [&] (size_t i) { DoNotOptimize(in.matrices[i] * in.matrices[next(i)]); });
+	runner.Run("Matrix4 transform point", [&] (size_t i) { DoNotOptimize(in.matrices[i] * in.vectors[i]); });
+	runner.Run("Matrix4 inverse", [&] (size_t i) { DoNotOptimize(Matrix4::Inverse(in.matrices[i])); });
+	runner.Run("Matrix4 transpose", [&] (size_t i) { DoNotOptimize(Matrix4::Transpose(in.matrices[i])); });
+	runner.Run("Matrix4 from rotation", [&] (size_t i) { DoNotOptimize(Matrix4::FromRotation(in.rotations[i])); });
+	runner.Run("Matrix4 TRS", [&] (size_t i) { DoNotOptimize(Matrix4::FromTranslationRotationScale(in.vectors[i], in.rotations[i], in.vectors[next(i)])); });
+	runner.Run("Matrix4 to float", [&] (size_t i) { DoNotOptimize(in.matrices[i].ToFloat()); });
+
+	//Batches, run once every batchSize iterations
+	runner.Run("Matrix4 batch transform points", [&] (size_t i) {
+		if (i % batchSize) return;
+		Matrix4::TransformPoints(in.matrices[i], std::span(in.vectors).subspan(i, batchSize), std::span(in.outVectors).subspan(i, batchSize));
+		DoNotOptimize(in.outVectors[i]);
+	});
+	runner.Run("Matrix4 batch multiply", [&] (size_t i) {
+		if (i % batchSize) return;
+		Matrix4::Multiply(in.matrices[i], std::span(in.matrices).subspan(i, batchSize), std::span(in.outMatrices).subspan(i, batchSize));
+		DoNotOptimize(in.outMatrices[i]);
+	});
+	runner.Run("Matrix4 batch TRS", [&] (size_t i) {
+		if (i % batchSize) return;
+		auto vectors = std::span(in.vectors).subspan(i, batchSize);
+		Matrix4::FromTranslationRotationScale(vectors, std::span(in.rotations).subspan(i, batchSize), vectors, std::span(in.outMatrices).subspan(i, batchSize));
+		DoNotOptimize(in.outMatrices[i]);
+	});
+	runner.Run("Matrix4 batch to float", [&] (size_t i) {
+		if (i % batchSize) return;
+		Matrix4::ToFloat(std::span(in.matrices).subspan(i, batchSize), std::span(in.outFloats).subspan(i, batchSize));
+		DoNotOptimize(in.outFloats[i]);
+	});
+
+	//Jolt conversions
+	#ifdef StevEngine_PHYSICS
+	runner.Run("Vector3 to JPH::Vec3", [&] (size_t i) { DoNotOptimize((JPH::Vec3)in.vectors[i]); });
+	runner.Run("Vector3 to JPH::DVec3", [&] (size_t i) { DoNotOptimize((JPH::DVec3)in.vectors[i]); });
+	runner.Run("Vector3 from JPH::DVec3", [&] (size_t i) { DoNotOptimize(Vector3(JPH::DVec3(in.factors[i], 1, 2))); });
+	runner.Run("Quaternion to JPH::Quat", [&] (size_t i) { DoNotOptimize((JPH::Quat)in.rotations[i]); });
+	#endif
+
+	//Write results
+	if (!output.empty()) {
+		FILE* file = std::fopen(output.c_str(), "w");
+		if (!file) {
+			std::fprintf(stderr, "Failed to write results to %s\n", output.c_str());
+			return 2;
+		}
+		std::fprintf(file, "benchmark,ns_per_op,mops_per_s\n");
+		for (const Result& result : runner.GetResults()) std::fprintf(file, "%s,%.4f,%.4f\n", result.name.c_str(), result.nsPerOp, 1e3 / result.nsPerOp);
+		std::fclose(file);
+	}
+	return 0;
+}
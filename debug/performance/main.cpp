@@ -1,6 +1,7 @@
 #include "main/Engine.hpp"
 #include "main/EngineEvents.hpp"
 #include "main/Log.hpp"
+#include "main/Profiler.hpp"
 #include "physics/Colliders.hpp"
 #include "physics/RigidBody.hpp"
 #include "main/Scene.hpp"
@@ -54,7 +55,27 @@ int main(int argc, char** argv) {
 		#endif
 		.targetFPS = -1
 	});
-	engine->GetEvents().Subscribe<UpdateEvent>([](UpdateEvent) { Log::Debug("FPS: " + std::to_string(engine->getFPS())); });
+	//Log frame time percentiles once per second
+	engine->GetEvents().Subscribe<UpdateEvent>([](UpdateEvent e) {
+		static double sinceLog = 0;
+		sinceLog += e.deltaTime;
+		if (sinceLog < 1) return;
+		sinceLog = 0;
+		FrameTimeSummary frames = engine->GetFrameStats().GetSummary();
+		Log::Debug(std::format("FPS: {:.1f}; frame ms: avg {:.2f}, p50 {:.2f}, p95 {:.2f}, p99 {:.2f}, max {:.2f}", engine->getFPS(), frames.average, frames.p50, frames.p95, frames.p99, frames.max));
+	});
+	#ifdef StevEngine_PROFILER
+	//Capture a few seconds after loading, and save them as a Chrome trace
+	engine->GetEvents().Subscribe<UpdateEvent>([](UpdateEvent) {
+		static uint32_t frame = 0;
+		frame++;
+		if (frame == 60) profiler.BeginCapture();
+		if (frame == 360) {
+			profiler.EndCapture();
+			if (profiler.SaveTrace("performance.trace.json")) Log::Normal("Saved profiler trace to performance.trace.json");
+		}
+	});
+	#endif
 
 	Scene& scene = sceneManager.CreateScene("Physics test");
 	SpawnPhysicsObjects(scene);
@@ -5,32 +5,91 @@
 #include "main/Log.hpp"
 #include "utilities/Stream.hpp"
 
+#include <cstddef>
+#include <mutex>
+
 using namespace StevEngine::Utilities;
 
 namespace StevEngine {
+	//Component pools
+	namespace {
+		const size_t poolGranularity = alignof(std::max_align_t);	///< Difference in block size between pools
+		const size_t maxPooledSize = 2048;							///< Largest component size that is pooled
+		const size_t blocksPerPage = 64;							///< Number of blocks allocated at once
+
+		/** @brief Pool of equally sized memory blocks */
+		struct ComponentPool {
+			/** @brief Unused block, linked to the next unused block */
+			struct FreeBlock { FreeBlock* next; };
+			FreeBlock* free = nullptr;	///< First unused block
+			std::mutex mutex;			///< Protects the free list, as objects updated in parallel can add and remove components
+		};
+
+		/**
+		 * @brief Get pool for a block size
+		 *
+		 * Pools are never freed, as components can be destroyed during static destruction.
+		 * @param index Pool index
+		 * @return Reference to pool
+		 */
+		ComponentPool& GetPool(size_t index) {
+			static ComponentPool* pools = new ComponentPool[maxPooledSize / poolGranularity];
+			return pools[index];
+		}
+	}
+	void* Component::operator new(size_t size) {
+		if (size > maxPooledSize) return ::operator new(size);
+		size_t index = (size - 1) / poolGranularity;
+		ComponentPool& pool = GetPool(index);
+		std::lock_guard lock(pool.mutex);
+		//Allocate new page when the pool is empty
+		if (!pool.free) {
+			size_t blockSize = (index + 1) * poolGranularity;
+			std::byte* page = (std::byte*)::operator new(blockSize * blocksPerPage);
+			for (size_t i = blocksPerPage; i > 0; i--) {
+				auto block = (ComponentPool::FreeBlock*)(page + (i - 1) * blockSize);
+				block->next = pool.free;
+				pool.free = block;
+			}
+		}
+		ComponentPool::FreeBlock* block = pool.free;
+		pool.free = block->next;
+		return block;
+	}
+	void Component::operator delete(void* pointer, size_t size) {
+		if (!pointer) return;
+		if (size > maxPooledSize) return ::operator delete(pointer);
+		ComponentPool& pool = GetPool((size - 1) / poolGranularity);
+		std::lock_guard lock(pool.mutex);
+		auto block = (ComponentPool::FreeBlock*)pointer;
+		block->next = pool.free;
+		pool.free = block;
+	}
+
 	Component::Component() {}
 
-	void Component::SetObject(GameObject& object, std::string scene) {
-		gameObject = object.Id();
-		this->scene = scene;
-		//Event listeners
-		handlers.emplace_back(object.Subscribe<UpdateEvent>([this] (UpdateEvent e) { this->Update(e.deltaTime); }, false), UpdateEvent::GetStaticEventType());
+	void Component::SetObject(GameObject& object) {
+		gameObject = &object;
+		//Event listeners, classes with batch functions are updated and drawn by the SceneManager instead
+		if(!ComponentRegistry::HasUpdateSystem(typeID))
+			handlers.emplace_back(object.Subscribe<UpdateEvent>([this] (UpdateEvent e) { this->Update(e.deltaTime); }, false));
 		#ifdef StevEngine_SHOW_WINDOW
-		handlers.emplace_back(object.Subscribe<DrawEvent>([this] (DrawEvent e) { this->Draw(e.transform); }, false), DrawEvent::GetStaticEventType());
+		if(!ComponentRegistry::HasDrawSystem(typeID))
+			handlers.emplace_back(object.Subscribe<DrawEvent>([this] (const DrawEvent& e) { this->Draw(e.transform); }, false));
 		#endif
-		handlers.emplace_back(object.Subscribe<DeactivateEvent>([this] (DeactivateEvent) { this->Deactivate(); }, false), DeactivateEvent::GetStaticEventType());
+		handlers.emplace_back(object.Subscribe<DeactivateEvent>([this] (DeactivateEvent) { this->Deactivate(); }, false));
 	}
 	GameObject& Component::GetParent() const {
-		return GetScene().GetObject(gameObject);
+		return *gameObject;
 	}
 	Scene& Component::GetScene() const {
-		return sceneManager.GetScene(scene);
+		return gameObject->GetScene();
 	}
 	Component::~Component() {
 		//Unsubscribe from events
 		if(handlers.empty()) return;
 		GameObject& object = GetParent();
-		for(auto[id, event] : handlers) object.Unsubscribe(event, id);
+		for(auto& handle : handlers) object.Unsubscribe(handle);
 	}
 	//Export/Import component
 	Component* CreateComponents::Create(const std::string& type, Stream& stream) {
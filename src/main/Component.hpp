@@ -1,4 +1,6 @@
 #pragma once
+#include "main/EventSystem.hpp"
+#include "main/ComponentRegistry.hpp"
 #include "utilities/ID.hpp"
 #include "utilities/Matrix4.hpp"
 #include "utilities/Stream.hpp"
@@ -16,16 +18,23 @@ namespace StevEngine {
 	 *
 	 * Components provide behavior and functionality to GameObjects.
 	 * They can respond to events, be serialized, and manage resources.
+	 *
+	 * Components are allocated from pools shared by all components of the same size,
+	 * which keeps components of the same class close together in memory.
+	 *
+	 * Looking up components only checks a type mask for the first 63 component classes.
+	 * Later classes are also found, but by testing each of their attached components.
 	 */
 	class Component {
 		friend class StevEngine::GameObject;
+		friend class StevEngine::ComponentRegistry;
 		//Properties
 		private:
-			/** @brief ID of parent GameObject */
-			Utilities::ID gameObject = Utilities::ID::empty;
+			/** @brief Parent GameObject, which owns the component */
+			GameObject* gameObject = nullptr;
 
-			/** @brief Name of containing scene */
-			std::string scene;
+			ComponentTypeID typeID = 0;				///< Type index of the component's class
+			uint32_t instanceIndex = UINT32_MAX;	///< Index in the instance list of its class
 
 			/** @brief Whether only one instance can exist per GameObject */
 			static const bool unique = false;
@@ -42,6 +51,26 @@ namespace StevEngine {
 			 */
 			virtual ~Component();
 
+			/**
+			 * @brief Allocate component from the pool for its size
+			 * @param size Size of component class
+			 * @return Allocated memory
+			 */
+			static void* operator new(size_t size);
+
+			/**
+			 * @brief Return component memory to the pool for its size
+			 * @param pointer Memory to free
+			 * @param size Size of component class
+			 */
+			static void operator delete(void* pointer, size_t size);
+
+			/**
+			 * @brief Get type index of the component's class
+			 * @return Type index, only valid once added to an object
+			 */
+			ComponentTypeID GetTypeID() const { return typeID; }
+
 			/**
 			 * @brief Get parent GameObject
 			 * @return Reference to parent GameObject
@@ -93,16 +122,15 @@ namespace StevEngine {
 
 		private:
 			/**
-			 * @brief Set parent GameObject and scene
+			 * @brief Set parent GameObject
 			 * @param object Parent GameObject
-			 * @param scene Containing scene name
 			 */
-			void SetObject(GameObject& object, std::string scene);
+			void SetObject(GameObject& object);
 
 		//Events
 		protected:
 			/** @brief Event handler registrations */
-			std::vector<std::pair<Utilities::ID, std::string>> handlers;
+			std::vector<EventHandle> handlers;
 	};
 
 	/**
@@ -126,6 +154,9 @@ namespace StevEngine {
 
 			/**
 			 * @brief Register a component type for creation
+			 *
+			 * Also registers the batch update and draw functions of the class,
+			 * so components created from data, which are added as Component, use them too.
 			 * @tparam T Component class type
 			 * @param type String identifier for component type
 			 * @return true if registration succeeded, false if type already registered
@@ -138,6 +169,7 @@ namespace StevEngine {
 				factories.emplace(type, [](Utilities::Stream& stream) {
 					return (Component*) new T(stream);
 				});
+				if constexpr (UpdateSystem<T> || DrawSystem<T>) ComponentRegistry::RegisterSystems<T>(ComponentRegistry::GetTypeID<T>());
 				return true;
 			}
 	};
@@ -0,0 +1,74 @@
+#include "ComponentRegistry.hpp"
+#include "main/Component.hpp"
+#include "main/GameObject.hpp"
+
+namespace StevEngine {
+	ComponentTypeID ComponentRegistry::GetTypeID(const Component& component) {
+		return GetTypeID(std::type_index(typeid(component)));
+	}
+
+	ComponentTypeID ComponentRegistry::GetTypeID(std::type_index type) {
+		std::lock_guard lock(mutex);
+		auto found = typeIDs.find(type);
+		if (found != typeIDs.end()) return found->second;
+		//Register new class
+		ComponentTypeID id = instances.size();
+		typeIDs.emplace(type, id);
+		instances.emplace_back();
+		testedQueries.push_back(0);
+		systems.emplace_back();
+		return id;
+	}
+
+	bool ComponentRegistry::IsActive(const Component* component) {
+		return component->GetParent().IsActive();
+	}
+
+	void ComponentRegistry::UpdateSystems(double deltaTime) {
+		for (ComponentTypeID type = 0; type < systems.size(); type++) {
+			if (systems[type].update) systems[type].update(type, deltaTime);
+		}
+	}
+
+	void ComponentRegistry::DrawSystems() {
+		for (ComponentTypeID type = 0; type < systems.size(); type++) {
+			if (systems[type].draw) systems[type].draw(type);
+		}
+	}
+
+	void ComponentRegistry::Add(Component* component) {
+		ComponentTypeID type = GetTypeID(*component);
+		std::lock_guard lock(mutex);
+		//Test queries added since the last instance of this class
+		for (uint32_t query = testedQueries[type]; query < queries.size(); query++) {
+			if (queries[query].test(component)) queries[query].mask |= GetBit(type);
+		}
+		testedQueries[type] = queries.size();
+		//Add to instance list
+		component->typeID = type;
+		component->instanceIndex = instances[type].size();
+		instances[type].push_back(component);
+	}
+
+	void ComponentRegistry::Remove(Component* component) {
+		std::lock_guard lock(mutex);
+		std::vector<Component*>& list = instances[component->typeID];
+		//Move last instance into the free spot
+		Component* last = list.back();
+		list[component->instanceIndex] = last;
+		last->instanceIndex = component->instanceIndex;
+		list.pop_back();
+	}
+
+	const ComponentRegistry::Query& ComponentRegistry::AddQuery(bool (*test)(const Component*)) {
+		std::lock_guard lock(mutex);
+		Query& query = queries.emplace_back(test);
+		//Classes with live instances have been tested against every earlier query, the rest are tested when next added
+		for (ComponentTypeID type = 0; type < instances.size(); type++) {
+			if (instances[type].empty()) continue;
+			if (test(instances[type][0])) query.mask |= GetBit(type);
+			testedQueries[type] = queries.size();
+		}
+		return query;
+	}
+}
@@ -0,0 +1,264 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace StevEngine {
+	class Component;
+
+	/** @brief Compact index of a component class */
+	using ComponentTypeID = uint32_t;
+
+	/**
+	 * @brief Set of component classes, one bit per type index
+	 *
+	 * Type indices from ComponentRegistry::sharedType on all share the last bit.
+	 */
+	using ComponentMask = uint64_t;
+
+	/**
+	 * @brief Component class updated in batches
+	 *
+	 * The class defines a static UpdateAll function, which is called once per frame with all active
+	 * components of the class, instead of calling Update on every component through object events.
+	 */
+	template<typename T> concept UpdateSystem = requires(std::span<T*> components, double deltaTime) { T::UpdateAll(components, deltaTime); };
+
+	/**
+	 * @brief Component class drawn in batches
+	 *
+	 * The class defines a static DrawAll function, which is called once per frame with all active
+	 * components of the class, instead of calling Draw on every component through object events.
+	 */
+	template<typename T> concept DrawSystem = requires(std::span<T*> components) { T::DrawAll(components); };
+
+	/**
+	 * @brief Registry of component classes and their instances
+	 *
+	 * Every component class gets a type index when registered for creation, or the first time an instance of it is added to an object.
+	 * Any class can be used to query components, and gets a mask of every registered class deriving from it.
+	 * There is no limit on the number of classes, but the classes past the first 63 share one mask bit,
+	 * so finding their components checks each component of those classes instead of only the mask.
+	 * All instances of a class are kept in a dense list, so they can be iterated without going through objects.
+	 * Components can be added and removed from objects updated in parallel, but the instance lists must not be read while they are.
+	 */
+	class ComponentRegistry {
+		friend class GameObject;
+		public:
+			/** @brief First type index that shares the last mask bit with all later type indices */
+			static constexpr ComponentTypeID sharedType = 63;
+
+			/**
+			 * @brief Get mask bit of a type index
+			 * @param type Type index of class
+			 * @return Mask with the bit of the type set
+			 */
+			static ComponentMask GetBit(ComponentTypeID type) { return ComponentMask(1) << std::min(type, sharedType); }
+
+			/**
+			 * @brief Get mask of every component class that is or derives from T
+			 *
+			 * If the shared bit is set, it is only known that one of the classes sharing it matches.
+			 * @tparam T Component class to query
+			 * @return Mask of matching type indices
+			 */
+			template<typename T> static ComponentMask GetMask() {
+				return GetQuery<T>().mask.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Get type index of a component, registering its class if needed
+			 * @param component Component to get type of
+			 * @return Type index of the component's class
+			 */
+			static ComponentTypeID GetTypeID(const Component& component);
+
+			/**
+			 * @brief Get type index of a component class, registering it if needed
+			 * @tparam T Component class
+			 * @return Type index of the class
+			 */
+			template<typename T> static ComponentTypeID GetTypeID() { return GetTypeID(std::type_index(typeid(T))); }
+
+			/**
+			 * @brief Get number of registered component classes
+			 * @return Type count
+			 */
+			static uint32_t GetTypeCount() { return instances.size(); }
+
+			/**
+			 * @brief Get all components of one class, in all scenes
+			 * @param type Type index of class
+			 * @return List of components
+			 */
+			static const std::vector<Component*>& GetInstances(ComponentTypeID type) { return instances[type]; }
+
+			/**
+			 * @brief Call function for every component that is or derives from T, in all scenes
+			 * @tparam T Component class to query
+			 * @param function Function taking a T reference
+			 */
+			template<typename T, typename Function> static void ForEach(Function&& function) {
+				const Query& query = GetQuery<T>();
+				ComponentMask mask = query.mask.load(std::memory_order_relaxed);
+				while (mask != 0) {
+					ComponentTypeID type = std::countr_zero(mask);
+					mask &= mask - 1;
+					//Shared bit, so test each class that shares it
+					ComponentTypeID last = type < sharedType ? type : instances.size() - 1;
+					for (; type <= last; type++) {
+						if (instances[type].empty() || (type >= sharedType && !query.test(instances[type][0]))) continue;
+						for (size_t i = 0; i < instances[type].size(); i++) function(*static_cast<T*>(instances[type][i]));
+					}
+				}
+			}
+
+			/**
+			 * @brief Register batch update and draw functions of a component class
+			 * @tparam T Component class, with UpdateAll and/or DrawAll
+			 * @param type Type index of the class
+			 */
+			template<typename T> static void RegisterSystems(ComponentTypeID type) {
+				std::lock_guard lock(mutex);
+				if constexpr (UpdateSystem<T>) systems[type].update = &RunUpdate<T>;
+				if constexpr (DrawSystem<T>) systems[type].draw = &RunDraw<T>;
+			}
+
+			/**
+			 * @brief Check if a component class is updated in batches
+			 * @param type Type index of class
+			 * @return true if the class has a batch update function
+			 */
+			static bool HasUpdateSystem(ComponentTypeID type) {
+				std::lock_guard lock(mutex);
+				return systems[type].update != nullptr;
+			}
+
+			/**
+			 * @brief Check if a component class is drawn in batches
+			 * @param type Type index of class
+			 * @return true if the class has a batch draw function
+			 */
+			static bool HasDrawSystem(ComponentTypeID type) {
+				std::lock_guard lock(mutex);
+				return systems[type].draw != nullptr;
+			}
+
+			/**
+			 * @brief Run batch update of every component class that has one
+			 * @param deltaTime Time since last update
+			 */
+			static void UpdateSystems(double deltaTime);
+
+			/**
+			 * @brief Run batch draw of every component class that has one
+			 */
+			static void DrawSystems();
+
+		private:
+			/** @brief Query class and its matching types */
+			struct Query {
+				Query(bool (*test)(const Component*)) : test(test) {}
+				bool (*test)(const Component*);		///< Whether a component is of the query class
+				std::atomic<ComponentMask> mask = 0;	///< Matching type indices, read without locking
+			};
+
+			/**
+			 * @brief Get query of a component class, adding it on first use
+			 * @tparam T Component class to query
+			 * @return Query, which stays at the same address
+			 */
+			template<typename T> static const Query& GetQuery() {
+				static const Query& query = AddQuery([] (const Component* component) { return dynamic_cast<const T*>(component) != nullptr; });
+				return query;
+			}
+
+			/**
+			 * @brief Get type index of a class, registering it if needed
+			 * @param type Class to get type index of
+			 * @return Type index of the class
+			 */
+			static ComponentTypeID GetTypeID(std::type_index type);
+
+			/**
+			 * @brief Add component to the instance list of its class
+			 * @param component Component to add
+			 */
+			static void Add(Component* component);
+
+			/**
+			 * @brief Remove component from the instance list of its class
+			 * @param component Component to remove
+			 */
+			static void Remove(Component* component);
+
+			/**
+			 * @brief Register new query class
+			 * @param test Function checking if a component is of the query class
+			 * @return Query, which stays at the same address
+			 */
+			static const Query& AddQuery(bool (*test)(const Component*));
+
+			/**
+			 * @brief Check if a component's object is active
+			 * @param component Component to check
+			 * @return true if the object is active
+			 */
+			static bool IsActive(const Component* component);
+
+			/**
+			 * @brief Collect active components of a class into a reused batch
+			 * @tparam T Component class
+			 * @param type Type index of the class
+			 * @return Batch of active components
+			 */
+			template<typename T> static std::span<T*> GetBatch(ComponentTypeID type) {
+				static std::vector<T*> batch;
+				batch.clear();
+				for (Component* component : instances[type]) {
+					if (IsActive(component)) batch.push_back(static_cast<T*>(component));
+				}
+				return batch;
+			}
+			/**
+			 * @brief Run batch update of a component class
+			 * @tparam T Component class
+			 * @param type Type index of the class
+			 * @param deltaTime Time since last update
+			 */
+			template<typename T> static void RunUpdate(ComponentTypeID type, double deltaTime) {
+				std::span<T*> batch = GetBatch<T>(type);
+				if (!batch.empty()) T::UpdateAll(batch, deltaTime);
+			}
+			/**
+			 * @brief Run batch draw of a component class
+			 * @tparam T Component class
+			 * @param type Type index of the class
+			 */
+			template<typename T> static void RunDraw(ComponentTypeID type) {
+				std::span<T*> batch = GetBatch<T>(type);
+				if (!batch.empty()) T::DrawAll(batch);
+			}
+
+			/** @brief Batch functions of a component class */
+			struct System {
+				void (*update)(ComponentTypeID type, double deltaTime) = nullptr;	///< Batch update, if any
+				void (*draw)(ComponentTypeID type) = nullptr;						///< Batch draw, if any
+			};
+
+			static inline std::mutex mutex;												///< Protects registration, as objects updated in parallel can add and remove components
+			static inline std::deque<Query> queries;									///< All query classes
+			static inline std::unordered_map<std::type_index, ComponentTypeID> typeIDs;	///< Type index of each class
+			static inline std::deque<std::vector<Component*>> instances;				///< Components of each class, which never move as classes are registered
+			static inline std::deque<uint32_t> testedQueries;							///< Number of queries each class has been tested against
+			static inline std::deque<System> systems;									///< Batch functions of each class
+	};
+}
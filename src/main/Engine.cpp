@@ -4,7 +4,9 @@
 #include <SDL_stdinc.h>
 #include <SDL_timer.h>
 #include <SDL_video.h>
+#include <algorithm>
 #include <cstdint>
+#include <cmath>
 
 //Engine
 #include "audio/AudioSystem.hpp"
@@ -15,7 +17,9 @@
 #include "data/Settings.hpp"
 #include "physics/PhysicsSystem.hpp"
 #include "main/GameObject.hpp"
+#include "main/JobSystem.hpp"
 #include "main/Log.hpp"
+#include "main/Profiler.hpp"
 #include "main/Scene.hpp"
 #include "main/SceneManager.hpp"
 #include "visuals/renderer/RenderSystem.hpp"
@@ -38,6 +42,7 @@ namespace StevEngine {
 		#ifdef StevEngine_PLAYER_DATA
 		SetGameSettingsFromFile();
 		#endif
+		SetTickRate(this->gameSettings.tickRate, this->gameSettings.maxSubsteps);
 		//Initialize SDL
 		if (SDL_Init(
 			SDL_INIT_EVENTS | SDL_INIT_TIMER
@@ -71,56 +76,65 @@ namespace StevEngine {
 		events.Publish(EngineStartEvent());
 		//Main loop
 		uint64_t lastUpdateTime = GetTime();
+		pacer.SetTarget(gameSettings.targetFPS);
 		running = true;
 		while (running) {
-			events.Publish(PreUpdateEvent());
+			StevEngine_PROFILE_ZONE("Frame");
+			{
+				StevEngine_PROFILE_ZONE("PreUpdate");
+				events.Publish(PreUpdateEvent());
+			}
 			//Event loop
-			while (SDL_PollEvent(&ev) != 0) {
-				events.Publish(SDLEvent(ev));
-				// check event type
-				switch (ev.type) {
-					case SDL_QUIT:
-						// shut down
-						running = false;
-						break;
-					#ifdef StevEngine_SHOW_WINDOW
-					case SDL_WINDOWEVENT:
-						switch (ev.window.event) {
-							case SDL_WINDOWEVENT_RESIZED:
-								if(gameSettings.fullscreen) break;
-								//Log::Debug(std::format("Resizing window to {},{}", ev.window.data1, ev.window.data2), true);
-								events.Publish(WindowResizeEvent(ev.window.data1, ev.window.data2));
-								gameSettings.WIDTH  = ev.window.data1;
-								gameSettings.HEIGHT = ev.window.data2;
-								#ifdef StevEngine_PLAYER_DATA
-								Data::settings.Save("WindowWidth",  gameSettings.WIDTH);
-								Data::settings.Save("WindowHeight", gameSettings.HEIGHT);
+			{
+				StevEngine_PROFILE_ZONE("PollEvents");
+				while (SDL_PollEvent(&ev) != 0) {
+					events.Publish(SDLEvent(ev));
+					// check event type
+					switch (ev.type) {
+						case SDL_QUIT:
+							// shut down
+							running = false;
+							break;
+						#ifdef StevEngine_SHOW_WINDOW
+						case SDL_WINDOWEVENT:
+							switch (ev.window.event) {
+								case SDL_WINDOWEVENT_RESIZED:
+									if(gameSettings.fullscreen) break;
+									//Log::Debug(std::format("Resizing window to {},{}", ev.window.data1, ev.window.data2), true);
+									events.Publish(WindowResizeEvent(ev.window.data1, ev.window.data2));
+									gameSettings.WIDTH  = ev.window.data1;
+									gameSettings.HEIGHT = ev.window.data2;
+									#ifdef StevEngine_PLAYER_DATA
+									Data::settings.Save("WindowWidth",  gameSettings.WIDTH);
+									Data::settings.Save("WindowHeight", gameSettings.HEIGHT);
+									#endif
+									break;
+								case SDL_WINDOWEVENT_MOVED:
+									//Log::Debug(std::format("Moving window to {},{}", ev.window.data1, ev.window.data2), true);
+									events.Publish(WindowMoveEvent(ev.window.data1, ev.window.data2));
+									break;
+								case SDL_WINDOWEVENT_DISPLAY_CHANGED:
+									if(!gameSettings.fullscreen) break;
+									//Log::Debug("Moving window to display " + std::to_string(ev.window.data1), true);
+									SDL_Rect bounds;
+									SDL_GetDisplayBounds(ev.window.data1, &bounds);
+									SDL_SetWindowPosition(window, bounds.x, bounds.y);
+									SetWindowSize(bounds.w, bounds.h);
+									break;
+								#ifdef StevEngine_INPUTS
+								case SDL_WINDOWEVENT_ENTER:
+									//Log::Debug(std::format("Mouse entered the window! Motion: {},{}", ev.motion.x, ev.motion.y), true);
+									break;
+								case SDL_WINDOWEVENT_LEAVE:
+									//Log::Debug(std::format("Mouse left the window! Motion: {},{}", ev.motion.x, ev.motion.y), true);
+									break;
 								#endif
-								break;
-							case SDL_WINDOWEVENT_MOVED:
-								//Log::Debug(std::format("Moving window to {},{}", ev.window.data1, ev.window.data2), true);
-								events.Publish(WindowMoveEvent(ev.window.data1, ev.window.data2));
-								break;
-							case SDL_WINDOWEVENT_DISPLAY_CHANGED:
-								if(!gameSettings.fullscreen) break;
-								//Log::Debug("Moving window to display " + std::to_string(ev.window.data1), true);
-								SDL_Rect bounds;
-								SDL_GetDisplayBounds(ev.window.data1, &bounds);
-								SDL_SetWindowPosition(window, bounds.x, bounds.y);
-								SetWindowSize(bounds.w, bounds.h);
-								break;
-							#ifdef StevEngine_INPUTS
-							case SDL_WINDOWEVENT_ENTER:
-								//Log::Debug(std::format("Mouse entered the window! Motion: {},{}", ev.motion.x, ev.motion.y), true);
-								break;
-							case SDL_WINDOWEVENT_LEAVE:
-								//Log::Debug(std::format("Mouse left the window! Motion: {},{}", ev.motion.x, ev.motion.y), true);
-								break;
-							#endif
-						}
-						break;
-					#endif
+							}
+							break;
+						#endif
+					}
 				}
+				EventManager::FlushQueues();
 			}
 
 			//Calculate delta time
@@ -129,18 +143,50 @@ namespace StevEngine {
 			lastUpdateTime = newTime;
 			double frameMs = frameTime / (SDL_GetPerformanceFrequency() / 1000.0);
 
+			//Run fixed updates
+			double frameSeconds = fixedFrameTime > 0 ? fixedFrameTime : frameMs / 1000.0;
+			{
+				StevEngine_PROFILE_ZONE("FixedUpdate");
+				if (gameSettings.tickRate > 0) {
+					double fixedDeltaTime = 1.0 / gameSettings.tickRate;
+					fixedAccumulator += frameSeconds;
+					for (int step = 0; fixedAccumulator >= fixedDeltaTime; step++) {
+						//Drop time that can not be caught up on, instead of falling further behind
+						if (step == gameSettings.maxSubsteps) {
+							fixedAccumulator = std::fmod(fixedAccumulator, fixedDeltaTime);
+							break;
+						}
+						events.Publish(FixedUpdateEvent(fixedDeltaTime));
+						EventManager::FlushQueues();
+						fixedAccumulator -= fixedDeltaTime;
+					}
+					interpolation = fixedAccumulator / fixedDeltaTime;
+				} else {
+					events.Publish(FixedUpdateEvent(frameSeconds));
+					EventManager::FlushQueues();
+					interpolation = 1;
+				}
+			}
+
 			//Run update
-			double frameSeconds = frameMs / 1000.0;
-			events.Publish(UpdateEvent(frameSeconds));
+			{
+				StevEngine_PROFILE_ZONE("Update");
+				events.Publish(UpdateEvent(frameSeconds));
+				EventManager::FlushQueues();
+			}
 
 			//Draw the frame
 			#ifdef StevEngine_SHOW_WINDOW
-			events.Publish(EngineDrawEvent());
+			{
+				StevEngine_PROFILE_ZONE("Draw");
+				events.Publish(EngineDrawEvent());
+			}
 			#endif
 
 			//Calculate FPS:
 			if (frameTime != 0) currentFPS = 1000.0 / frameMs;
 			else currentFPS = INFINITY;
+			frameStats.Add(frameMs);
 			//Log::Debug(std::format("Current FPS: {}; frameTime: {}; Clock: {}", std::round(currentFPS), frameTime, newTime), true);
 
 			//Wait for next frame
@@ -149,9 +195,9 @@ namespace StevEngine {
 			#else
 				bool vsync = false;
 			#endif
-			if (gameSettings.targetFPS != -1 && !vsync) {
-				double target = (1000.0 / gameSettings.targetFPS);
-				if(frameMs < target) SDL_Delay(target - frameMs);
+			if (!vsync) {
+				StevEngine_PROFILE_ZONE("Wait");
+				pacer.Wait();
 			}
 		}
 
@@ -197,17 +243,25 @@ namespace StevEngine {
 		else Renderer::render.SetMSAA(true, newSettings.MSAA);
 		#endif
 		SetTargetFPS(newSettings.targetFPS);
+		SetTickRate(newSettings.tickRate, newSettings.maxSubsteps);
 		#ifdef StevEngine_PLAYER_DATA
 		Data::settings.SaveToFile();
 		#endif
 	}
 	void Engine::SetTargetFPS(int targetFPS) {
 		gameSettings.targetFPS = targetFPS;
+		pacer.SetTarget(targetFPS);
 		#ifdef StevEngine_PLAYER_DATA
 		Data::settings.Save("TargetFPS", targetFPS);
 		Data::settings.SaveToFile();
 		#endif
 	}
+	void Engine::SetTickRate(int tickRate, int maxSubsteps) {
+		gameSettings.tickRate = tickRate;
+		//At least one fixed update has to run, or the accumulated time would always be dropped
+		gameSettings.maxSubsteps = std::max(maxSubsteps, 1);
+		fixedAccumulator = 0;
+	}
 	#ifdef StevEngine_SHOW_WINDOW
 	void Engine::SetVSync(bool vsync) {
 		gameSettings.vsync = vsync;
@@ -265,6 +319,7 @@ namespace StevEngine {
 			Data::settings.Init(title);
 		#endif
 		engine = new Engine(title, gameSettings);
+		jobs.Init();
 		#ifdef StevEngine_PHYSICS
 			Physics::physics.Init(JPH::PhysicsSettings());
 		#endif
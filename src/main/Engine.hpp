@@ -1,5 +1,6 @@
 #pragma once
 #include "EventSystem.hpp"
+#include "FramePacer.hpp"
 #include <SDL.h>
 
 namespace StevEngine {
@@ -15,6 +16,8 @@ namespace StevEngine {
 		int HEIGHT = 600;	   ///< Window height
 		#endif
 		int targetFPS = 60;	 ///< Target frames per second (-1 for unlimited)
+		int tickRate = 60;	 ///< Fixed updates per second (-1 for one fixed update per frame)
+		int maxSubsteps = 5;	 ///< Maximum fixed updates per frame, remaining time is dropped, at least 1
 	};
 
 	/**
@@ -54,6 +57,14 @@ namespace StevEngine {
 			 */
 			double getFPS() const;
 
+			/**
+			 * @brief Get times of recent frames
+			 *
+			 * Frame times are measured from the start of one frame to the next, including drawing and waiting.
+			 * @return Rolling frame time stats
+			 */
+			const FrameStats& GetFrameStats() const { return frameStats; }
+
 			bool running;  ///< Whether engine is running
 
 			/** @brief Game window title */
@@ -77,6 +88,35 @@ namespace StevEngine {
 			 */
 			void SetTargetFPS(int targetFPS);
 
+			/**
+			 * @brief Set fixed update rate
+			 * @param tickRate New fixed updates per second (-1 for one fixed update per frame)
+			 * @param maxSubsteps Maximum fixed updates per frame, values below 1 are raised to 1
+			 */
+			void SetTickRate(int tickRate, int maxSubsteps);
+
+			/**
+			 * @brief Get time step of fixed updates
+			 * @return Fixed time step in seconds, or 0 if fixed updates follow the frame rate
+			 */
+			double GetFixedDeltaTime() const { return gameSettings.tickRate > 0 ? 1.0 / gameSettings.tickRate : 0; }
+
+			/**
+			 * @brief Get how far the frame is between the last two fixed updates
+			 *
+			 * Used to interpolate simulated transforms when rendering.
+			 * @return Value from 0 (last fixed update) to 1 (next fixed update)
+			 */
+			double GetInterpolation() const { return interpolation; }
+
+			/**
+			 * @brief Use the same delta time for every frame, instead of the measured frame time
+			 *
+			 * Makes updates reproducible, for benchmarks and replays. Frame stats still use measured times.
+			 * @param deltaTime Delta time in seconds, 0 to use measured frame times
+			 */
+			void SetFixedFrameTime(double deltaTime) { fixedFrameTime = deltaTime; }
+
 			#ifdef StevEngine_SHOW_WINDOW
 			/**
 			 * @brief Set vertical sync
@@ -106,6 +146,11 @@ namespace StevEngine {
 		private:
 			EventManager events;	 ///< Engine event manager
 			double currentFPS;	   ///< Current frames per second
+			FrameStats frameStats;   ///< Recent frame times
+			FramePacer pacer;		///< Waits for the next frame at the target FPS
+			double fixedAccumulator = 0; ///< Time not yet simulated by fixed updates
+			double interpolation = 1;	///< Fraction of a fixed time step since the last fixed update
+			double fixedFrameTime = 0;   ///< Delta time used for every frame, 0 to use measured frame time
 			SDL_Event ev;			///< SDL event handler
 			GameSettings gameSettings; ///< Current engine settings
 
@@ -49,6 +49,23 @@ namespace StevEngine {
 			double deltaTime;  ///< Time since last update in seconds
 	};
 
+	/**
+	 * @brief Event triggered on fixed rate simulation update
+	 *
+	 * Published at the tick rate, before the frame update, zero or more times per frame.
+	 */
+	class FixedUpdateEvent : public Event {
+		public:
+			/**
+			 * @brief Create fixed update event
+			 * @param deltaTime Fixed time step
+			 */
+			FixedUpdateEvent(double deltaTime) : deltaTime(deltaTime) {}
+			const std::string GetEventType() const override { return GetStaticEventType(); };
+			static const std::string GetStaticEventType() {  return "FixedUpdateEvent"; }
+			double deltaTime;  ///< Fixed time step in seconds
+	};
+
 	#ifdef StevEngine_SHOW_WINDOW
 	/**
 	 * @brief Event triggered when frame should be drawn
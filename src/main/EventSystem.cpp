@@ -1,32 +1,108 @@
 #include "EventSystem.hpp"
+#include "main/Profiler.hpp"
+
+#include <atomic>
+#include <mutex>
 
 namespace StevEngine {
-	Utilities::ID EventManager::Subscribe(const std::string eventId, EventHandlerBase* handler) {
-		auto subs = subscribers.find(eventId);
-		if (subs != subscribers.end()) {
-			auto& handlers = subscribers[eventId];
-			//Add new handler
-			handlers.push_back(std::move(handler));
-		} else {
-			//Add new event id to subscribers
-			subscribers[eventId].emplace_back(std::move(handler));
+	/** @brief Managers with queued events, destroyed managers are set to nullptr */
+	std::vector<EventManager*> queuedManagers;
+	/** @brief Protects the queued managers, as objects updated in parallel can queue events */
+	std::mutex queuedMutex;
+	/** @brief Maximum number of times queued managers are flushed in a row, when flushing creates new queued events */
+	const uint32_t maxFlushPasses = 8;
+
+	EventTypeID NextEventTypeID() {
+		static std::atomic<EventTypeID> next = 0;
+		return next++;
+	}
+
+	uint32_t EventHandlerArena::Allocate() {
+		//Reuse free slot
+		if (!freeSlots.empty()) {
+			uint32_t index = freeSlots.back();
+			freeSlots.pop_back();
+			return index;
+		}
+		//Add new page when all pages are full
+		uint32_t capacity = firstPageSize * ((1u << pages.size()) - 1);
+		if (count == capacity) pages.emplace_back(std::make_unique<Slot[]>(firstPageSize << pages.size()));
+		return count++;
+	}
+
+	bool EventHandlerArena::Remove(uint32_t index, uint32_t generation) {
+		if (index >= count) return false;
+		Slot& slot = Get(index);
+		if (!slot.active || slot.generation != generation) return false;
+		slot.active = false;
+		if (++slot.generation == 0) slot.generation = 1;
+		//Handler might be running, so destroy it once dispatching is done
+		if (dispatching > 0) removedSlots.push_back(index);
+		else {
+			slot.handler.Reset();
+			freeSlots.push_back(index);
+		}
+		return true;
+	}
+
+	void EventManager::Unsubscribe(const EventHandle& handle) {
+		if (!handle.IsValid() || handle.type >= subscribers.size()) return;
+		subscribers[handle.type].Remove(handle.index, handle.generation);
+	}
+
+	void EventManager::Publish(EventTypeID eventId, const Event& event) {
+		if (eventId >= subscribers.size()) return;
+		StevEngine_PROFILE_ZONE("EventManager::Publish");
+		subscribers[eventId].dispatching++;
+		//Arena is looked up every iteration, as handlers subscribing to new event types can move it
+		for (uint32_t i = 0; i < subscribers[eventId].Count(); i++) {
+			EventHandlerArena::Slot& slot = subscribers[eventId].Get(i);
+			if (slot.active) slot.handler.Execute(event);
+		}
+		EventHandlerArena& arena = subscribers[eventId];
+		if (--arena.dispatching == 0 && !arena.removedSlots.empty()) {
+			for (uint32_t index : arena.removedSlots) {
+				arena.Get(index).handler.Reset();
+				arena.freeSlots.push_back(index);
+			}
+			arena.removedSlots.clear();
+		}
+	}
+
+	void EventManager::MarkQueued() {
+		queued = true;
+		std::lock_guard lock(queuedMutex);
+		queuedManagers.push_back(this);
+	}
+
+	void EventManager::Flush() {
+		for (size_t i = 0; i < queues.size(); i++) {
+			if (queues[i]) queues[i]->Flush(*this);
 		}
-		return handler->GetType();
 	}
 
-	void EventManager::Unsubscribe(const std::string eventId, const Utilities::ID handler) {
-		auto& handlers = subscribers[eventId];
-		for(size_t i = 0; i < handlers.size(); i++) {
-			if (handlers[i]->GetType() == handler) {
-				delete handlers[i];
-				handlers.erase(handlers.begin() + i);
-				return;
+	void EventManager::FlushQueues() {
+		StevEngine_PROFILE_ZONE("EventManager::FlushQueues");
+		size_t start = 0;
+		for (uint32_t pass = 0; pass < maxFlushPasses && start < queuedManagers.size(); pass++) {
+			//Managers queued while flushing are handled in the next pass
+			size_t end = queuedManagers.size();
+			for (size_t i = start; i < end; i++) {
+				EventManager* manager = queuedManagers[i];
+				if (!manager) continue;
+				queuedManagers[i] = nullptr;
+				manager->queued = false;
+				manager->Flush();
 			}
+			start = end;
 		}
+		queuedManagers.erase(queuedManagers.begin(), queuedManagers.begin() + start);
 	}
 
-	void EventManager::Publish(const Event& event) {
-		auto& handlers = subscribers[event.GetEventType()];
-		for(auto handler : handlers) handler->Execute(event);
+	EventManager::~EventManager() {
+		if (!queued) return;
+		for (EventManager*& manager : queuedManagers) {
+			if (manager == this) manager = nullptr;
+		}
 	}
 }
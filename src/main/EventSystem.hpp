@@ -1,8 +1,12 @@
 #pragma once
-#include "utilities/ID.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <new>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
 #include <vector>
 
 namespace StevEngine {
@@ -12,60 +16,234 @@ namespace StevEngine {
 	class Event {
 		public:
 			/**
-			 * @brief Get type identifier for this event
+			 * @brief Get type name for this event
+			 *
+			 * Only used for serialization and debugging, dispatching uses EventTypeID.
 			 * @return String identifier for event type
 			 */
 			virtual const std::string GetEventType() const = 0;
 	};
 
+	/** @brief Compact runtime index of an event type */
+	using EventTypeID = uint32_t;
+
+	/**
+	 * @brief Reserve the next free event type index
+	 * @return New unique event type index
+	 */
+	EventTypeID NextEventTypeID();
+
+	/**
+	 * @brief Get the index of an event type
+	 *
+	 * Indices are assigned on first use and are only valid for the current run.
+	 * @tparam EventType Type of event
+	 * @return Index of the event type
+	 */
+	template<typename EventType> EventTypeID GetEventTypeID() {
+		static const EventTypeID id = NextEventTypeID();
+		return id;
+	}
+
 	/** @brief Function type for event handlers */
 	template<typename EventType> using EventFunction = std::function<void(const EventType& e)>;
 
 	/**
-	 * @brief Base class for event handlers
+	 * @brief Handle to an event subscription
+	 *
+	 * The generation is checked on unsubscribe, so a handle to a removed subscription
+	 * can never remove a newer handler that reused the same slot.
 	 */
-	class EventHandlerBase {
+	struct EventHandle {
+		EventTypeID type = 0;		///< Event type index
+		uint32_t index = 0;			///< Slot index in the event type's handler arena
+		uint32_t generation = 0;	///< Slot generation when subscribed, 0 for an invalid handle
+
+		/**
+		 * @brief Check if handle refers to a subscription
+		 * @return true if the handle was returned by a subscribe call
+		 */
+		bool IsValid() const { return generation != 0; }
+	};
+
+	/**
+	 * @brief Type-erased event handler with inline storage
+	 *
+	 * Handler functions up to inlineSize bytes are stored in place, larger ones are heap allocated.
+	 * An event handler is never moved once set, which allows executing it while other handlers are added.
+	 */
+	class EventHandler {
 		public:
+			/** @brief Maximum size of a handler function stored without allocating */
+			static constexpr size_t inlineSize = 4 * sizeof(void*);
+
+			EventHandler() {}
+			EventHandler(const EventHandler&) = delete;
+			EventHandler& operator=(const EventHandler&) = delete;
+			~EventHandler() { Reset(); }
+
+			/**
+			 * @brief Set handler function
+			 * @tparam EventType Type of event the function handles
+			 * @param function Function to execute
+			 */
+			template<typename EventType, typename Function> void Set(Function&& function) {
+				using Stored = std::decay_t<Function>;
+				Reset();
+				if constexpr (sizeof(Stored) <= inlineSize && alignof(Stored) <= alignof(std::max_align_t)) {
+					new (storage) Stored(std::forward<Function>(function));
+					execute = [](void* data, const Event& e) { (*std::launder(reinterpret_cast<Stored*>(data)))(static_cast<const EventType&>(e)); };
+					destroy = [](void* data) { std::launder(reinterpret_cast<Stored*>(data))->~Stored(); };
+				} else {
+					*reinterpret_cast<Stored**>(storage) = new Stored(std::forward<Function>(function));
+					execute = [](void* data, const Event& e) { (**reinterpret_cast<Stored**>(data))(static_cast<const EventType&>(e)); };
+					destroy = [](void* data) { delete *reinterpret_cast<Stored**>(data); };
+				}
+			}
+
 			/**
 			 * @brief Execute handler with event
-			 * @param e Event to handle
+			 * @param e Event to handle, must be of the type given to Set
+			 */
+			void Execute(const Event& e) { execute(storage, e); }
+
+			/**
+			 * @brief Destroy the stored handler function
+			 */
+			void Reset() {
+				if(destroy) destroy(storage);
+				execute = nullptr;
+				destroy = nullptr;
+			}
+
+		private:
+			alignas(std::max_align_t) unsigned char storage[inlineSize];	///< Handler function or pointer to it
+			void (*execute)(void* data, const Event& e) = nullptr;			///< Calls the stored function
+			void (*destroy)(void* data) = nullptr;							///< Destroys the stored function
+	};
+
+	/**
+	 * @brief Storage for all handlers of a single event type
+	 *
+	 * Handlers are kept in pages that double in size, so slots are contiguous within a page
+	 * and never move. Removed slots are reused through a freelist.
+	 */
+	class EventHandlerArena {
+		friend class EventManager;
+		public:
+			/** @brief Single handler slot */
+			struct Slot {
+				EventHandler handler;		///< Handler function
+				uint32_t generation = 1;	///< Incremented every time the slot is freed
+				bool active = false;		///< Whether the slot holds a subscribed handler
+			};
+
+			/**
+			 * @brief Add handler to arena
+			 * @tparam EventType Type of event
+			 * @param function Function to execute
+			 * @return Handle to the new subscription
+			 */
+			template<typename EventType, typename Function> EventHandle Add(Function&& function) {
+				uint32_t index = Allocate();
+				Slot& slot = Get(index);
+				slot.handler.Set<EventType>(std::forward<Function>(function));
+				slot.active = true;
+				return { GetEventTypeID<EventType>(), index, slot.generation };
+			}
+
+			/**
+			 * @brief Remove handler from arena
+			 * @param index Slot index
+			 * @param generation Slot generation of the subscription
+			 * @return true if the handler was removed
+			 */
+			bool Remove(uint32_t index, uint32_t generation);
+
+			/**
+			 * @brief Get slot at index
+			 * @param index Slot index
+			 * @return Reference to slot
 			 */
-			virtual void Execute(const Event& e) = 0;
+			Slot& Get(uint32_t index) {
+				uint32_t page = std::bit_width(index / firstPageSize + 1) - 1;
+				return pages[page][index - firstPageSize * ((1u << page) - 1)];
+			}
 
 			/**
-			 * @brief Get handler type ID
-			 * @return Unique ID for this handler
+			 * @brief Get number of allocated slots
+			 * @return Slot count including free slots
 			 */
-			Utilities::ID GetType() const { return handlerType; }
+			uint32_t Count() const { return count; }
+
+		private:
+			/** @brief Number of slots in the first page, every following page is twice as large */
+			static constexpr uint32_t firstPageSize = 4;
 
-			virtual ~EventHandlerBase() {}
+			/**
+			 * @brief Get index of a free slot, adding a page if needed
+			 * @return Slot index
+			 */
+			uint32_t Allocate();
 
-			const Utilities::ID handlerType;  ///< Unique handler identifier
+			std::vector<std::unique_ptr<Slot[]>> pages;	///< Slot pages
+			std::vector<uint32_t> freeSlots;				///< Indices of reusable slots
+			std::vector<uint32_t> removedSlots;				///< Slots removed while dispatching, freed afterwards
+			uint32_t count = 0;								///< Number of slots in use or free
+			uint32_t dispatching = 0;						///< Depth of currently running publishes
 	};
 
+	class EventManager;
+
 	/**
-	 * @brief Typed event handler implementation
+	 * @brief Event types that can be combined into a single queued event
+	 *
+	 * Queueing an event of a mergeable type merges it into the already queued event,
+	 * so only one event of that type is published per flush.
 	 */
-	template<typename EventType>
-	class EventHandler : public EventHandlerBase {
+	template<typename EventType> concept MergeableEvent = requires(EventType& queued, const EventType& event) { queued.Merge(event); };
+
+	/**
+	 * @brief Base class for queued events of a single type
+	 */
+	class EventQueueBase {
 		public:
 			/**
-			 * @brief Create new event handler
-			 * @param handler Function to execute
+			 * @brief Publish all queued events
+			 * @param manager Event manager to publish through
 			 */
-			explicit EventHandler(const EventFunction<EventType>& handler) : handler(handler) {};
+			virtual void Flush(EventManager& manager) = 0;
 
-			void Execute(const Event& event) override
-			{
-				if (event.GetEventType() == EventType::GetStaticEventType()) {
-					handler(static_cast<const EventType&>(event));
+			virtual ~EventQueueBase() {}
+	};
+
+	/**
+	 * @brief Queued events of a single type
+	 *
+	 * Events queued while flushing are kept for the next flush.
+	 */
+	template<typename EventType>
+	class EventQueue : public EventQueueBase {
+		public:
+			/**
+			 * @brief Add event to the queue
+			 * @param event Event to queue
+			 */
+			void Push(const EventType& event) {
+				if constexpr (MergeableEvent<EventType>) {
+					if (!events.empty()) {
+						events.back().Merge(event);
+						return;
+					}
 				}
+				events.push_back(event);
 			}
 
-			~EventHandler() {}
+			void Flush(EventManager& manager) override;
 
 		private:
-			EventFunction<EventType> handler;  ///< Handler function
+			std::vector<EventType> events;	///< Events waiting to be published
+			std::vector<EventType> batch;	///< Events currently being published, kept to reuse its capacity
 	};
 
 	/**
@@ -73,39 +251,89 @@ namespace StevEngine {
 	 */
 	class EventManager {
 		public:
+			~EventManager();
+
 			/**
 			 * @brief Subscribe to event type
 			 * @tparam EventType Type of event to subscribe to
 			 * @param handler Function to handle event
-			 * @return Unique ID for subscription
+			 * @return Handle for the subscription
 			 */
-			template<typename EventType> Utilities::ID Subscribe(EventFunction<EventType> handler) {
-				return Subscribe(EventType::GetStaticEventType(), new EventHandler<EventType>(handler));
+			template<typename EventType, typename Function> EventHandle Subscribe(Function&& handler) {
+				EventTypeID eventId = GetEventTypeID<EventType>();
+				if (eventId >= subscribers.size()) subscribers.resize(eventId + 1);
+				return subscribers[eventId].Add<EventType>(std::forward<Function>(handler));
 			}
 
 			/**
 			 * @brief Unsubscribe from event
-			 * @param eventId Event type identifier
-			 * @param handler Handler ID to unsubscribe
+			 * @param handle Handle returned when subscribing
 			 */
-			void Unsubscribe(const std::string eventId, const Utilities::ID handler);
+			void Unsubscribe(const EventHandle& handle);
 
 			/**
 			 * @brief Publish event to subscribers
+			 * @tparam EventType Type of event to publish
 			 * @param event Event to publish
 			 */
-			void Publish(const Event& event);
+			template<typename EventType> void Publish(const EventType& event) {
+				Publish(GetEventTypeID<EventType>(), event);
+			}
+
+			/**
+			 * @brief Queue event to be published at the next flush
+			 *
+			 * Queued events are published in batches when the engine flushes the event queues,
+			 * mergeable events are combined into one event per flush.
+			 * @tparam EventType Type of event to queue
+			 * @param event Event to queue
+			 */
+			template<typename EventType> void Queue(const EventType& event) {
+				EventTypeID eventId = GetEventTypeID<EventType>();
+				if (eventId >= queues.size()) queues.resize(eventId + 1);
+				if (!queues[eventId]) queues[eventId] = std::make_unique<EventQueue<EventType>>();
+				static_cast<EventQueue<EventType>*>(queues[eventId].get())->Push(event);
+				if (!queued) MarkQueued();
+			}
+
+			/**
+			 * @brief Publish all events queued on this manager
+			 */
+			void Flush();
+
+			/**
+			 * @brief Publish all events queued on any manager
+			 *
+			 * Called by the engine after pre-update and after update, before drawing.
+			 */
+			static void FlushQueues();
 
 		private:
 			/**
-			 * @brief Internal subscribe implementation
-			 * @param eventId Event type identifier
-			 * @param handler Handler to subscribe
-			 * @return Unique ID for subscription
+			 * @brief Internal publish implementation
+			 * @param eventId Event type index
+			 * @param event Event to publish
 			 */
-			Utilities::ID Subscribe(const std::string eventId, EventHandlerBase* handler);
+			void Publish(EventTypeID eventId, const Event& event);
 
-			/** @brief Map of event subscribers */
-			std::unordered_map<std::string, std::vector<EventHandlerBase*>> subscribers;
+			/**
+			 * @brief Add this manager to the list of managers with queued events
+			 */
+			void MarkQueued();
+
+			/** @brief Handler arenas, indexed by event type index */
+			std::vector<EventHandlerArena> subscribers;
+			/** @brief Queued events, indexed by event type index */
+			std::vector<std::unique_ptr<EventQueueBase>> queues;
+			/** @brief Whether this manager is waiting to be flushed */
+			bool queued = false;
 	};
+
+	template<typename EventType>
+	void EventQueue<EventType>::Flush(EventManager& manager) {
+		if (events.empty()) return;
+		batch.swap(events);
+		for (const EventType& event : batch) manager.Publish(event);
+		batch.clear();
+	}
 }
@@ -0,0 +1,74 @@
+#include "FramePacer.hpp"
+
+#include <SDL_timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace StevEngine {
+	//Frame stats
+	/** @brief Index of a percentile in a sorted list */
+	static uint32_t PercentileIndex(double percentile, uint32_t count) {
+		return std::clamp<double>(std::ceil(percentile / 100.0 * count), 1, count) - 1;
+	}
+
+	void FrameStats::Add(double frameMs) {
+		frameTimes[next] = frameMs;
+		next = (next + 1) % windowSize;
+		if (count < windowSize) count++;
+	}
+
+	void FrameStats::Sort(std::array<float, windowSize>& sorted) const {
+		//The window is the start of the buffer until it is full, so it can be copied as one range
+		std::copy(frameTimes.begin(), frameTimes.begin() + count, sorted.begin());
+		std::sort(sorted.begin(), sorted.begin() + count);
+	}
+
+	double FrameStats::GetPercentile(double percentile) const {
+		if (count == 0) return 0;
+		std::array<float, windowSize> sorted;
+		Sort(sorted);
+		return sorted[PercentileIndex(percentile, count)];
+	}
+
+	FrameTimeSummary FrameStats::GetSummary() const {
+		FrameTimeSummary summary;
+		if (count == 0) return summary;
+		std::array<float, windowSize> sorted;
+		Sort(sorted);
+		double total = 0;
+		for (uint32_t i = 0; i < count; i++) total += sorted[i];
+		summary.average = total / count;
+		summary.p50 = sorted[PercentileIndex(50, count)];
+		summary.p95 = sorted[PercentileIndex(95, count)];
+		summary.p99 = sorted[PercentileIndex(99, count)];
+		summary.max = sorted[count - 1];
+		return summary;
+	}
+
+	//Frame pacer
+	void FramePacer::SetTarget(int targetFPS) {
+		period = targetFPS > 0 ? SDL_GetPerformanceFrequency() / targetFPS : 0;
+		deadline = SDL_GetPerformanceCounter() + period;
+	}
+
+	void FramePacer::Wait() {
+		if (period == 0) return;
+		uint64_t now = SDL_GetPerformanceCounter();
+		//Start over from now if a frame took so long that the deadline is more than a frame behind
+		if (now >= deadline + period) {
+			deadline = now + period;
+			return;
+		}
+		if (now < deadline) {
+			uint64_t ticksPerMs = SDL_GetPerformanceFrequency() / 1000;
+			//Sleep until shortly before the deadline
+			uint64_t remainingMs = (deadline - now) / ticksPerMs;
+			if (remainingMs > spinMs) SDL_Delay(remainingMs - spinMs);
+			//Spin for the rest
+			while (SDL_GetPerformanceCounter() < deadline) std::this_thread::yield();
+		}
+		deadline += period;
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace StevEngine {
+	/** @brief Percentiles of recent frame times */
+	struct FrameTimeSummary {
+		double average = 0;	///< Average frame time in ms
+		double p50 = 0;		///< Median frame time in ms
+		double p95 = 0;		///< 95th percentile frame time in ms
+		double p99 = 0;		///< 99th percentile frame time in ms
+		double max = 0;		///< Longest frame time in ms
+	};
+
+	/**
+	 * @brief Rolling record of the most recent frame times
+	 *
+	 * Keeps a fixed window of frames, so adding a frame never allocates.
+	 * Percentiles are calculated from the window when requested.
+	 */
+	class FrameStats {
+		public:
+			/** @brief Number of frames kept */
+			static constexpr uint32_t windowSize = 512;
+
+			/**
+			 * @brief Add frame to the window, replacing the oldest frame when full
+			 * @param frameMs Frame time in ms
+			 */
+			void Add(double frameMs);
+
+			/**
+			 * @brief Get frame time that a percentage of frames in the window are at or below
+			 * @param percentile Percentage from 0 to 100
+			 * @return Frame time in ms, or 0 if no frames have been added
+			 */
+			double GetPercentile(double percentile) const;
+
+			/**
+			 * @brief Get average and percentiles of frames in the window
+			 * @return Summary of frame times
+			 */
+			FrameTimeSummary GetSummary() const;
+
+			/**
+			 * @brief Get number of frames in the window
+			 * @return Frame count
+			 */
+			uint32_t GetCount() const { return count; }
+
+			/**
+			 * @brief Remove all frames
+			 */
+			void Clear() { count = 0; next = 0; }
+
+		private:
+			/**
+			 * @brief Copy frames in the window to sorted scratch storage
+			 * @param sorted Output array, only the first GetCount() values are set
+			 */
+			void Sort(std::array<float, windowSize>& sorted) const;
+
+			std::array<float, windowSize> frameTimes;	///< Ring buffer of frame times in ms
+			uint32_t next = 0;							///< Index the next frame is written to
+			uint32_t count = 0;							///< Number of frames in the window
+	};
+
+	/**
+	 * @brief Waits for the start of the next frame at a target frame rate
+	 *
+	 * Frames are scheduled on fixed deadlines instead of sleeping for the remaining time of the current frame,
+	 * so rounding errors do not add up. Sleeping is only accurate to about a millisecond, so the pacer sleeps
+	 * until shortly before the deadline and spins for the rest.
+	 */
+	class FramePacer {
+		public:
+			/**
+			 * @brief Set target frame rate
+			 * @param targetFPS Frames per second, -1 for unlimited
+			 */
+			void SetTarget(int targetFPS);
+
+			/**
+			 * @brief Wait until the next frame should start
+			 */
+			void Wait();
+
+		private:
+			uint64_t period = 0;	///< Time between frames in performance counter ticks, 0 if unlimited
+			uint64_t deadline = 0;	///< Start time of the next frame in performance counter ticks
+
+			/** @brief Time before a deadline where sleeping stops and spinning starts, in ms */
+			static constexpr uint32_t spinMs = 2;
+	};
+}
@@ -27,108 +27,139 @@ namespace StevEngine {
 		if(!isActive) return;
 		events.Publish(UpdateEvent(deltaTime));
 	}
+	void GameObject::FixedUpdate(double deltaTime) {
+		if(!isActive) return;
+		events.Publish(FixedUpdateEvent(deltaTime));
+	}
 	#ifdef StevEngine_SHOW_WINDOW
-	void GameObject::Draw(Utilities::Matrix4 transform) {
-		//New transform
-		transform = Utilities::Matrix4::FromTranslationRotationScale(position, rotation, scale) * transform;
-		//Event
-		events.Publish(DrawEvent(transform));
+	void GameObject::Draw() {
+		events.Publish(DrawEvent(transforms.GetWorldMatrix(transform)));
 	}
 	#endif
 
 	//Transform
-	Utilities::Vector3 GameObject::GetPosition() const { return position; }
-	Utilities::Quaternion GameObject::GetRotation() const { return rotation; }
-	Utilities::Vector3 GameObject::GetScale() const { return scale; }
+	Utilities::Vector3 GameObject::GetPosition() const { return transforms.GetPosition(transform); }
+	Utilities::Quaternion GameObject::GetRotation() const { return transforms.GetRotation(transform); }
+	Utilities::Vector3 GameObject::GetScale() const { return transforms.GetScale(transform); }
 	void GameObject::SetPosition(Utilities::Vector3 position, bool announce) {
-		this->position = position;
-		if(announce) events.Publish(TransformUpdateEvent(true, false, false));
+		transforms.SetPosition(transform, position);
+		if(announce) AnnounceTransform(TransformUpdateEvent(true, false, false));
 	}
 	void GameObject::SetRotation(Utilities::Quaternion rotation, bool announce) {
-		this->rotation = rotation;
-		if(announce) events.Publish(TransformUpdateEvent(false, true, false));
+		transforms.SetRotation(transform, rotation);
+		if(announce) AnnounceTransform(TransformUpdateEvent(false, true, false));
 	}
 	void GameObject::SetScale(Utilities::Vector3 scale, bool announce) {
-		this->scale = scale;
-		if(announce) events.Publish(TransformUpdateEvent(false, false, true));
+		transforms.SetScale(transform, scale);
+		if(announce) AnnounceTransform(TransformUpdateEvent(false, false, true));
 	}
 	void GameObject::SetTransform(Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale, bool announce) {
-		this->position = position;
-		this->rotation = rotation;
-		this->scale = scale;
-		if(announce) events.Publish(TransformUpdateEvent(true, true, true));
-	}
-	Utilities::Vector3 GameObject::GetWorldPosition() const {
-		if(!parent.IsNull()) {
-			GameObject& object = GetParent();
-			return (Utilities::Matrix4::FromTranslationRotationScale(object.GetWorldPosition(), object.GetRotation(), object.GetScale()) * position);
-		} else {
-			return position;
-		}
-	}
-	Utilities::Quaternion GameObject::GetWorldRotation() const {
-		if(!parent.IsNull()) {
-			return GetParent().GetWorldRotation() * rotation;
-		} else {
-			return rotation;
-		}
-	}
-	Utilities::Vector3 GameObject::GetWorldScale() const {
-		if(!parent.IsNull()) {
-			return Utilities::Vector3::CombineScale(GetParent().GetWorldScale(), scale);
-		} else {
-			return scale;
-		}
-	}
+		transforms.SetPosition(transform, position);
+		transforms.SetRotation(transform, rotation);
+		transforms.SetScale(transform, scale);
+		if(announce) AnnounceTransform(TransformUpdateEvent(true, true, true));
+	}
+	void GameObject::AnnounceTransform(const TransformUpdateEvent& event) {
+		if(queueTransformEvents) events.Queue(event);
+		else events.Publish(event);
+	}
+	Utilities::Vector3 GameObject::GetWorldPosition() const { return transforms.GetWorldPosition(transform); }
+	Utilities::Quaternion GameObject::GetWorldRotation() const { return transforms.GetWorldRotation(transform); }
+	Utilities::Vector3 GameObject::GetWorldScale() const { return transforms.GetWorldScale(transform); }
+	Utilities::Matrix4 GameObject::GetWorldMatrix() const { return transforms.GetWorldMatrix(transform); }
 
 	//Constructors
-	GameObject::GameObject(Utilities::ID id, std::string name, std::string scene) : id(id), name(name), scene(scene) {
+	GameObject::GameObject(Utilities::ID id, std::string name, Scene& scene, ObjectHandle handle)
+	  : id(id), name(name), handle(handle), scene(scene), transforms(scene.transforms), transform(transforms.Create()) {
 		//Log::Normal(std::format("Creating gameobject with id {}", id.GetString()), true);
 	}
 
 	//Children functions
 	int GameObject::AddChild(const Utilities::ID& id) {
-		children.emplace_back(id);
-		GetScene().GetObject(id).SetParent(this->id);
+		GameObject& child = scene.GetObject(id);
+		children.emplace_back(child.handle);
+		child.SetParent(*this);
 		int i = children.size() - 1;
 		return i;
 	}
 	void GameObject::RemoveChild(int index) {
-		GetChild(index).parent = Utilities::ID::empty;
+		GameObject& child = GetChild(index);
+		child.parent = ObjectHandle();
+		transforms.SetParent(child.transform, TransformHierarchy::none);
 		children.erase(children.begin() + index);
 	}
 	GameObject& GameObject::GetChild(int index) const {
-		return GetScene().GetObject(children[index]);
+		return scene.GetObject(children[index]);
 	}
 	uint32_t GameObject::GetChildCount() const {
 		return children.size();
 	}
 	GameObject& GameObject::GetParent() const {
-		return GetScene().GetObject(parent);
+		return scene.GetObject(parent);
 	}
 	Scene& GameObject::GetScene() const {
-		return sceneManager.GetScene(scene);
+		return scene;
 	}
-	void GameObject::SetParent(const Utilities::ID& id) {
-		if(id.IsNull()) return;
-		if(!parent.IsNull()) {
+	void GameObject::SetParent(GameObject& object) {
+		if(HasParent()) {
 			GameObject& p = GetParent();
-			for(auto[id, event] : handlers) p.Unsubscribe(event, id);
+			for(auto& handle : handlers) p.Unsubscribe(handle);
+			handlers.clear();
 			//Remove from parent list
 			for(int i = 0; i < p.GetChildCount(); i++) {
-				if(p.children.at(i) == Id()) {
+				if(p.children.at(i) == handle) {
 					p.RemoveChild(i);
 					break;
 				}
 			}
 		}
-		GameObject& object = GetScene().GetObject(id);
-		handlers.emplace_back(object.Subscribe<UpdateEvent>([this] (UpdateEvent e) { this->Update(e.deltaTime); }), UpdateEvent::GetStaticEventType());
-		#ifdef StevEngine_SHOW_WINDOW
-		handlers.emplace_back(object.Subscribe<DrawEvent>([this] (DrawEvent e) { this->Draw(e.transform);  }), DrawEvent::GetStaticEventType());
-		#endif
-		handlers.emplace_back(object.Subscribe<DeactivateEvent>([this] (DeactivateEvent) { this->Deactivate();  }), DeactivateEvent::GetStaticEventType());
-		parent = id;
+		//Update and draw are called on every object by the SceneManager, only deactivation follows the parent
+		handlers.emplace_back(object.Subscribe<DeactivateEvent>([this] (DeactivateEvent) { this->Deactivate();  }));
+		parent = object.handle;
+		transforms.SetParent(transform, object.transform);
+	}
+
+	//Components
+	void GameObject::RegisterComponent(Component* component) {
+		ComponentRegistry::Add(component);
+		ComponentMask bit = ComponentRegistry::GetBit(component->typeID);
+		if (componentMask & bit) return;
+		//First component of its type, insert at its position in the type order
+		typeComponents.insert(typeComponents.begin() + std::popcount(componentMask & (bit - 1)), component);
+		componentMask |= bit;
+	}
+	void GameObject::StartComponent(Component* component) {
+		//Starting registers the component with shared systems, like rendering and physics, which are not thread safe
+		if(scene.deferChanges) scene.Defer([this, component] () { if(isActive) component->Start(); });
+		else component->Start();
+	}
+	void GameObject::DestroyComponent(size_t index) {
+		Component* component = components[index].get();
+		//Destroying deactivates the component, which is deferred for the same reason as starting it
+		if(scene.deferChanges) {
+			scene.Defer([this, component] () {
+				for(size_t i = 0; i < components.size(); i++) {
+					if(components[i].get() == component) return DestroyComponent(i);
+				}
+			});
+			return;
+		}
+		ComponentRegistry::Remove(component);
+		//Replace in type lookup with the next component of the same type
+		ComponentMask bit = ComponentRegistry::GetBit(component->typeID);
+		size_t position = std::popcount(componentMask & (bit - 1));
+		if (typeComponents[position] == component) {
+			Component* next = nullptr;
+			for (size_t i = index + 1; i < components.size() && !next; i++) {
+				if (ComponentRegistry::GetBit(components[i]->typeID) == bit) next = components[i].get();
+			}
+			if (next) typeComponents[position] = next;
+			else {
+				typeComponents.erase(typeComponents.begin() + position);
+				componentMask &= ~bit;
+			}
+		}
+		components.erase(components.begin() + index);
 	}
 
 	//Export to stream
@@ -136,7 +167,7 @@ namespace StevEngine {
 		Utilities::Stream stream(type);
 		//Basic info
 		stream << id << name;
-		stream << position << rotation << scale;
+		stream << GetPosition() << GetRotation() << GetScale();
 		//Components and children
 		stream << (uint32_t)components.size() << GetChildCount();
 		for(auto& component : components) {
@@ -150,7 +181,10 @@ namespace StevEngine {
 	//Import from stream
 	void GameObject::Import(Utilities::Stream& stream) {
 		//Basic info
+		Utilities::Vector3 position, scale;
+		Utilities::Quaternion rotation;
 		stream >> name >> position >> rotation >> scale;
+		SetTransform(position, rotation, scale, false);
 		//Components and children
 		uint32_t components, children;
 		stream >> components >> children;
@@ -161,25 +195,31 @@ namespace StevEngine {
 			if(component) AddComponent(component);
 		}
 		for(int i = 0; i < children; i++) {
-			GetScene().CreateObject(stream);
+			scene.CreateObject(stream);
 		}
 	}
 	//Destroy
 	GameObject::~GameObject() {
 		///Log::Normal(std::format("Destroying object with id {}", id), true);
 		//Remove event listeners
-		if(HasParent() && GetScene().Exists(parent)) {
+		if(HasParent() && scene.Exists(parent)) {
 			GameObject& p = GetParent();
-			for(auto[id, event] : handlers) p.Unsubscribe(event, id);
+			for(auto& handle : handlers) p.Unsubscribe(handle);
 		}
 		//Destroy children
-		for (int i = 0; i < children.size(); i++) {
-			auto& s = GetScene();
-			s.GetObject(children[i]).SetParent(Utilities::ID::empty);
-			s.DestroyObject(children[i]);
+		while (!children.empty()) {
+			ObjectHandle child = children.back();
+			GetChild(children.size() - 1).handlers.clear();
+			RemoveChild(children.size() - 1);
+			scene.DestroyObject(child);
 		}
 		//Destroy components
-		for (auto& c : components) c->handlers.clear();
+		for (auto& c : components) {
+			c->handlers.clear();
+			ComponentRegistry::Remove(c.get());
+		}
 		components.clear();
+		//Free transform
+		transforms.Destroy(transform);
 	}
 }
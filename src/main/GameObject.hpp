@@ -6,12 +6,16 @@
 #include "utilities/Matrix4.hpp"
 #include "main/Log.hpp"
 #include "main/Component.hpp"
+#include "main/TransformHierarchy.hpp"
 
+#include <bit>
 #include <memory>
 #include <vector>
 #include <type_traits>
 
 namespace StevEngine {
+	class TransformUpdateEvent;
+
 	//Child Events
 	/**
 	 * @brief Wrapper for events from child objects
@@ -26,6 +30,23 @@ namespace StevEngine {
 			static const std::string GetStaticEventType() {  return "Child" + EventType::GetStaticEventType(); }
 	};
 
+	/**
+	 * @brief Stable handle to a GameObject in its scene
+	 *
+	 * Handles stay valid while the object exists, and are invalidated once it is destroyed,
+	 * even if its slot is reused by a new object.
+	 */
+	struct ObjectHandle {
+		uint32_t index = UINT32_MAX;	///< Slot index in scene storage
+		uint32_t generation = 0;		///< Slot generation when the object was created
+		/**
+		 * @brief Check if handle refers to an object
+		 * @return true if handle is set, otherwise false
+		 */
+		bool IsValid() const { return index != UINT32_MAX; }
+		bool operator==(const ObjectHandle& other) const = default;
+	};
+
 	/**
 	 * @brief Core game object class
 	 *
@@ -46,9 +67,22 @@ namespace StevEngine {
 			 */
 			Utilities::ID Id() const { return id; }
 
+			/**
+			 * @brief Check if object is active
+			 * @return true if object has been started and not deactivated
+			 */
+			bool IsActive() const { return isActive; }
+
+			/**
+			 * @brief Get handle of object in its scene
+			 * @return Object handle
+			 */
+			ObjectHandle Handle() const { return handle; }
+
 		private:
 			Utilities::ID id;	  	///< Unique identifier
-			std::string scene;	  	///< Containing scene name
+			ObjectHandle handle;	///< Handle in containing scene
+			Scene& scene;	  		///< Containing scene
 			bool isActive = false;	///< Is this gameobject currently active
 
 		//Transform
@@ -75,21 +109,21 @@ namespace StevEngine {
 			/**
 			 * @brief Set local position
 			 * @param position New position
-			 * @param announce Whether to trigger transform event
+			 * @param announce Whether to announce the change with a transform event
 			 */
 			void SetPosition(Utilities::Vector3 position, bool announce = true);
 
 			/**
 			 * @brief Set local rotation
 			 * @param rotation New rotation
-			 * @param announce Whether to trigger transform event
+			 * @param announce Whether to announce the change with a transform event
 			 */
 			void SetRotation(Utilities::Quaternion rotation, bool announce = true);
 
 			/**
 			 * @brief Set local scale
 			 * @param scale New scale
-			 * @param announce Whether to trigger transform event
+			 * @param announce Whether to announce the change with a transform event
 			 */
 			void SetScale(Utilities::Vector3 scale, bool announce = true);
 
@@ -98,7 +132,7 @@ namespace StevEngine {
 			 * @param position New position
 			 * @param rotation New rotation
 			 * @param scale New scale
-			 * @param announce Whether to trigger transform event
+			 * @param announce Whether to announce the change with a transform event
 			 */
 			void SetTransform(Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale, bool announce = true);
 
@@ -121,10 +155,43 @@ namespace StevEngine {
 			 */
 			Utilities::Vector3 GetWorldScale() const;
 
+			/**
+			 * @brief Get world transformation matrix
+			 * @return World space transformation matrix
+			 */
+			Utilities::Matrix4 GetWorldMatrix() const;
+
+			/**
+			 * @brief Get handle of the object's transform in the scene's TransformHierarchy
+			 * @return Transform handle
+			 */
+			uint32_t GetTransformHandle() const { return transform; }
+
+			/**
+			 * @brief Set whether transform events are queued instead of published
+			 *
+			 * Published events reach the handlers before the setter returns.
+			 * Queued events are merged and published at the next event flush, so setting the transform several times in one phase only announces it once.
+			 * @param queue Whether to queue transform events
+			 */
+			void SetQueueTransformEvents(bool queue) { queueTransformEvents = queue; }
+
+			/**
+			 * @brief Check if transform events are queued instead of published
+			 * @return true if queued, otherwise false
+			 */
+			bool IsQueueingTransformEvents() const { return queueTransformEvents; }
+
 		private:
-			Utilities::Vector3 position = Utilities::Vector3();		 ///< Local position
-			Utilities::Quaternion rotation = Utilities::Quaternion();   ///< Local rotation
-			Utilities::Vector3 scale = Utilities::Vector3(1,1,1);	  ///< Local scale
+			/**
+			 * @brief Announce a transform change, publishing or queueing it
+			 * @param event Changed transform components
+			 */
+			void AnnounceTransform(const TransformUpdateEvent& event);
+
+			TransformHierarchy& transforms;		///< Transform storage of the containing scene
+			uint32_t transform;					///< Handle to this object's transform in the scene storage
+			bool queueTransformEvents = false;	///< Whether transform events are queued instead of published
 
 		//Main functions
 		public:
@@ -160,12 +227,17 @@ namespace StevEngine {
 			 */
 			void Update(double deltaTime);
 
+			/**
+			 * @brief Update object logic on a fixed time step
+			 * @param deltaTime Fixed time step
+			 */
+			void FixedUpdate(double deltaTime);
+
 			#ifdef StevEngine_SHOW_WINDOW
 			/**
 			 * @brief Draw object visuals
-			 * @param transform World transform matrix
 			 */
-			void Draw(Utilities::Matrix4 transform);
+			void Draw();
 			#endif
 
 		public:
@@ -174,7 +246,7 @@ namespace StevEngine {
 			 *
 			 * Constructs a GameObject with the specified properties.
 			 */
-			GameObject(Utilities::ID id, std::string name, std::string scene);
+			GameObject(Utilities::ID id, std::string name, Scene& scene, ObjectHandle handle);
 
 		//Events
 		public:
@@ -183,13 +255,13 @@ namespace StevEngine {
 			 * @tparam EventType Type of event to subscribe to
 			 * @param handler Function to handle event
 			 * @param allowFromChild Whether to receive events from children
-			 * @return Subscription ID
+			 * @return Subscription handle
 			 */
-			template<typename EventType>
-			Utilities::ID Subscribe(EventFunction<EventType> handler, bool allowFromChild = true) {
+			template<typename EventType, typename Function>
+			EventHandle Subscribe(Function&& handler, bool allowFromChild = true) {
 				if(allowFromChild)
-					events.Subscribe<ChildEvent<EventType>>([handler] (ChildEvent<EventType> e) { handler(e.event); });
-				return events.Subscribe<EventType>(handler);
+					events.Subscribe<ChildEvent<EventType>>([handler] (const ChildEvent<EventType>& e) { handler(e.event); });
+				return events.Subscribe<EventType>(std::forward<Function>(handler));
 			}
 
 			/**
@@ -203,12 +275,21 @@ namespace StevEngine {
 				if(HasParent()) GetParent().ChildPublish<EventType>(event, id);
 			}
 
+			/**
+			 * @brief Queue an event to be published at the next event flush
+			 *
+			 * Unlike Publish, queued events are not passed on to the parent objects.
+			 * @tparam EventType Type of event to queue
+			 * @param event Event to queue
+			 */
+			template<typename EventType>
+			void Queue(const EventType& event) { events.Queue(event); }
+
 			/**
 			 * @brief Unsubscribe from events
-			 * @param eventId Event type identifier
-			 * @param handlerId Handler ID to unsubscribe
+			 * @param handle Handle returned when subscribing
 			 */
-			void Unsubscribe(const std::string eventId, const Utilities::ID handlerId) { events.Unsubscribe(eventId, handlerId); }
+			void Unsubscribe(const EventHandle& handle) { events.Unsubscribe(handle); }
 
 		private:
 			/**
@@ -224,7 +305,7 @@ namespace StevEngine {
 			}
 
 			EventManager events;   ///< Object event manager
-			std::vector<std::pair<Utilities::ID, std::string>> handlers;  ///< Event handler registrations
+			std::vector<EventHandle> handlers;  ///< Event handler registrations
 
 		//Children functions
 		public:
@@ -258,7 +339,7 @@ namespace StevEngine {
 			 * @brief Check if object has a parent
 			 * @return true if object has a parent, otherwise false
 			 */
-			bool HasParent() const { return !parent.IsNull(); }
+			bool HasParent() const { return parent.IsValid(); }
 
 			/**
 			 * @brief Get parent object
@@ -275,18 +356,80 @@ namespace StevEngine {
 		private:
 			/**
 			 * @brief Set parent object
-			 * @param id ID of parent object
+			 * @param object Parent object
 			 */
-			void SetParent(const Utilities::ID& id);
+			void SetParent(GameObject& object);
 
-			Utilities::ID parent = Utilities::ID::empty;  ///< Parent object ID
-			std::vector<Utilities::ID> children;		  ///< Child object IDs
+			ObjectHandle parent;				///< Parent object handle
+			std::vector<ObjectHandle> children;	///< Child object handles
 
 		//Component functions
 		private:
 			std::vector<std::unique_ptr<Component>> components;  ///< Attached components
+			ComponentMask componentMask = 0;	///< Type indices of all attached components
+			std::vector<Component*> typeComponents;	///< First attached component of each bit in the mask, ordered by type index
+
+			/**
+			 * @brief Check if a component matches a query
+			 * @param query Query to check against
+			 * @param mask Mask of the query
+			 * @param component Component to check
+			 * @return true if the component is of the query class
+			 */
+			static bool MatchesQuery(const ComponentRegistry::Query& query, ComponentMask mask, const Component* component) {
+				if ((mask & ComponentRegistry::GetBit(component->typeID)) == 0) return false;
+				//Classes sharing the last bit are told apart by testing the component
+				return component->typeID < ComponentRegistry::sharedType || query.test(component);
+			}
+
+			/**
+			 * @brief Find first component matching a query
+			 * @param query Query to search for
+			 * @return Pointer to component or nullptr if not found
+			 */
+			Component* FindComponent(const ComponentRegistry::Query& query) const {
+				ComponentMask found = componentMask & query.mask.load(std::memory_order_relaxed);
+				if (found == 0) return nullptr;
+				ComponentTypeID type = std::countr_zero(found);
+				if (type < ComponentRegistry::sharedType) return typeComponents[std::popcount(componentMask & ((ComponentMask(1) << type) - 1))];
+				for (const std::unique_ptr<Component>& component : components) {
+					if (MatchesQuery(query, found, component.get())) return component.get();
+				}
+				return nullptr;
+			}
+
+			/**
+			 * @brief Add component to type lookup and instance lists
+			 * @param component Component to register
+			 */
+			void RegisterComponent(Component* component);
+
+			/**
+			 * @brief Start component, or defer it while objects are updated in parallel
+			 * @param component Component to start
+			 */
+			void StartComponent(Component* component);
+
+			/**
+			 * @brief Remove and destroy component
+			 *
+			 * While objects are updated in parallel, the component is destroyed once the update is done.
+			 * @param index Index of component in component list
+			 */
+			void DestroyComponent(size_t index);
 
 		public:
+			/**
+			 * @brief Check if object has a component of specified type
+			 * @tparam T Component type to check for
+			 * @return true if a matching component is attached, otherwise false
+			 */
+			template <class T>
+			requires std::is_base_of_v<Component, T>
+			bool HasComponent() const {
+				return FindComponent(ComponentRegistry::GetQuery<T>()) != nullptr;
+			}
+
 			/**
 			 * @brief Get component of specified type
 			 * @tparam T Component type to get
@@ -297,12 +440,8 @@ namespace StevEngine {
 			requires std::is_base_of_v<Component, T>
 			T* GetComponent(bool log = true) {
 				//Find component
-				for (int i = 0; i < components.size(); i++) {
-					if (dynamic_cast<T*>(components[i].get())) {
-						T* component = (T*)components[i].get();
-						return component;
-					}
-				}
+				Component* component = FindComponent(ComponentRegistry::GetQuery<T>());
+				if (component) return static_cast<T*>(component);
 				//Return null
 				if (log) Log::Error(std::format("No component of type \"{}\" found on object {}", typeid(T).name(), id.GetString()), true);
 				return nullptr;
@@ -318,14 +457,16 @@ namespace StevEngine {
 			GetAllComponents() {
 				//Define vector
 				std::vector<T*> foundComponents;
+				const ComponentRegistry::Query& query = ComponentRegistry::GetQuery<T>();
+				ComponentMask mask = componentMask & query.mask.load(std::memory_order_relaxed);
+				if (mask == 0) return foundComponents;
 				//Find components
 				for (int i = 0; i < components.size(); i++) {
-					if (dynamic_cast<T*>(components[i].get())) {
-						T* component = (T*)components[i].get();
-						foundComponents.push_back(component);
+					if (MatchesQuery(query, mask, components[i].get())) {
+						foundComponents.push_back(static_cast<T*>(components[i].get()));
 					}
 				}
-				//Return null
+				//Return components
 				return foundComponents;
 			}
 
@@ -378,9 +519,14 @@ namespace StevEngine {
 					}
 				}
 				//Add to list
-				component->SetObject(*this, this->scene);
 				components.emplace_back(component);
-				if(isActive) component->Start();
+				RegisterComponent(component);
+				//Classes not registered for creation get their batch functions when first added as themselves
+				if constexpr (UpdateSystem<T> || DrawSystem<T>) {
+					if(typeid(*component) == typeid(T)) ComponentRegistry::RegisterSystems<T>(component->typeID);
+				}
+				component->SetObject(*this);
+				if(isActive) StartComponent(component);
 				return component;
 			}
 
@@ -391,18 +537,11 @@ namespace StevEngine {
 			template <class T>
 			requires std::is_base_of_v<Component,T>
 			void RemoveAllComponents() {
-				//Find component
-				auto i = components.begin();
-				while (i != components.end()) {
-					if (dynamic_cast<T*>(*i)) {
-						//Delete component from memory
-						///delete *i;
-						//Remove from list
-						i = components.erase(i);
-					}
-					else {
-						++i;
-					}
+				const ComponentRegistry::Query& query = ComponentRegistry::GetQuery<T>();
+				ComponentMask mask = query.mask.load(std::memory_order_relaxed);
+				//Find components, from the back so indices stay valid
+				for (size_t i = components.size(); i > 0 && (componentMask & mask) != 0; i--) {
+					if (MatchesQuery(query, mask, components[i - 1].get())) DestroyComponent(i - 1);
 				}
 			}
 
@@ -417,10 +556,8 @@ namespace StevEngine {
 				//Find component
 				for (int i = 0; i < components.size(); i++) {
 					if (components[i].get() == component) {
-						//Remove from list
-						components.erase(components.begin() + i);
-						//Delete component from memory
-						delete component;
+						//Remove from list and delete component from memory
+						DestroyComponent(i);
 						return;
 					}
 				}
@@ -443,6 +580,15 @@ namespace StevEngine {
 			  : position(position), rotation(rotation), scale(scale) {}
 			const std::string GetEventType() const override { return GetStaticEventType(); };
 			static const std::string GetStaticEventType() {  return "TransformUpdateEvent"; }
+			/**
+			 * @brief Combine with a later transform update
+			 * @param other Transform update to combine with
+			 */
+			void Merge(const TransformUpdateEvent& other) {
+				position |= other.position;
+				rotation |= other.rotation;
+				scale |= other.scale;
+			}
 			bool position, rotation, scale;  ///< Which transform components changed
 	};
 
@@ -0,0 +1,161 @@
+#include "JobSystem.hpp"
+
+namespace StevEngine {
+	JobSystem jobs = JobSystem();
+
+	/** @brief Queue index of the current thread, 0 for threads outside the pool */
+	thread_local uint32_t currentQueue = 0;
+
+	void JobSystem::Init(uint32_t workers) {
+		if (!threads.empty()) return;
+		if (workers == 0) workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		stopping = false;
+		//One queue per worker, and the shared queue
+		for (uint32_t i = 0; i <= workers; i++) queues.push_back(std::make_unique<Queue>());
+		for (uint32_t i = 1; i <= workers; i++) threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	void JobSystem::Shutdown() {
+		if (threads.empty()) return;
+		{
+			std::lock_guard lock(sleepMutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (std::thread& thread : threads) thread.join();
+		threads.clear();
+		//Finish jobs left in the queues
+		while (RunOne(0) || RunBackground());
+		queues.clear();
+	}
+
+	JobSystem::~JobSystem() {
+		Shutdown();
+	}
+
+	JobHandle JobSystem::Schedule(std::function<void()> function, std::span<const JobHandle> dependencies) {
+		JobHandle job = std::make_shared<Job>();
+		job->function = std::move(function);
+		//Wait for dependencies that have not finished yet
+		for (const JobHandle& dependency : dependencies) {
+			if (!dependency) continue;
+			std::lock_guard lock(dependency->mutex);
+			if (dependency->IsDone()) continue;
+			dependency->dependents.push_back(job);
+			job->waiting++;
+		}
+		//Remove the scheduling count, the job is ready if no dependencies are left
+		if (--job->waiting == 0) Enqueue(job);
+		return job;
+	}
+
+	JobHandle JobSystem::ScheduleBackground(std::function<void()> function) {
+		JobHandle job = std::make_shared<Job>();
+		job->function = std::move(function);
+		job->waiting = 0;
+		//Run directly when there are no workers
+		if (queues.empty()) {
+			job->function();
+			Complete(*job);
+			return job;
+		}
+		{
+			std::lock_guard lock(background.mutex);
+			background.jobs.push_back(job);
+		}
+		backgroundQueued++;
+		{ std::lock_guard lock(sleepMutex); }
+		wake.notify_one();
+		return job;
+	}
+
+	void JobSystem::Wait(const JobHandle& job) {
+		if (!job) return;
+		while (!job->IsDone()) {
+			if (!RunOne(currentQueue)) std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::WorkerLoop(uint32_t queue) {
+		currentQueue = queue;
+		while (true) {
+			//Background jobs only run when there is nothing else to do
+			if (RunOne(queue) || RunBackground()) continue;
+			//Sleep until new jobs are added
+			std::unique_lock lock(sleepMutex);
+			wake.wait(lock, [this] () { return stopping || queued > 0 || backgroundQueued > 0; });
+			if (stopping) return;
+		}
+	}
+
+	void JobSystem::Enqueue(std::shared_ptr<Job> job) {
+		//Run directly when there are no workers
+		if (queues.empty()) {
+			job->function();
+			Complete(*job);
+			return;
+		}
+		Queue& queue = *queues[currentQueue];
+		{
+			std::lock_guard lock(queue.mutex);
+			queue.jobs.push_back(std::move(job));
+		}
+		queued++;
+		//Lock so a worker can not miss the wake up between checking for jobs and sleeping
+		{ std::lock_guard lock(sleepMutex); }
+		wake.notify_one();
+	}
+
+	bool JobSystem::RunOne(uint32_t queue) {
+		std::shared_ptr<Job> job;
+		//Take newest job from own queue, as its data is most likely still in cache
+		{
+			std::lock_guard lock(queues[queue]->mutex);
+			if (!queues[queue]->jobs.empty()) {
+				job = std::move(queues[queue]->jobs.back());
+				queues[queue]->jobs.pop_back();
+			}
+		}
+		//Take oldest job from another queue
+		for (size_t i = 1; !job && i < queues.size(); i++) {
+			Queue& other = *queues[(queue + i) % queues.size()];
+			std::lock_guard lock(other.mutex);
+			if (!other.jobs.empty()) {
+				job = std::move(other.jobs.front());
+				other.jobs.pop_front();
+			}
+		}
+		if (!job) return false;
+		queued--;
+		job->function();
+		Complete(*job);
+		return true;
+	}
+
+	bool JobSystem::RunBackground() {
+		std::shared_ptr<Job> job;
+		{
+			std::lock_guard lock(background.mutex);
+			if (background.jobs.empty()) return false;
+			job = std::move(background.jobs.front());
+			background.jobs.pop_front();
+		}
+		backgroundQueued--;
+		job->function();
+		Complete(*job);
+		return true;
+	}
+
+	void JobSystem::Complete(Job& job) {
+		std::vector<std::shared_ptr<Job>> dependents;
+		job.function = nullptr;
+		{
+			std::lock_guard lock(job.mutex);
+			job.done.store(true, std::memory_order_release);
+			dependents.swap(job.dependents);
+		}
+		for (std::shared_ptr<Job>& dependent : dependents) {
+			if (--dependent->waiting == 0) Enqueue(std::move(dependent));
+		}
+	}
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace StevEngine {
+	class JobSystem;
+
+	/**
+	 * @brief Function scheduled on the job system
+	 *
+	 * Jobs run once all jobs they depend on have finished.
+	 */
+	class Job {
+		friend class JobSystem;
+		public:
+			/**
+			 * @brief Check if job has finished running
+			 * @return true if finished, otherwise false
+			 */
+			bool IsDone() const { return done.load(std::memory_order_acquire); }
+
+		private:
+			std::function<void()> function;				///< Function to run
+			std::atomic<uint32_t> waiting = 1;				///< Number of unfinished dependencies, plus one while scheduling
+			std::atomic<bool> done = false;					///< Whether the job has finished
+			std::mutex mutex;								///< Protects the list of dependents
+			std::vector<std::shared_ptr<Job>> dependents;	///< Jobs waiting for this job to finish
+	};
+
+	/** @brief Handle to a scheduled job, used to wait for or depend on it */
+	using JobHandle = std::shared_ptr<Job>;
+
+	/**
+	 * @brief Engine wide pool of worker threads
+	 *
+	 * Every worker has its own queue of jobs, and takes jobs from the other queues when it runs out.
+	 * Threads waiting for a job help running jobs until it is done. Jobs scheduled from threads
+	 * outside the pool are put in a shared queue.
+	 * Long running work, like loading files, is scheduled as background jobs, which only idle workers run,
+	 * so waiting threads never pick one up in the middle of a frame.
+	 */
+	class JobSystem {
+		public:
+			/**
+			 * @brief Start worker threads
+			 * @param workers Number of worker threads, 0 to use one less than the number of hardware threads
+			 */
+			void Init(uint32_t workers = 0);
+
+			/**
+			 * @brief Stop and join all worker threads
+			 */
+			void Shutdown();
+
+			~JobSystem();
+
+			/**
+			 * @brief Schedule a job
+			 * @param function Function to run
+			 * @param dependencies Jobs that have to finish before this job runs
+			 * @return Handle to the new job
+			 */
+			JobHandle Schedule(std::function<void()> function, std::span<const JobHandle> dependencies);
+
+			/**
+			 * @brief Schedule a job
+			 * @param function Function to run
+			 * @param dependencies Jobs that have to finish before this job runs
+			 * @return Handle to the new job
+			 */
+			JobHandle Schedule(std::function<void()> function, std::initializer_list<JobHandle> dependencies = {}) {
+				return Schedule(std::move(function), std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+			}
+
+			/**
+			 * @brief Schedule a long running job, that only idle worker threads run
+			 *
+			 * Background jobs are run in the order they were scheduled, and never by threads waiting for other jobs.
+			 * @param function Function to run
+			 * @return Handle to the new job
+			 */
+			JobHandle ScheduleBackground(std::function<void()> function);
+
+			/**
+			 * @brief Wait for a job to finish, running other jobs in the meantime
+			 *
+			 * Background jobs are not run while waiting, but a background job can be waited for.
+			 * @param job Job to wait for
+			 */
+			void Wait(const JobHandle& job);
+
+			/**
+			 * @brief Wait for several jobs to finish, running other jobs in the meantime
+			 * @param jobs Jobs to wait for
+			 */
+			void Wait(std::span<const JobHandle> jobs) { for (const JobHandle& job : jobs) Wait(job); }
+
+			/**
+			 * @brief Run function for every index in a range, split into jobs, and wait for all of them
+			 * @param count Number of indices
+			 * @param batchSize Number of indices per job
+			 * @param function Function taking the index to process
+			 */
+			template<typename Function> void ParallelFor(uint32_t count, uint32_t batchSize, Function&& function) {
+				if (batchSize == 0) batchSize = 1;
+				//Run small ranges directly
+				if (count <= batchSize || threads.empty()) {
+					for (uint32_t i = 0; i < count; i++) function(i);
+					return;
+				}
+				std::vector<JobHandle> batches;
+				batches.reserve((count + batchSize - 1) / batchSize);
+				for (uint32_t start = 0; start < count; start += batchSize) {
+					uint32_t end = std::min(start + batchSize, count);
+					batches.push_back(Schedule([&function, start, end] () { for (uint32_t i = start; i < end; i++) function(i); }));
+				}
+				Wait(batches);
+			}
+
+			/**
+			 * @brief Get number of worker threads
+			 * @return Worker count, not including threads waiting for jobs
+			 */
+			uint32_t GetWorkerCount() const { return threads.size(); }
+
+		private:
+			/** @brief Job queue of one thread */
+			struct Queue {
+				std::mutex mutex;						///< Protects the queue
+				std::deque<std::shared_ptr<Job>> jobs;	///< Jobs ready to run
+			};
+
+			/**
+			 * @brief Main loop of a worker thread
+			 * @param queue Index of the worker's queue
+			 */
+			void WorkerLoop(uint32_t queue);
+
+			/**
+			 * @brief Add job that is ready to run to the queue of the current thread
+			 * @param job Job to add
+			 */
+			void Enqueue(std::shared_ptr<Job> job);
+
+			/**
+			 * @brief Run one job, from the thread's own queue or taken from another queue
+			 * @param queue Index of the thread's queue
+			 * @return true if a job was run
+			 */
+			bool RunOne(uint32_t queue);
+
+			/**
+			 * @brief Run the oldest background job
+			 * @return true if a job was run
+			 */
+			bool RunBackground();
+
+			/**
+			 * @brief Mark job as done and schedule jobs that were waiting for it
+			 * @param job Finished job
+			 */
+			void Complete(Job& job);
+
+			std::vector<std::unique_ptr<Queue>> queues;	///< Job queues, the first is shared by threads outside the pool
+			Queue background;								///< Background jobs, only run by idle workers
+			std::vector<std::thread> threads;				///< Worker threads
+			std::mutex sleepMutex;							///< Protects sleeping workers
+			std::condition_variable wake;					///< Wakes sleeping workers
+			std::atomic<uint32_t> queued = 0;				///< Number of jobs in all queues
+			std::atomic<uint32_t> backgroundQueued = 0;		///< Number of background jobs waiting to run
+			std::atomic<bool> stopping = false;				///< Whether the workers should stop
+	};
+
+	/** Global job system instance */
+	extern JobSystem jobs;
+}
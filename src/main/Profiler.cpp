@@ -0,0 +1,99 @@
+#ifdef StevEngine_PROFILER
+#include "Profiler.hpp"
+#include "main/Log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace StevEngine {
+	Profiler profiler = Profiler();
+
+	/** @brief Monotonic clock in ns */
+	static uint64_t ClockNow() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	Profiler::Profiler() : origin(ClockNow()) {}
+
+	uint64_t Profiler::Now() const {
+		//Offset by one, so 0 can mark zones that are not recorded
+		return ClockNow() - origin + 1;
+	}
+
+	void Profiler::BeginCapture() {
+		{
+			std::lock_guard lock(buffersMutex);
+			for (std::shared_ptr<ThreadBuffer>& buffer : buffers) {
+				std::lock_guard bufferLock(buffer->mutex);
+				buffer->written = 0;
+			}
+		}
+		capturing.store(true, std::memory_order_relaxed);
+	}
+
+	void Profiler::EndCapture() {
+		capturing.store(false, std::memory_order_relaxed);
+	}
+
+	Profiler::ThreadBuffer& Profiler::GetBuffer() {
+		//Kept alive by the profiler after the thread exits, so its zones can still be saved
+		thread_local std::shared_ptr<ThreadBuffer> buffer;
+		if (!buffer) {
+			buffer = std::make_shared<ThreadBuffer>();
+			buffer->zones.resize(bufferSize);
+			std::lock_guard lock(buffersMutex);
+			buffer->thread = buffers.size();
+			buffers.push_back(buffer);
+		}
+		return *buffer;
+	}
+
+	uint64_t Profiler::BeginZone() {
+		if (!IsCapturing()) return 0;
+		GetBuffer().depth++;
+		return Now();
+	}
+
+	void Profiler::EndZone(const char* name, uint64_t start) {
+		uint64_t end = Now();
+		ThreadBuffer& buffer = GetBuffer();
+		buffer.depth--;
+		//Only locked by this thread, unless a capture is being saved
+		std::lock_guard lock(buffer.mutex);
+		buffer.zones[buffer.written % bufferSize] = { name, start, end, buffer.depth };
+		buffer.written++;
+	}
+
+	bool Profiler::SaveTrace(const std::string& path) {
+		std::ofstream file(path);
+		if (!file.is_open()) {
+			Log::Error("Failed to open profiler trace file " + path, true);
+			return false;
+		}
+		file << "{\"traceEvents\":[";
+		bool first = true;
+		char line[64];
+		std::lock_guard lock(buffersMutex);
+		for (std::shared_ptr<ThreadBuffer>& buffer : buffers) {
+			std::lock_guard bufferLock(buffer->mutex);
+			uint64_t count = std::min<uint64_t>(buffer->written, bufferSize);
+			for (uint64_t i = buffer->written - count; i < buffer->written; i++) {
+				const ProfileZone& zone = buffer->zones[i % bufferSize];
+				file << (first ? "\n" : ",\n") << "{\"name\":\"";
+				first = false;
+				for (const char* c = zone.name; *c; c++) {
+					if (*c == '"' || *c == '\\') file << '\\';
+					file << *c;
+				}
+				//Chrome traces use microseconds
+				std::snprintf(line, sizeof(line), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", zone.start / 1000.0, (zone.end - zone.start) / 1000.0);
+				file << line << ",\"pid\":0,\"tid\":" << buffer->thread << "}";
+			}
+		}
+		file << "\n]}\n";
+		return file.good();
+	}
+}
+#endif
@@ -0,0 +1,125 @@
+#pragma once
+#ifdef StevEngine_PROFILER
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace StevEngine {
+	/** @brief Timed section of code on one thread */
+	struct ProfileZone {
+		const char* name;	///< Zone name, must outlive the profiler
+		uint64_t start;		///< Start time in ns since the profiler was created
+		uint64_t end;		///< End time in ns since the profiler was created
+		uint32_t depth;		///< Number of zones this zone is nested in
+	};
+
+	/**
+	 * @brief Hierarchical CPU profiler
+	 *
+	 * Zones are recorded while a capture is running. Every thread writes finished zones to its own ring buffer,
+	 * which keeps the most recent zones when it fills up. Captures are saved in the Chrome trace format,
+	 * which can be opened in chrome://tracing or Perfetto.
+	 */
+	class Profiler {
+		public:
+			/** @brief Number of zones kept per thread */
+			static constexpr uint32_t bufferSize = 1 << 16;
+
+			Profiler();
+
+			/**
+			 * @brief Start recording zones, clearing earlier zones
+			 */
+			void BeginCapture();
+
+			/**
+			 * @brief Stop recording zones
+			 */
+			void EndCapture();
+
+			/**
+			 * @brief Check if zones are being recorded
+			 * @return true if capturing
+			 */
+			bool IsCapturing() const { return capturing.load(std::memory_order_relaxed); }
+
+			/**
+			 * @brief Save recorded zones of all threads as a Chrome trace
+			 * @param path Path of JSON file to write
+			 * @return true if the file was written
+			 */
+			bool SaveTrace(const std::string& path);
+
+			/**
+			 * @brief Get current time
+			 * @return Time in ns since the profiler was created
+			 */
+			uint64_t Now() const;
+
+			/**
+			 * @brief Mark start of a zone on the current thread
+			 * @return Start time, or 0 when not capturing
+			 */
+			uint64_t BeginZone();
+
+			/**
+			 * @brief Record a finished zone on the current thread
+			 * @param name Zone name
+			 * @param start Start time returned by BeginZone
+			 */
+			void EndZone(const char* name, uint64_t start);
+
+		private:
+			/** @brief Zones recorded by one thread */
+			struct ThreadBuffer {
+				uint32_t thread;					///< Index of thread, in order of first zone
+				uint32_t depth = 0;					///< Number of open zones
+				uint64_t written = 0;				///< Total zones written, the oldest are overwritten
+				std::mutex mutex;					///< Protects zones while saving
+				std::vector<ProfileZone> zones;		///< Ring buffer of finished zones
+			};
+
+			/**
+			 * @brief Get buffer of the current thread, creating it on first use
+			 * @return Thread buffer
+			 */
+			ThreadBuffer& GetBuffer();
+
+			std::atomic<bool> capturing = false;					///< Whether zones are recorded
+			const uint64_t origin;									///< Clock time the profiler was created at
+			std::mutex buffersMutex;								///< Protects the list of buffers
+			std::vector<std::shared_ptr<ThreadBuffer>> buffers;		///< Buffers of all threads that recorded zones
+	};
+
+	/** Global profiler instance */
+	extern Profiler profiler;
+
+	/**
+	 * @brief Records a zone from construction until the end of its scope
+	 */
+	class ProfileScope {
+		public:
+			/**
+			 * @brief Start zone
+			 * @param name Zone name, must outlive the profiler
+			 */
+			ProfileScope(const char* name) : name(name), start(profiler.BeginZone()) {}
+			~ProfileScope() { if (start != 0) profiler.EndZone(name, start); }
+			ProfileScope(const ProfileScope&) = delete;
+			ProfileScope& operator=(const ProfileScope&) = delete;
+		private:
+			const char* name;	///< Zone name
+			uint64_t start;		///< Zone start time, 0 if not recorded
+	};
+}
+
+#define StevEngine_PROFILE_JOIN2(a, b) a##b
+#define StevEngine_PROFILE_JOIN(a, b) StevEngine_PROFILE_JOIN2(a, b)
+/** @brief Profile the rest of the current scope as a named zone */
+#define StevEngine_PROFILE_ZONE(name) StevEngine::ProfileScope StevEngine_PROFILE_JOIN(profileZone, __LINE__)(name)
+#else
+#define StevEngine_PROFILE_ZONE(name)
+#endif
@@ -9,64 +9,125 @@ using namespace StevEngine::Utilities;
 
 namespace StevEngine {
 	ID Scene::CreateObject() {
-		ID id;
-		gameObjects.emplace(std::piecewise_construct, std::forward_as_tuple(id), std::forward_as_tuple(id, "GameObject", name)) ;
-		if(active) GetObject(id).Start();
-		return id;
+		return CreateObject("GameObject");
 	}
 	ID Scene::CreateObject(std::string name, Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale) {
 		ID id;
-		gameObjects.emplace(std::piecewise_construct, std::forward_as_tuple(id), std::forward_as_tuple(id, name, this->name)) ;
-		GameObject& object = GetObject(id);
-		object.position = position;
-		object.rotation = rotation;
-		object.scale = scale;
-		if(active) object.Start();
+		//Objects updated in parallel share the scene storage, so new objects are added once they are done
+		if(deferChanges) Defer([this, id, name, position, rotation, scale] () { InitObject(id, name, position, rotation, scale); });
+		else InitObject(id, name, position, rotation, scale);
 		return id;
 	}
 	Utilities::ID Scene::CreateObject(Resources::Resource file, Utilities::StreamType type) {
-		Utilities::Stream stream(type);
-		stream.ReadFromFile(file);
-		return CreateObject(stream);
+		if(!deferChanges) {
+			Utilities::Stream stream(type);
+			stream.ReadFromFile(file);
+			return CreateObject(stream);
+		}
+		//Only read the ID now, the stream is kept until the object is added
+		auto stream = std::make_shared<Utilities::Stream>(type);
+		stream->ReadFromFile(file);
+		Utilities::ID id;
+		*stream >> id;
+		Defer([this, id, stream] () { ImportObject(id, *stream); });
+		return id;
 	}
 	Utilities::ID Scene::CreateObject(Utilities::Stream& stream) {
+		if(deferChanges) {
+			Log::Error("Objects can not be created from a stream while objects are updated in parallel, use a resource file instead.");
+			return ID::empty;
+		}
 		Utilities::ID id;
 		stream >> id;
-		if(gameObjects.contains(id)) {
+		ImportObject(id, stream);
+		return id;
+	}
+	void Scene::InitObject(ID id, std::string name, Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale) {
+		GameObject& object = AddObject(id, name);
+		object.SetTransform(position, rotation, scale, false);
+		if(active) object.Start();
+	}
+	void Scene::ImportObject(ID id, Utilities::Stream& stream) {
+		if(objectIds.contains(id)) {
 			Log::Error(std::format("GameObject with id \"{}\" already exists.", id.GetString()));
-			return id;
+			return;
 		}
-		gameObjects.emplace(std::piecewise_construct, std::forward_as_tuple(id), std::forward_as_tuple(id, "GameObject", name)) ;
-		GameObject& object = GetObject(id);
+		GameObject& object = AddObject(id, "GameObject");
 		object.Import(stream);
 		if(active) object.Start();
-		return id;
 	}
 	bool Scene::Exists(Utilities::ID id) {
-		return gameObjects.contains(id);
+		return objectIds.contains(id);
+	}
+	bool Scene::Exists(ObjectHandle handle) {
+		return handle.index < slotCount && GetSlot(handle.index).generation == handle.generation;
 	}
 	GameObject& Scene::GetObject(Utilities::ID id) {
-		assert(gameObjects.contains(id) && "No GameObject found.");
-		return gameObjects.at(id);
+		assert(objectIds.contains(id) && "No GameObject found.");
+		return GetObject(objectIds.at(id));
+	}
+	ObjectHandle Scene::GetHandle(Utilities::ID id) {
+		auto handle = objectIds.find(id);
+		if(handle == objectIds.end()) return ObjectHandle();
+		return handle->second;
 	}
 	std::vector<ID> Scene::GetAllObjects() {
 		std::vector<ID> keys;
-		keys.reserve(gameObjects.size());
-		for(auto&[id, object] : gameObjects) {
-			keys.emplace_back(id);
-		}
+		keys.reserve(objectIds.size());
+		ForEachObject([&keys] (GameObject& object) { keys.emplace_back(object.Id()); });
 		return keys;
 	}
 	std::vector<ID> Scene::GetAllParentObjects() {
 		std::vector<ID> keys;
-		keys.reserve(gameObjects.size());
-		for(auto&[id, object] : gameObjects) {
-			if(object.parent.IsNull()) keys.emplace_back(id);
-		}
+		keys.reserve(objectIds.size());
+		ForEachParentObject([&keys] (GameObject& object) { keys.emplace_back(object.Id()); });
 		return keys;
 	}
 	void Scene::DestroyObject(ID id) {
-		destroyedObjects.insert(id);
+		DestroyObject(GetHandle(id));
+	}
+	void Scene::DestroyObject(ObjectHandle handle) {
+		if(!handle.IsValid()) return;
+		std::lock_guard lock(deferredMutex);
+		destroyedObjects.push_back(handle);
+	}
+	void Scene::Defer(std::function<void()> change) {
+		std::lock_guard lock(deferredMutex);
+		deferredChanges.push_back(std::move(change));
+	}
+	void Scene::ApplyDeferred() {
+		deferChanges = false;
+		//Changes can not be deferred again while applying, so the list does not grow
+		for(auto& change : deferredChanges) change();
+		deferredChanges.clear();
+	}
+	GameObject& Scene::AddObject(ID id, std::string name) {
+		//Get free slot, adding a new page when all pages are full
+		uint32_t index;
+		if(!freeSlots.empty()) {
+			index = freeSlots.back();
+			freeSlots.pop_back();
+		} else {
+			uint32_t capacity = firstPageSize * ((1u << objectPages.size()) - 1);
+			if(slotCount == capacity) objectPages.emplace_back(std::make_unique<ObjectSlot[]>(firstPageSize << objectPages.size()));
+			index = slotCount++;
+		}
+		//Create object
+		ObjectSlot& slot = GetSlot(index);
+		ObjectHandle handle = { index, slot.generation };
+		objectIds.emplace(id, handle);
+		return slot.object.emplace(id, name, *this, handle);
+	}
+	void Scene::RemoveObject(ObjectHandle handle) {
+		//Object might already be destroyed
+		if(!Exists(handle)) return;
+		ObjectSlot& slot = GetSlot(handle.index);
+		slot.object->Deactivate();
+		objectIds.erase(slot.object->Id());
+		//Invalidate handles before destroying, so the object can no longer be found while its children are destroyed
+		if(++slot.generation == 0) slot.generation = 1;
+		slot.object.reset();
+		freeSlots.push_back(handle.index);
 	}
 	Scene::Scene(std::string name) : name(name) {
 		//Create main camera
@@ -87,28 +148,28 @@ namespace StevEngine {
 	}
 	Utilities::Stream Scene::Export(Utilities::StreamType type) {
 		Utilities::Stream stream(type);
-		stream << name << (uint32_t)gameObjects.size();
-		for(const auto& [id, obj] : gameObjects) {
-			stream << obj.Export(type);
-		}
+		//Objects export their children, so only parent objects are written here
+		uint32_t parents = 0;
+		ForEachParentObject([&parents] (GameObject&) { parents++; });
+		stream << name << parents;
+		ForEachParentObject([&stream, type] (GameObject& object) { stream << object.Export(type); });
+		#ifdef StevEngine_SHOW_WINDOW
+		stream << activeCamera->GetParent().id;
+		#endif
 		return stream;
 	}
 	void Scene::Activate() {
 		active = true;
-		for(auto&[id, object] : gameObjects) {
-			object.Start();
-		}
+		ForEachObject([] (GameObject& object) { object.Start(); });
 	}
 	void Scene::Deactivate() {
 		active = false;
-		for(auto&[id, object] : gameObjects) {
-			object.Deactivate();
-		}
+		ForEachObject([] (GameObject& object) { object.Deactivate(); });
 	}
 	Scene::~Scene() {
-		for(Utilities::ID id : GetAllParentObjects()) {
-			GetObject(id).Deactivate();
-			gameObjects.erase(id);
+		//Children become parent objects when their parent is destroyed
+		while(!objectIds.empty()) {
+			ForEachParentObject([this] (GameObject& object) { RemoveObject(object.Handle()); });
 		}
 	}
 }
@@ -1,28 +1,41 @@
 #pragma once
 #include "main/ResourceManager.hpp"
 #include "main/GameObject.hpp"
+#include "main/TransformHierarchy.hpp"
 #include "physics/Layers.hpp"
 #include "utilities/Stream.hpp"
 #include "visuals/Camera.hpp"
 
-#include <map>
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 namespace StevEngine {
 	class Engine;
 	class SceneManager;
 	namespace Visuals { class Camera; };
+	namespace Renderer { class VisibilitySystem; };
 
 	/**
 	 * @brief Container for game objects and scene state
 	 *
 	 * Manages a collection of GameObjects and their relationships.
 	 * Handles object creation, destruction and lookup within the scene.
+	 *
+	 * Objects are stored in pages of slots and referenced through generational handles.
+	 * Object IDs are only resolved through a separate lookup, for serialization and networking.
 	 */
 	class Scene {
 		friend class Engine;
 		friend class SceneManager;
+		friend class GameObject;
+		friend class Renderer::VisibilitySystem;
 		public:
 			/** @brief Scene name/identifier */
 			const std::string name;
@@ -32,6 +45,8 @@ namespace StevEngine {
 
 			/**
 			 * @brief Create empty GameObject
+			 *
+			 * While objects are updated in parallel, objects are only added once the update is done, as with every CreateObject overload.
 			 * @return ID of created object
 			 */
 			Utilities::ID CreateObject();
@@ -55,8 +70,10 @@ namespace StevEngine {
 
 			/**
 			 * @brief Create GameObject from serialized data
+			 *
+			 * Fails while objects are updated in parallel, use the resource file overload instead.
 			 * @param stream Stream containing serialized object data
-			 * @return ID of created object
+			 * @return ID of created object, empty ID if it could not be created
 			 */
 			Utilities::ID CreateObject(Utilities::Stream& stream);
 
@@ -67,13 +84,37 @@ namespace StevEngine {
 			 */
 			bool Exists(Utilities::ID id);
 
+			/**
+			 * @brief Checks if the object a handle refers to still exists
+			 * @param handle Object handle
+			 * @return true if object exists, otherwise false
+			 */
+			bool Exists(ObjectHandle handle);
+
 			/**
 			 * @brief Get object by ID
 			 * @param id Object identifier
-			 * @return Pointer to object or nullptr if not found
+			 * @return Reference to object
 			 */
 			GameObject& GetObject(Utilities::ID id);
 
+			/**
+			 * @brief Get object by handle
+			 * @param handle Object handle
+			 * @return Reference to object
+			 */
+			GameObject& GetObject(ObjectHandle handle) {
+				assert(Exists(handle) && "No GameObject found.");
+				return *GetSlot(handle.index).object;
+			}
+
+			/**
+			 * @brief Get handle of object with ID
+			 * @param id Object identifier
+			 * @return Object handle, or an invalid handle if not found
+			 */
+			ObjectHandle GetHandle(Utilities::ID id);
+
 			#ifdef StevEngine_SHOW_WINDOW
 			/**
 			 * @brief Get main camera component
@@ -100,12 +141,44 @@ namespace StevEngine {
 			 */
 			std::vector<Utilities::ID> GetAllParentObjects();
 
+			/**
+			 * @brief Call function for every object in scene, without allocating
+			 *
+			 * Objects created by the function are not visited.
+			 * @param function Function taking a GameObject reference
+			 */
+			template<typename Function> void ForEachObject(Function&& function) {
+				for (uint32_t i = 0, count = slotCount; i < count; i++) {
+					ObjectSlot& slot = GetSlot(i);
+					if (slot.object) function(*slot.object);
+				}
+			}
+
+			/**
+			 * @brief Call function for every root object (no parent), without allocating
+			 *
+			 * Objects created by the function are not visited.
+			 * @param function Function taking a GameObject reference
+			 */
+			template<typename Function> void ForEachParentObject(Function&& function) {
+				for (uint32_t i = 0, count = slotCount; i < count; i++) {
+					ObjectSlot& slot = GetSlot(i);
+					if (slot.object && !slot.object->HasParent()) function(*slot.object);
+				}
+			}
+
 			/**
 			 * @brief Destroy object and all children
 			 * @param id ID of object to destroy
 			 */
 			void DestroyObject(Utilities::ID id);
 
+			/**
+			 * @brief Destroy object and all children
+			 * @param handle Handle of object to destroy
+			 */
+			void DestroyObject(ObjectHandle handle);
+
 			/**
 			 * @brief Export entire scene
 			 * @param type Type of stream to export to
@@ -147,9 +220,83 @@ namespace StevEngine {
 			Visuals::Camera* activeCamera;  ///< Main scene camera
 			#endif
 
-			/** @brief Map of all objects in scene */
-			std::map<Utilities::ID, GameObject, Utilities::ID> gameObjects;
-			std::unordered_set<Utilities::ID> destroyedObjects; ///< Objects that will be destroyed before the next update loop
+			/** @brief Single object slot */
+			struct ObjectSlot {
+				std::optional<GameObject> object;	///< Object in slot, empty if free
+				uint32_t generation = 1;			///< Incremented every time the slot is freed
+			};
+
+			/** @brief Number of slots in the first page, every following page is twice as large */
+			static constexpr uint32_t firstPageSize = 64;
+
+			/**
+			 * @brief Get slot at index
+			 * @param index Slot index
+			 * @return Reference to slot
+			 */
+			ObjectSlot& GetSlot(uint32_t index) {
+				uint32_t page = std::bit_width(index / firstPageSize + 1) - 1;
+				return objectPages[page][index - firstPageSize * ((1u << page) - 1)];
+			}
+
+			/**
+			 * @brief Create object in a free slot
+			 * @param id Object identifier
+			 * @param name Object name
+			 * @return Reference to new object
+			 */
+			GameObject& AddObject(Utilities::ID id, std::string name);
+
+			/**
+			 * @brief Deactivate and destroy object, and free its slot
+			 * @param handle Handle of object to remove
+			 */
+			void RemoveObject(ObjectHandle handle);
+
+			/**
+			 * @brief Create object with transform under an existing ID
+			 * @param id Object identifier
+			 * @param name Object name
+			 * @param position Initial position
+			 * @param rotation Initial rotation
+			 * @param scale Initial scale
+			 */
+			void InitObject(Utilities::ID id, std::string name, Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale);
+
+			/**
+			 * @brief Create object from serialized data under an already read ID
+			 * @param id Object identifier
+			 * @param stream Stream containing the rest of the serialized object data
+			 */
+			void ImportObject(Utilities::ID id, Utilities::Stream& stream);
+
+			/**
+			 * @brief Defer structural changes until ApplyDeferred, used while objects are updated in parallel
+			 */
+			void BeginDeferring() { deferChanges = true; }
+
+			/**
+			 * @brief Stop deferring and apply deferred changes in the order they were made
+			 */
+			void ApplyDeferred();
+
+			/**
+			 * @brief Queue change to be made by ApplyDeferred
+			 * @param change Function making the change
+			 */
+			void Defer(std::function<void()> change);
+
+			/** @brief Transforms of all objects in scene, must outlive the objects */
+			TransformHierarchy transforms;
+			std::vector<ObjectHandle> destroyedObjects; ///< Objects that will be destroyed before the next update loop
+			bool deferChanges = false;								///< Whether structural changes are deferred
+			std::vector<std::function<void()>> deferredChanges;		///< Changes made while objects were updated in parallel
+			std::mutex deferredMutex;								///< Protects the deferred changes and destroyed objects
+			std::unordered_map<Utilities::ID, ObjectHandle> objectIds;	///< Handle of every object ID, for serialization and networking
+			std::vector<uint32_t> freeSlots;	///< Indices of reusable slots
+			uint32_t slotCount = 0;				///< Number of slots in use or free
+			/** @brief Pages of object slots, objects never move once created */
+			std::vector<std::unique_ptr<ObjectSlot[]>> objectPages;
 
 			//Physics layers
 			#ifdef StevEngine_PHYSICS
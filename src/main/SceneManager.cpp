@@ -1,7 +1,11 @@
 #include "SceneManager.hpp"
 #include "main/Engine.hpp"
 #include "main/EngineEvents.hpp"
+#include "main/Profiler.hpp"
 #include "utilities/Stream.hpp"
+#ifdef StevEngine_RENDERER_GL
+#include "visuals/renderer/RenderSystem.hpp"
+#endif
 #include <cassert>
 
 namespace StevEngine {
@@ -38,13 +42,16 @@ namespace StevEngine {
 		events.Subscribe<PreUpdateEvent>([this] (PreUpdateEvent) {
 			// Destroy objects marked for destruction
 			Scene& scene = GetActiveScene();
-			for(const auto& id : scene.destroyedObjects) {
-				scene.GetObject(id).Deactivate();
-				scene.gameObjects.erase(id);
+			//Destroyed objects mark their children for destruction, so the list can grow while looping
+			for(size_t i = 0; i < scene.destroyedObjects.size(); i++) {
+				scene.RemoveObject(scene.destroyedObjects[i]);
 			}
 			scene.destroyedObjects.clear();
 		});
 		events.Subscribe<UpdateEvent>([this] (UpdateEvent e) { this->Update(e.deltaTime); });
+		events.Subscribe<FixedUpdateEvent>([this] (const FixedUpdateEvent& e) {
+			GetActiveScene().ForEachObject([&e] (GameObject& object) { object.FixedUpdate(e.deltaTime); });
+		});
 		#ifdef StevEngine_SHOW_WINDOW
 		events.Subscribe<EngineDrawEvent>([this] (EngineDrawEvent) { this->Draw(); });
 		#endif
@@ -54,18 +61,50 @@ namespace StevEngine {
 	}
 
 	void SceneManager::Update(double deltaTime) {
+		StevEngine_PROFILE_ZONE("SceneManager::Update");
 		Scene& scene = GetActiveScene();
-		for (Utilities::ID id : scene.GetAllParentObjects()) {
-			scene.GetObject(id).Update(deltaTime);
+		if (parallelUpdate && jobs.GetWorkerCount() > 0) {
+			//Children share transforms with their parent, so each root object and its children stay on one thread
+			scene.BeginDeferring();
+			scene.ForEachParentObject([this, deltaTime] (GameObject& object) {
+				updateJobs.push_back(jobs.Schedule([&object, deltaTime] () { UpdateTree(object, deltaTime); }));
+			});
+			jobs.Wait(updateJobs);
+			updateJobs.clear();
+			//Add the objects created by the jobs
+			scene.ApplyDeferred();
+		}
+		else scene.ForEachObject([deltaTime] (GameObject& object) { object.Update(deltaTime); });
+		{
+			//Batch systems can move objects of any tree, so they run after the object jobs on this thread
+			StevEngine_PROFILE_ZONE("ComponentRegistry::UpdateSystems");
+			ComponentRegistry::UpdateSystems(deltaTime);
 		}
+		//Recalculate changed world transforms once per frame
+		StevEngine_PROFILE_ZONE("TransformHierarchy::Update");
+		scene.transforms.Update();
+	}
+	void SceneManager::UpdateTree(GameObject& object, double deltaTime) {
+		StevEngine_PROFILE_ZONE("SceneManager::UpdateTree");
+		object.Update(deltaTime);
+		for (uint32_t i = 0; i < object.GetChildCount(); i++) UpdateTree(object.GetChild(i), deltaTime);
 	}
 	#ifdef StevEngine_SHOW_WINDOW
 	void SceneManager::Draw() {
+		StevEngine_PROFILE_ZONE("SceneManager::Draw");
 		Scene& scene = sceneManager.GetActiveScene();
+		#ifdef StevEngine_RENDERER_GL
+		//Follow moved objects even without a camera, so the changed transforms do not pile up
+		Renderer::VisibilitySystem& visibility = Renderer::render.GetVisibility();
+		visibility.Update(scene.transforms);
+		#endif
 		if (scene.activeCamera == nullptr) return;
-		for (Utilities::ID id : scene.GetAllParentObjects()) {
-			scene.GetObject(id).Draw(Utilities::Matrix4::identity);
-		}
+		scene.ForEachObject([] (GameObject& object) { object.Draw(); });
+		ComponentRegistry::DrawSystems();
+		#ifdef StevEngine_RENDERER_GL
+		//Submit the render components in view
+		visibility.Draw(*scene.activeCamera);
+		#endif
 	}
 	#endif
 
@@ -1,9 +1,11 @@
 #pragma once
 #include "Scene.hpp"
 #include "main/ResourceManager.hpp"
+#include "main/JobSystem.hpp"
 #include "utilities/Stream.hpp"
 
 #include <string>
+#include <vector>
 
 namespace StevEngine {
 	/**
@@ -66,6 +68,22 @@ namespace StevEngine {
 			 * Sets first scene as active if none active.
 			 */
 			void ActivateDefault();
+
+			/**
+			 * @brief Set whether objects are updated in parallel
+			 *
+			 * Every root object is updated together with its children as one job on the job system,
+			 * and batch update systems then run on the calling thread.
+			 * Jobs can add and remove components, and create and destroy objects, but the changes that reach shared systems wait until all jobs are done:
+			 * added components are started and removed components are destroyed then, in the order the changes were made,
+			 * and created objects are only added then, so they can not be looked up in the same update.
+			 * Objects can not be created from a stream during the update.
+			 * World transforms are recalculated lazily from the parent down, so a job must only read transforms of its own root object and its children,
+			 * must not change parents, and must not read component instance lists of the ComponentRegistry.
+			 * Anything else the update code shares between objects has to be thread safe.
+			 * @param parallel Whether to update objects in parallel
+			 */
+			void SetParallelUpdate(bool parallel) { parallelUpdate = parallel; }
 		private:
 			/**
 			 * @brief Update active scene
@@ -73,6 +91,13 @@ namespace StevEngine {
 			 */
 			void Update(double deltaTime);
 
+			/**
+			 * @brief Update object and all its children
+			 * @param object Object to update
+			 * @param deltaTime Time since last update
+			 */
+			static void UpdateTree(GameObject& object, double deltaTime);
+
 			#ifdef StevEngine_SHOW_WINDOW
 			/**
 			 * @brief Draw active scene
@@ -82,6 +107,8 @@ namespace StevEngine {
 
 			std::unordered_map<std::string, Scene> scenes;  ///< Map of all loaded scenes
 			std::string active;				   ///< Name of active scene
+			bool parallelUpdate = false;		   ///< Whether objects are updated on the job system
+			std::vector<JobHandle> updateJobs;	   ///< Jobs of the current parallel update
 	};
 
 	/** Global scene manager instance */
@@ -0,0 +1,244 @@
+#include "TransformHierarchy.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+using namespace StevEngine::Utilities;
+
+namespace StevEngine {
+	uint32_t TransformHierarchy::Create() {
+		//Get handle
+		uint32_t handle;
+		if (!freeHandles.empty()) {
+			handle = freeHandles.back();
+			freeHandles.pop_back();
+		} else {
+			handle = dense.size();
+			dense.push_back(none);
+		}
+		//Add transform at the end, as a root it can never come before its parent
+		dense[handle] = handles.size();
+		localPosition.emplace_back();
+		localRotation.emplace_back();
+		localScale.emplace_back(1, 1, 1);
+		worldPosition.emplace_back();
+		worldRotation.emplace_back();
+		worldScale.emplace_back(1, 1, 1);
+		worldMatrix.push_back(Matrix4::identity);
+		parent.push_back(none);
+		firstChild.push_back(none);
+		nextSibling.push_back(none);
+		dirty.push_back(false);
+		moved.push_back(false);
+		isChanged.push_back(false);
+		alive.push_back(true);
+		handles.push_back(handle);
+		return handle;
+	}
+
+	void TransformHierarchy::Destroy(uint32_t handle) {
+		uint32_t index = dense[handle];
+		Unlink(index);
+		//Children become root transforms
+		uint32_t child = firstChild[index];
+		while (child != none) {
+			uint32_t next = nextSibling[child];
+			parent[child] = none;
+			nextSibling[child] = none;
+			MarkDirty(child);
+			child = next;
+		}
+		firstChild[index] = none;
+		//Leave empty slot until next reorder
+		alive[index] = false;
+		dirty[index] = false;
+		moved[index] = false;
+		isChanged[index] = false;
+		dense[handle] = none;
+		freeHandles.push_back(handle);
+		destroyed++;
+	}
+
+	void TransformHierarchy::SetParent(uint32_t handle, uint32_t parentHandle) {
+		uint32_t index = dense[handle];
+		uint32_t newParent = (parentHandle == none ? none : dense[parentHandle]);
+		if (parent[index] == newParent) return;
+		Unlink(index);
+		if (newParent != none) {
+			parent[index] = newParent;
+			nextSibling[index] = firstChild[newParent];
+			firstChild[newParent] = index;
+			if (newParent > index) unordered = true;
+		}
+		MarkDirty(index);
+	}
+
+	void TransformHierarchy::SetPosition(uint32_t handle, const Vector3& position) {
+		uint32_t index = dense[handle];
+		localPosition[index] = position;
+		MarkDirty(index);
+	}
+	void TransformHierarchy::SetRotation(uint32_t handle, const Quaternion& rotation) {
+		uint32_t index = dense[handle];
+		localRotation[index] = rotation;
+		MarkDirty(index);
+	}
+	void TransformHierarchy::SetScale(uint32_t handle, const Vector3& scale) {
+		uint32_t index = dense[handle];
+		localScale[index] = scale;
+		MarkDirty(index);
+	}
+
+	const Vector3& TransformHierarchy::GetWorldPosition(uint32_t handle) {
+		uint32_t index = dense[handle];
+		if (dirty[index]) Recalculate(index);
+		return worldPosition[index];
+	}
+	const Quaternion& TransformHierarchy::GetWorldRotation(uint32_t handle) {
+		uint32_t index = dense[handle];
+		if (dirty[index]) Recalculate(index);
+		return worldRotation[index];
+	}
+	const Vector3& TransformHierarchy::GetWorldScale(uint32_t handle) {
+		uint32_t index = dense[handle];
+		if (dirty[index]) Recalculate(index);
+		return worldScale[index];
+	}
+	const Matrix4& TransformHierarchy::GetWorldMatrix(uint32_t handle) {
+		uint32_t index = dense[handle];
+		if (dirty[index]) Recalculate(index);
+		return worldMatrix[index];
+	}
+
+	void TransformHierarchy::Update() {
+		if (unordered || destroyed * 4 > handles.size()) Reorder();
+		//Parents always come before their children, so they are up to date when reached
+		for (uint32_t index = 0; index < handles.size(); index++) {
+			if (dirty[index]) CalculateWorld(index);
+			//Changes are only collected here, as world transforms can also be recalculated on other threads while read
+			if (!moved[index]) continue;
+			moved[index] = false;
+			if (!isChanged[index]) {
+				isChanged[index] = true;
+				changed.push_back(handles[index]);
+			}
+		}
+	}
+
+	void TransformHierarchy::SetTrackChanges(bool track) {
+		if (trackChanges == track) return;
+		trackChanges = track;
+		if (track) return;
+		std::fill(moved.begin(), moved.end(), false);
+		ClearChanged();
+	}
+
+	void TransformHierarchy::ClearChanged() {
+		for (uint32_t handle : changed) {
+			if (Exists(handle)) isChanged[dense[handle]] = false;
+		}
+		changed.clear();
+	}
+
+	void TransformHierarchy::MarkDirty(uint32_t index) {
+		//Children of a dirty transform are always dirty as well
+		if (trackChanges) moved[index] = true;
+		if (dirty[index]) return;
+		dirty[index] = true;
+		for (uint32_t child = firstChild[index]; child != none; child = nextSibling[child]) {
+			MarkDirty(child);
+		}
+	}
+
+	void TransformHierarchy::Recalculate(uint32_t index) {
+		uint32_t p = parent[index];
+		if (p != none && dirty[p]) Recalculate(p);
+		CalculateWorld(index);
+	}
+
+	void TransformHierarchy::CalculateWorld(uint32_t index) {
+		Matrix4 local = Matrix4::FromTranslationRotationScale(localPosition[index], localRotation[index], localScale[index]);
+		uint32_t p = parent[index];
+		if (p == none) {
+			worldPosition[index] = localPosition[index];
+			worldRotation[index] = localRotation[index];
+			worldScale[index] = localScale[index];
+			worldMatrix[index] = local;
+		} else {
+			worldPosition[index] = worldMatrix[p] * localPosition[index];
+			worldRotation[index] = worldRotation[p] * localRotation[index];
+			worldScale[index] = Vector3::CombineScale(worldScale[p], localScale[index]);
+			worldMatrix[index] = worldMatrix[p] * local;
+		}
+		dirty[index] = false;
+	}
+
+	void TransformHierarchy::Unlink(uint32_t index) {
+		uint32_t p = parent[index];
+		if (p == none) return;
+		if (firstChild[p] == index) firstChild[p] = nextSibling[index];
+		else {
+			uint32_t child = firstChild[p];
+			while (nextSibling[child] != index) child = nextSibling[child];
+			nextSibling[child] = nextSibling[index];
+		}
+		parent[index] = none;
+		nextSibling[index] = none;
+	}
+
+	void TransformHierarchy::Reorder() {
+		//Breadth first from the roots gives the transforms sorted by depth
+		std::vector<uint32_t> order;
+		order.reserve(handles.size() - destroyed);
+		for (uint32_t index = 0; index < handles.size(); index++) {
+			if (alive[index] && parent[index] == none) order.push_back(index);
+		}
+		for (size_t i = 0; i < order.size(); i++) {
+			for (uint32_t child = firstChild[order[i]]; child != none; child = nextSibling[child]) {
+				order.push_back(child);
+			}
+		}
+		//New index of every old index
+		std::vector<uint32_t> newIndex(handles.size(), none);
+		for (uint32_t i = 0; i < order.size(); i++) newIndex[order[i]] = i;
+		//Keep transforms that are not reachable from a root (parent cycles)
+		for (uint32_t index = 0; index < handles.size(); index++) {
+			if (alive[index] && newIndex[index] == none) {
+				newIndex[index] = order.size();
+				order.push_back(index);
+			}
+		}
+		//Move all values to their new index
+		auto permute = [&order](auto& values) {
+			std::remove_reference_t<decltype(values)> sorted;
+			sorted.reserve(order.size());
+			for (uint32_t index : order) sorted.push_back(values[index]);
+			values.swap(sorted);
+		};
+		permute(localPosition);
+		permute(localRotation);
+		permute(localScale);
+		permute(worldPosition);
+		permute(worldRotation);
+		permute(worldScale);
+		permute(worldMatrix);
+		permute(parent);
+		permute(firstChild);
+		permute(nextSibling);
+		permute(dirty);
+		permute(moved);
+		permute(isChanged);
+		permute(alive);
+		permute(handles);
+		//Update references to indices
+		auto remap = [&newIndex](uint32_t index) { return (index == none ? none : newIndex[index]); };
+		for (uint32_t index = 0; index < handles.size(); index++) {
+			parent[index] = remap(parent[index]);
+			firstChild[index] = remap(firstChild[index]);
+			nextSibling[index] = remap(nextSibling[index]);
+			dense[handles[index]] = index;
+		}
+		destroyed = 0;
+		unordered = false;
+	}
+}
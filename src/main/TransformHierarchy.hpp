@@ -0,0 +1,212 @@
+#pragma once
+#include "utilities/Vector3.hpp"
+#include "utilities/Quaternion.hpp"
+#include "utilities/Matrix4.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace StevEngine {
+	/**
+	 * @brief Transform storage for all objects in a scene
+	 *
+	 * Local and world transforms are stored in separate arrays, ordered by hierarchy depth so
+	 * parents always come before their children. World transforms are cached and marked dirty
+	 * when the object or one of its parents changes, and are recalculated either when read or
+	 * in a single linear pass through Update.
+	 *
+	 * Transforms are referenced through stable handles, which stay valid when the arrays are reordered.
+	 * When enabled, handles of transforms that moved are collected by Update, so systems can follow moving objects without checking every object.
+	 */
+	class TransformHierarchy {
+		public:
+			/** @brief Handle or index value used for no transform */
+			static constexpr uint32_t none = UINT32_MAX;
+
+			/**
+			 * @brief Create new root transform with identity values
+			 * @return Handle to the new transform
+			 */
+			uint32_t Create();
+
+			/**
+			 * @brief Destroy transform, children of it become root transforms
+			 * @param handle Transform to destroy
+			 */
+			void Destroy(uint32_t handle);
+
+			/**
+			 * @brief Set parent of a transform
+			 * @param handle Transform to change parent of
+			 * @param parent New parent transform, or none to make it a root transform
+			 */
+			void SetParent(uint32_t handle, uint32_t parent);
+
+			/**
+			 * @brief Get local position
+			 * @param handle Transform handle
+			 * @return Local position
+			 */
+			const Utilities::Vector3& GetPosition(uint32_t handle) const { return localPosition[dense[handle]]; }
+
+			/**
+			 * @brief Get local rotation
+			 * @param handle Transform handle
+			 * @return Local rotation
+			 */
+			const Utilities::Quaternion& GetRotation(uint32_t handle) const { return localRotation[dense[handle]]; }
+
+			/**
+			 * @brief Get local scale
+			 * @param handle Transform handle
+			 * @return Local scale
+			 */
+			const Utilities::Vector3& GetScale(uint32_t handle) const { return localScale[dense[handle]]; }
+
+			/**
+			 * @brief Set local position
+			 * @param handle Transform handle
+			 * @param position New local position
+			 */
+			void SetPosition(uint32_t handle, const Utilities::Vector3& position);
+
+			/**
+			 * @brief Set local rotation
+			 * @param handle Transform handle
+			 * @param rotation New local rotation
+			 */
+			void SetRotation(uint32_t handle, const Utilities::Quaternion& rotation);
+
+			/**
+			 * @brief Set local scale
+			 * @param handle Transform handle
+			 * @param scale New local scale
+			 */
+			void SetScale(uint32_t handle, const Utilities::Vector3& scale);
+
+			/**
+			 * @brief Get world position, recalculating it if dirty
+			 * @param handle Transform handle
+			 * @return World position
+			 */
+			const Utilities::Vector3& GetWorldPosition(uint32_t handle);
+
+			/**
+			 * @brief Get world rotation, recalculating it if dirty
+			 * @param handle Transform handle
+			 * @return World rotation
+			 */
+			const Utilities::Quaternion& GetWorldRotation(uint32_t handle);
+
+			/**
+			 * @brief Get world scale, recalculating it if dirty
+			 * @param handle Transform handle
+			 * @return World scale
+			 */
+			const Utilities::Vector3& GetWorldScale(uint32_t handle);
+
+			/**
+			 * @brief Get world transformation matrix, recalculating it if dirty
+			 * @param handle Transform handle
+			 * @return World matrix
+			 */
+			const Utilities::Matrix4& GetWorldMatrix(uint32_t handle);
+
+			/**
+			 * @brief Recalculate all dirty world transforms
+			 *
+			 * Restores the depth order if the hierarchy has changed, and then updates every
+			 * dirty transform in one pass from the roots and down.
+			 */
+			void Update();
+
+			/**
+			 * @brief Set whether Update collects the transforms that moved
+			 *
+			 * Only enable while a system reads and clears the changed transforms, otherwise the list keeps growing.
+			 * @param track Whether to collect changed transforms
+			 */
+			void SetTrackChanges(bool track);
+
+			/**
+			 * @brief Check if Update collects the transforms that moved
+			 * @return true if collecting, otherwise false
+			 */
+			bool IsTrackingChanges() const { return trackChanges; }
+
+			/**
+			 * @brief Get transforms whose world transform changed before an Update since the last ClearChanged
+			 *
+			 * Transforms are only added by Update, not when recalculated while read.
+			 * May contain handles of transforms destroyed since, which should be checked with Exists.
+			 * @return Handles of changed transforms
+			 */
+			const std::vector<uint32_t>& GetChanged() const { return changed; }
+
+			/** @brief Clear the list of changed transforms */
+			void ClearChanged();
+
+			/**
+			 * @brief Check if a handle refers to a transform that has not been destroyed
+			 * @param handle Transform handle
+			 * @return true if the transform exists
+			 */
+			bool Exists(uint32_t handle) const { return handle < dense.size() && dense[handle] != none; }
+
+		private:
+			/**
+			 * @brief Mark transform and all its children as dirty
+			 * @param index Index of transform
+			 */
+			void MarkDirty(uint32_t index);
+
+			/**
+			 * @brief Recalculate world transform, and dirty parents first
+			 * @param index Index of transform
+			 */
+			void Recalculate(uint32_t index);
+
+			/**
+			 * @brief Calculate world transform from an up to date parent
+			 * @param index Index of transform
+			 */
+			void CalculateWorld(uint32_t index);
+
+			/**
+			 * @brief Remove child from the child list of its parent
+			 * @param index Index of child transform
+			 */
+			void Unlink(uint32_t index);
+
+			/**
+			 * @brief Sort transforms by hierarchy depth and remove destroyed transforms
+			 */
+			void Reorder();
+
+			//Local transforms
+			std::vector<Utilities::Vector3> localPosition;		///< Local positions
+			std::vector<Utilities::Quaternion> localRotation;	///< Local rotations
+			std::vector<Utilities::Vector3> localScale;			///< Local scales
+			//World transforms
+			std::vector<Utilities::Vector3> worldPosition;		///< Cached world positions
+			std::vector<Utilities::Quaternion> worldRotation;	///< Cached world rotations
+			std::vector<Utilities::Vector3> worldScale;			///< Cached world scales
+			std::vector<Utilities::Matrix4> worldMatrix;		///< Cached world matrices
+			//Hierarchy
+			std::vector<uint32_t> parent;		///< Index of parent transform
+			std::vector<uint32_t> firstChild;	///< Index of first child transform
+			std::vector<uint32_t> nextSibling;	///< Index of next transform with the same parent
+			std::vector<uint8_t> dirty;			///< Whether the world transform needs recalculating
+			std::vector<uint8_t> moved;			///< Whether the transform changed since the last Update, while tracking changes
+			std::vector<uint8_t> isChanged;		///< Whether the transform is in the changed list
+			std::vector<uint8_t> alive;			///< Whether the transform is in use
+			std::vector<uint32_t> handles;		///< Handle of the transform at each index
+			//Handles
+			std::vector<uint32_t> dense;		///< Index of the transform for each handle
+			std::vector<uint32_t> freeHandles;	///< Handles of destroyed transforms
+			std::vector<uint32_t> changed;		///< Handles of transforms recalculated since the last ClearChanged
+			uint32_t destroyed = 0;				///< Number of destroyed transforms still in the arrays
+			bool trackChanges = false;			///< Whether Update collects changed transforms
+			bool unordered = false;				///< Whether a child has been placed before its parent
+	};
+}
@@ -3,6 +3,7 @@
 #include "main/Engine.hpp"
 #include "main/EngineEvents.hpp"
 #include "main/Log.hpp"
+#include "main/Profiler.hpp"
 #include "networking.hpp"
 #include "utilities/Stream.hpp"
 
@@ -26,6 +27,7 @@ namespace StevEngine::Networking::Client {
 
 		//Setup listeners
 		engine->GetEvents().Subscribe<PreUpdateEvent>([this](const PreUpdateEvent& e) {
+			StevEngine_PROFILE_ZONE("Networking::Client::Receive");
 			//Read all new messages from TCP server
 			while (true) {
 				FD_ZERO(&readfds);
@@ -3,6 +3,7 @@
 #include "main/Engine.hpp"
 #include "main/EngineEvents.hpp"
 #include "main/Log.hpp"
+#include "main/Profiler.hpp"
 #include "networking.hpp"
 #include "utilities/ID.hpp"
 #include "utilities/Stream.hpp"
@@ -38,6 +39,7 @@ namespace StevEngine::Networking::Server {
 		Log::Debug("Started socket server");
 		//Update method
 		engine->GetEvents().Subscribe<PreUpdateEvent>([this](const PreUpdateEvent& e) {
+			StevEngine_PROFILE_ZONE("Networking::Server::Receive");
 			//Disconnect the clients marked for disconnection
 			for (auto& client : disconnected) {
 				Log::Debug(std::string("Client (") + client.id.GetString() + ") disconnected!", true);
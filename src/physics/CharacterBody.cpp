@@ -135,8 +135,8 @@ namespace StevEngine::Physics {
 			GameObject& parent = GetParent();
 			if(e.rotation) jphCharacter->SetRotation(parent.GetWorldRotation());
 			if(e.position) jphCharacter->SetPosition(parent.GetWorldPosition());
-		}), TransformUpdateEvent::GetStaticEventType());
-		handlers.emplace_back(parent.Subscribe<ColliderUpdateEvent>([this](const ColliderUpdateEvent& e) { RefreshShape(); }), ColliderUpdateEvent::GetStaticEventType());
+		}));
+		handlers.emplace_back(parent.Subscribe<ColliderUpdateEvent>([this](const ColliderUpdateEvent& e) { RefreshShape(); }));
 	}
 
 	void CharacterBody::Deactivate() {
@@ -41,7 +41,7 @@ namespace StevEngine::Physics {
 		Utilities::Vector3 abs = parent.GetWorldScale();
 		if(rawShape) this->shape = new JPH::ScaledShape(rawShape, Utilities::Vector3(scale.X * abs.X, scale.Y * abs.Y, scale.Z * abs.Z));
 		//Events
-		handlers.emplace_back(parent.Subscribe<TransformUpdateEvent>([this] (TransformUpdateEvent e) { this->TransformUpdate(e.position, e.rotation, e.scale);}), TransformUpdateEvent::GetStaticEventType());
+		handlers.emplace_back(parent.Subscribe<TransformUpdateEvent>([this] (TransformUpdateEvent e) { this->TransformUpdate(e.position, e.rotation, e.scale);}));
 	}
 	void Collider::Deactivate()	{
 		if(shape) shape->Release();
@@ -105,7 +105,7 @@ namespace StevEngine::Physics {
 		JPH::StaticCompoundShapeSettings shapeSettings = JPH::StaticCompoundShapeSettings();
 		if(convex) {
 			//Create as ConvexHullShape
-			for(Utilities::Mesh mesh : model.GetMeshes()) {
+			for(const Utilities::Mesh& mesh : model.GetMeshes()) {
 				JPH::Array<JPH::Vec3> vertices;
 				vertices.reserve(mesh.indices.size());
 				for(int i = 0; i < mesh.indices.size(); i++) {
@@ -124,7 +124,7 @@ namespace StevEngine::Physics {
 			}
 		} else {
 			//Create as mesh
-			for(Utilities::Mesh mesh : model.GetMeshes()) {
+			for(const Utilities::Mesh& mesh : model.GetMeshes()) {
 				JPH::VertexList vertices;
 				vertices.reserve(mesh.vertices.size());
 				std::transform(mesh.vertices.begin(), mesh.vertices.end(), vertices.begin(), [](Utilities::Vertex v) { return JPH::Float3(v.position.X, v.position.Y, v.position.Z); });
@@ -0,0 +1,46 @@
+#ifdef StevEngine_PHYSICS
+#include "JobSystemAdapter.hpp"
+#include "main/JobSystem.hpp"
+
+#include <thread>
+
+namespace StevEngine::Physics {
+	void JobSystemAdapter::Init(JPH::uint maxJobs, JPH::uint maxBarriers) {
+		JobSystemWithBarrier::Init(maxBarriers);
+		jobStorage.Init(maxJobs, maxJobs);
+	}
+
+	int JobSystemAdapter::GetMaxConcurrency() const {
+		return jobs.GetWorkerCount() + 1;
+	}
+
+	JPH::JobHandle JobSystemAdapter::CreateJob(const char* name, JPH::ColorArg color, const JobFunction& function, JPH::uint32 numDependencies) {
+		//Wait for a free job if all are in use
+		JPH::uint32 index;
+		while ((index = jobStorage.ConstructObject(name, color, this, function, numDependencies)) == decltype(jobStorage)::cInvalidObjectIndex) {
+			std::this_thread::yield();
+		}
+		Job* job = &jobStorage.Get(index);
+		JobHandle handle(job);
+		if (numDependencies == 0) QueueJob(job);
+		return handle;
+	}
+
+	void JobSystemAdapter::QueueJob(Job* job) {
+		//Keep job alive until it has run
+		job->AddRef();
+		jobs.Schedule([job] () {
+			job->Execute();
+			job->Release();
+		});
+	}
+
+	void JobSystemAdapter::QueueJobs(Job** jobList, JPH::uint numJobs) {
+		for (JPH::uint i = 0; i < numJobs; i++) QueueJob(jobList[i]);
+	}
+
+	void JobSystemAdapter::FreeJob(Job* job) {
+		jobStorage.DestructObject(job);
+	}
+}
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#ifdef StevEngine_PHYSICS
+#include "Jolt.h"
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+
+namespace StevEngine::Physics {
+	/**
+	 * @brief Runs Jolt jobs on the engine job system
+	 *
+	 * Lets the physics simulation share worker threads with the rest of the engine,
+	 * instead of Jolt starting a thread pool of its own.
+	 */
+	class JobSystemAdapter final : public JPH::JobSystemWithBarrier {
+		public:
+			/**
+			 * @brief Initialize job storage
+			 * @param maxJobs Maximum number of jobs that can exist at once
+			 * @param maxBarriers Maximum number of barriers that can exist at once
+			 */
+			void Init(JPH::uint maxJobs, JPH::uint maxBarriers);
+
+			/**
+			 * @brief Get number of threads that can run jobs at once
+			 * @return Worker threads plus the waiting thread
+			 */
+			int GetMaxConcurrency() const override;
+
+			/**
+			 * @brief Create job, queueing it once it has no dependencies left
+			 * @param name Name of job
+			 * @param color Color of job in the Jolt profiler
+			 * @param function Function to run
+			 * @param numDependencies Number of jobs that have to finish first
+			 * @return Handle to job
+			 */
+			JobHandle CreateJob(const char* name, JPH::ColorArg color, const JobFunction& function, JPH::uint32 numDependencies = 0) override;
+
+		protected:
+			/**
+			 * @brief Schedule job on the engine job system
+			 * @param job Job to schedule
+			 */
+			void QueueJob(Job* job) override;
+
+			/**
+			 * @brief Schedule several jobs on the engine job system
+			 * @param jobs Jobs to schedule
+			 * @param numJobs Number of jobs
+			 */
+			void QueueJobs(Job** jobs, JPH::uint numJobs) override;
+
+			/**
+			 * @brief Return finished job to job storage
+			 * @param job Job to free
+			 */
+			void FreeJob(Job* job) override;
+
+		private:
+			JPH::FixedSizeFreeList<Job> jobStorage;  ///< Storage of all jobs
+	};
+}
+#endif
@@ -1,7 +1,9 @@
 #ifdef StevEngine_PHYSICS
 #include "PhysicsSystem.hpp"
+#include "main/ComponentRegistry.hpp"
 #include "main/Engine.hpp"
 #include "main/EngineEvents.hpp"
+#include "main/Profiler.hpp"
 #include "utilities/Vector3.hpp"
 
 #include <math.h>
@@ -25,7 +27,10 @@ namespace StevEngine::Physics {
 
 	//Tick
 	void PhysicsSystem::Update(double deltaTime) {
+		StevEngine_PROFILE_ZONE("PhysicsSystem::Update");
 		joltSystem.Update(deltaTime, 1, &tempAllocator, &jobSystem);
+		//Keep the last two body transforms, to interpolate between them until the next step
+		ComponentRegistry::ForEach<RigidBody>([] (RigidBody& body) { body.StoreState(); });
 	}
 
 	//Constructor
@@ -50,14 +55,14 @@ namespace StevEngine::Physics {
 		// This is the maximum size of the contact constraint buffer. If more contacts (collisions between bodies) are detected than this number then these contacts will be ignored and bodies will start interpenetrating / fall through the world.
 		const uint32_t cMaxContactConstraints = 10240;
 		//Initialize job system
-		jobSystem.Init(1024);
+		jobSystem.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 		// Create the actual physics system.
 		joltSystem.Init(cMaxBodies, cNumBodyMutexes, cMaxBodyPairs, cMaxContactConstraints, broad_phase_layer_interface, object_vs_broadphase_layer_filter, object_vs_object_layer_filter);
 		// Set system settings
 		joltSystem.SetPhysicsSettings(settings);
 		joltSystem.SetGravity(Utilities::Vector3::up * (-9.815));
 		//Events
-		engine->GetEvents().Subscribe<UpdateEvent>([this] (UpdateEvent e) { this->Update(e.deltaTime); });
+		engine->GetEvents().Subscribe<FixedUpdateEvent>([this] (const FixedUpdateEvent& e) { this->Update(e.deltaTime); });
 	}
 
 	JPH::Body* PhysicsSystem::CreateBody(JPH::BodyCreationSettings settings, RigidBody* attachedRigidBody) {
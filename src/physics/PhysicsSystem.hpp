@@ -12,7 +12,6 @@
 #include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
-#include <Jolt/Core/JobSystemSingleThreaded.h>
 #include <Jolt/Physics/Collision/RayCast.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
 #include <Jolt/Physics/Collision/Shape/SphereShape.h>
@@ -23,6 +22,7 @@
 #include <Jolt/Physics/Body/BodyActivationListener.h>
 
 #include "Layers.hpp"
+#include "JobSystemAdapter.hpp"
 
 namespace StevEngine {
 	class Engine;
@@ -78,14 +78,14 @@ namespace StevEngine {
 
 			private:
 				/**
-				 * @brief Update physics simulation
+				 * @brief Step physics simulation, called on every fixed update
 				 * @param deltaTime Time step for physics simulation
 				 */
 				void Update(double deltaTime);
 
 				JPH::PhysicsSystem joltSystem;		  ///< Main Jolt physics system
 				JPH::TempAllocatorMalloc tempAllocator; ///< Memory allocator for physics
-				JPH::JobSystemSingleThreaded jobSystem;  ///< Job system for physics calculations
+				JobSystemAdapter jobSystem;  ///< Runs physics calculations on the engine job system
 
 				// Layer management
 				BPLayerInterfaceImpl broad_phase_layer_interface;						///< Broad phase layer interface
@@ -4,6 +4,7 @@
 #include "physics/PhysicsSystem.hpp"
 #include "physics/Layers.hpp"
 
+#include "main/Engine.hpp"
 #include "main/Log.hpp"
 #include "main/GameObject.hpp"
 #include "main/Component.hpp"
@@ -41,9 +42,10 @@ namespace StevEngine::Physics {
 		bodySettings.mMassPropertiesOverride = massProperties;
 		//	Create body from settings
 		body = physics.CreateBody(bodySettings, this);
+		StoreState(true);
 		//Events
-		handlers.emplace_back(parent.Subscribe<ColliderUpdateEvent>([this](ColliderUpdateEvent) { RefreshShape(); }), ColliderUpdateEvent::GetStaticEventType());
-		handlers.emplace_back(parent.Subscribe<TransformUpdateEvent>([this](TransformUpdateEvent e) { TransformUpdate(e.position, e.rotation, e.scale); }), TransformUpdateEvent::GetStaticEventType());
+		handlers.emplace_back(parent.Subscribe<ColliderUpdateEvent>([this](ColliderUpdateEvent) { RefreshShape(); }));
+		handlers.emplace_back(parent.Subscribe<TransformUpdateEvent>([this](TransformUpdateEvent e) { TransformUpdate(e.position, e.rotation, e.scale); }));
 	}
 	void RigidBody::Deactivate() {
 		if(body) physics.DestroyBody(body, this);
@@ -54,13 +56,31 @@ namespace StevEngine::Physics {
 	void RigidBody::Update(double deltaTime) {
 		if(motionType != JPH::EMotionType::Static) {
 			GameObject& parent = GetParent();
-			parent.SetPosition(body->GetPosition(), false);
-			parent.SetRotation(body->GetRotation(), false);
+			double t = engine->GetInterpolation();
+			parent.SetPosition(previousPosition + (currentPosition - previousPosition) * t, false);
+			parent.SetRotation(Utilities::Quaternion::Slerp(previousRotation, currentRotation, t), false);
 		}
 	}
+	void RigidBody::StoreState(bool snap) {
+		if(!body) return;
+		previousPosition = currentPosition;
+		previousRotation = currentRotation;
+		currentPosition = body->GetPosition();
+		currentRotation = body->GetRotation();
+		if(snap) {
+			previousPosition = currentPosition;
+			previousRotation = currentRotation;
+		}
+	}
+	void RigidBody::UpdateAll(std::span<RigidBody*> bodies, double deltaTime) {
+		for(RigidBody* body : bodies) body->Update(deltaTime);
+	}
 	void RigidBody::TransformUpdate(bool position, bool rotation, bool scale) {
 		GameObject& parent = GetParent();
-		if(position || rotation) if(body != nullptr) body->SetPositionAndRotationInternal(parent.GetWorldPosition() - shape->GetCenterOfMass(), parent.GetWorldRotation());
+		if(position || rotation) if(body != nullptr) {
+			body->SetPositionAndRotationInternal(parent.GetWorldPosition() - shape->GetCenterOfMass(), parent.GetWorldRotation());
+			StoreState(true);
+		}
 		if(scale) RefreshShape();
 	}
 	void RigidBody::RefreshShape() {
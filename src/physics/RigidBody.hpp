@@ -70,6 +70,9 @@ namespace StevEngine::Physics {
 			MotionProperties motionProperties;			  ///< Motion behavior settings
 			JPH::Body* body;							   ///< Jolt physics body
 			JPH::Ref<JPH::Shape> shape;					///< Combined collision shape
+			//Body transform after the last two physics steps, interpolated between when updating
+			Utilities::Vector3 previousPosition, currentPosition;		///< Body position after the last two physics steps
+			Utilities::Quaternion previousRotation, currentRotation;	///< Body rotation after the last two physics steps
 
 		public:
 			/**
@@ -110,11 +113,24 @@ namespace StevEngine::Physics {
 			void Deactivate();
 
 			/**
-			 * @brief Update transform from physics
+			 * @brief Update transform from physics, interpolated between the last two physics steps
 			 * @param deltaTime Time since last update
 			 */
 			void Update(double deltaTime);
 
+			/**
+			 * @brief Store body transform after a physics step
+			 * @param snap Whether to also overwrite the previous transform, skipping interpolation
+			 */
+			void StoreState(bool snap = false);
+
+			/**
+			 * @brief Update transforms of all active rigidbodies from physics
+			 * @param bodies Active rigidbodies
+			 * @param deltaTime Time since last update
+			 */
+			static void UpdateAll(std::span<RigidBody*> bodies, double deltaTime);
+
 			/**
 			 * @brief Clean up resources
 			 */
@@ -0,0 +1,266 @@
+#include "BakedModel.hpp"
+#include "main/Log.hpp"
+#include "utilities/Vertex.hpp"
+#ifdef StevEngine_MODELS
+#include "utilities/Model.hpp"
+#endif
+
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace StevEngine::Utilities {
+	//Mapped file
+	MappedFile::MappedFile(const std::string& path) {
+		#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if(file == INVALID_HANDLE_VALUE) {
+			file = nullptr;
+			return;
+		}
+		LARGE_INTEGER fileSize;
+		if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return;
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if(!mapping) return;
+		data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if(data) size = fileSize.QuadPart;
+		#else
+		int descriptor = open(path.c_str(), O_RDONLY);
+		if(descriptor < 0) return;
+		struct stat status;
+		if(fstat(descriptor, &status) == 0 && status.st_size > 0) {
+			void* mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if(mapped != MAP_FAILED) {
+				data = (const char*)mapped;
+				size = status.st_size;
+			}
+		}
+		//The mapping stays valid after closing the file
+		close(descriptor);
+		#endif
+	}
+
+	MappedFile::~MappedFile() {
+		#ifdef _WIN32
+		if(data) UnmapViewOfFile(data);
+		if(mapping) CloseHandle(mapping);
+		if(file) CloseHandle(file);
+		#else
+		if(data) munmap((void*)data, size);
+		#endif
+	}
+
+	void MappedFile::Evict(const void* data, size_t size) {
+		#ifdef _WIN32
+		//Windows drops unused pages of mapped files by itself
+		(void)data;
+		(void)size;
+		#else
+		uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+		uintptr_t start = ((uintptr_t)data + pageSize - 1) / pageSize * pageSize;
+		uintptr_t end = ((uintptr_t)data + size) / pageSize * pageSize;
+		if(start < end) madvise((void*)start, end - start, MADV_DONTNEED);
+		#endif
+	}
+
+	//Baked model
+	BakedModel::BakedModel(const std::string& path) : file(path) {
+		if(!InFile(0, sizeof(BakedModelHeader))) return;
+		const BakedModelHeader* fileHeader = (const BakedModelHeader*)file.GetData();
+		if(std::memcmp(fileHeader->magic, "SEBM", 4) != 0 || fileHeader->version != BAKED_MODEL_VERSION) return;
+		if(!InFile(sizeof(BakedModelHeader), (uint64_t)fileHeader->meshCount * sizeof(BakedMeshHeader))) return;
+		if(!InFile(fileHeader->pathOffset, fileHeader->pathLength)) return;
+		//Check every range once, so meshes can be read without checks
+		const BakedMeshHeader* fileMeshes = (const BakedMeshHeader*)(file.GetData() + sizeof(BakedModelHeader));
+		for(uint32_t i = 0; i < fileHeader->meshCount; i++) {
+			const BakedMeshHeader& mesh = fileMeshes[i];
+			if(mesh.vertexOffset % alignof(float) != 0 || mesh.indexOffset % alignof(uint32_t) != 0) return;
+			if(!InFile(mesh.vertexOffset, (uint64_t)mesh.vertexCount * VERTEX_SIZE)) return;
+			if(!InFile(mesh.indexOffset, (uint64_t)mesh.indexCount * sizeof(uint32_t))) return;
+			if(!InFile(mesh.albedoPathOffset, mesh.albedoPathLength) || !InFile(mesh.normalPathOffset, mesh.normalPathLength)) return;
+		}
+		header = fileHeader;
+		meshes = fileMeshes;
+	}
+
+	bool BakedModel::InFile(uint64_t offset, uint64_t size) const {
+		return file.IsOpen() && offset <= file.GetSize() && size <= file.GetSize() - offset;
+	}
+
+	bool BakedModel::IsBakedFrom(const Resources::Resource& source) const {
+		if(!header) return false;
+		if(header->sourceSize != (uint64_t)source.GetSize() || GetSourcePath() != source.path) return false;
+		return header->sourceHash == HashSourceModel(source);
+	}
+
+	std::string_view BakedModel::GetSourcePath() const {
+		if(!header) return std::string_view();
+		return std::string_view(file.GetData() + header->pathOffset, header->pathLength);
+	}
+
+	BakedMesh BakedModel::GetMesh(uint32_t index) const {
+		const BakedMeshHeader& mesh = meshes[index];
+		const char* data = file.GetData();
+		return BakedMesh {
+			std::span<const float>((const float*)(data + mesh.vertexOffset), (size_t)mesh.vertexCount * VERTEX_COUNT),
+			std::span<const uint32_t>((const uint32_t*)(data + mesh.indexOffset), mesh.indexCount),
+			Range3(Vector3(mesh.bounds[0], mesh.bounds[1], mesh.bounds[2]), Vector3(mesh.bounds[3], mesh.bounds[4], mesh.bounds[5])),
+			&mesh,
+			std::string_view(data + mesh.albedoPathOffset, mesh.albedoPathLength),
+			std::string_view(data + mesh.normalPathOffset, mesh.normalPathLength)
+		};
+	}
+
+	uint64_t HashSourceModel(const Resources::Resource& source) {
+		//Four independent lanes of 8 bytes each, so the multiplications overlap
+		uint64_t lanes[4] = { 14695981039346656037ULL, 14695981039346656037ULL ^ 1, 14695981039346656037ULL ^ 2, 14695981039346656037ULL ^ 3 };
+		const char* data = source.GetRawData();
+		size_t size = source.GetSize();
+		size_t i = 0;
+		for(; i + 32 <= size; i += 32) {
+			for(int lane = 0; lane < 4; lane++) {
+				uint64_t word;
+				std::memcpy(&word, data + i + lane * 8, sizeof(word));
+				lanes[lane] = (lanes[lane] ^ word) * 1099511628211ULL;
+			}
+		}
+		uint64_t hash = size;
+		for(uint64_t lane : lanes) hash = (hash ^ lane ^ (lane >> 29)) * 1099511628211ULL;
+		for(; i < size; i++) hash = (hash ^ (uint8_t)data[i]) * 1099511628211ULL;
+		return hash;
+	}
+
+	#ifdef StevEngine_MODELS
+	//Baking
+	bool BakeModel(const Resources::Resource& source, const std::string& path) {
+		//Only the texture paths are stored, so the images are not decoded
+		Model model(source, false, false);
+		//Do not cache a failed parse, it would be reused until the source changes
+		if(!model.IsLoaded()) return false;
+		const std::vector<Mesh>& modelMeshes = model.GetMeshes();
+		//Strings follow the mesh entries
+		std::string strings;
+		auto addString = [&strings, &modelMeshes] (const std::string& value, uint32_t& offset, uint32_t& length) {
+			offset = sizeof(BakedModelHeader) + modelMeshes.size() * sizeof(BakedMeshHeader) + strings.size();
+			length = value.size();
+			strings += value;
+		};
+		BakedModelHeader header = {};
+		std::memcpy(header.magic, "SEBM", 4);
+		header.version = BAKED_MODEL_VERSION;
+		header.sourceSize = source.GetSize();
+		header.sourceHash = HashSourceModel(source);
+		header.meshCount = modelMeshes.size();
+		addString(source.path, header.pathOffset, header.pathLength);
+		#ifdef StevEngine_SHOW_WINDOW
+		header.hasMaterials = model.hasMaterials;
+		#endif
+		std::vector<BakedMeshHeader> meshHeaders(modelMeshes.size());
+		std::vector<std::vector<float>> vertexData(modelMeshes.size());
+		for(size_t i = 0; i < modelMeshes.size(); i++) {
+			const Mesh& mesh = modelMeshes[i];
+			BakedMeshHeader& meshHeader = meshHeaders[i];
+			vertexData[i] = ToFloatList(mesh.vertices);
+			meshHeader.vertexCount = mesh.vertices.size();
+			meshHeader.indexCount = mesh.indices.size();
+			//Bounding box
+			Range3 bounds = Range3(Vector3(0), Vector3(0));
+			if(!mesh.vertices.empty()) bounds = Range3(mesh.vertices[0].position, mesh.vertices[0].position);
+			for(const Vertex& vertex : mesh.vertices) bounds = Range3::Combine(bounds, Range3(vertex.position, vertex.position));
+			float box[6] = { (float)bounds.Low.X, (float)bounds.Low.Y, (float)bounds.Low.Z, (float)bounds.High.X, (float)bounds.High.Y, (float)bounds.High.Z };
+			std::memcpy(meshHeader.bounds, box, sizeof(box));
+			//Material
+			#ifdef StevEngine_SHOW_WINDOW
+			const MeshMaterialData& material = model.pendingMaterials[i];
+			uint8_t color[4] = { material.color.r, material.color.g, material.color.b, material.color.a };
+			float values[10] = {
+				(float)material.ambient.X, (float)material.ambient.Y, (float)material.ambient.Z,
+				(float)material.diffuse.X, (float)material.diffuse.Y, (float)material.diffuse.Z,
+				(float)material.specular.X, (float)material.specular.Y, (float)material.specular.Z,
+				material.shininess
+			};
+			addString(material.albedoPath, meshHeader.albedoPathOffset, meshHeader.albedoPathLength);
+			addString(material.normalPath, meshHeader.normalPathOffset, meshHeader.normalPathLength);
+			#else
+			uint8_t color[4] = { 255, 255, 255, 255 };
+			float values[10] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 32 };
+			#endif
+			std::memcpy(meshHeader.color, color, sizeof(color));
+			std::memcpy(meshHeader.ambient, values, 3 * sizeof(float));
+			std::memcpy(meshHeader.diffuse, values + 3, 3 * sizeof(float));
+			std::memcpy(meshHeader.specular, values + 6, 3 * sizeof(float));
+			meshHeader.shininess = values[9];
+		}
+		//Place vertex and index data after the strings, aligned
+		uint64_t offset = sizeof(BakedModelHeader) + meshHeaders.size() * sizeof(BakedMeshHeader) + strings.size();
+		auto align = [] (uint64_t value) { return (value + BAKED_MODEL_ALIGNMENT - 1) / BAKED_MODEL_ALIGNMENT * BAKED_MODEL_ALIGNMENT; };
+		for(size_t i = 0; i < meshHeaders.size(); i++) {
+			meshHeaders[i].vertexOffset = offset = align(offset);
+			offset += vertexData[i].size() * sizeof(float);
+			meshHeaders[i].indexOffset = offset = align(offset);
+			offset += modelMeshes[i].indices.size() * sizeof(uint32_t);
+		}
+		//Write to a temporary file first, so a file that is mapped is never changed
+		std::string temporary = path + ".tmp";
+		{
+			std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+			if(!output) {
+				Log::Error(std::format("Couldn't write baked model {}", path), true);
+				return false;
+			}
+			auto pad = [&output, &align] () {
+				uint64_t position = output.tellp();
+				static const char zeros[BAKED_MODEL_ALIGNMENT] = {};
+				output.write(zeros, align(position) - position);
+			};
+			output.write((const char*)&header, sizeof(header));
+			output.write((const char*)meshHeaders.data(), meshHeaders.size() * sizeof(BakedMeshHeader));
+			output.write(strings.data(), strings.size());
+			for(size_t i = 0; i < meshHeaders.size(); i++) {
+				pad();
+				output.write((const char*)vertexData[i].data(), vertexData[i].size() * sizeof(float));
+				pad();
+				output.write((const char*)modelMeshes[i].indices.data(), modelMeshes[i].indices.size() * sizeof(uint32_t));
+			}
+			if(!output) {
+				Log::Error(std::format("Couldn't write baked model {}", path), true);
+				return false;
+			}
+		}
+		std::error_code error;
+		std::filesystem::rename(temporary, path, error);
+		if(error) {
+			Log::Error(std::format("Couldn't write baked model {}: {}", path, error.message()), true);
+			std::filesystem::remove(temporary, error);
+			return false;
+		}
+		return true;
+	}
+
+	std::shared_ptr<BakedModel> LoadBakedModel(const Resources::Resource& source, const std::string& path) {
+		{
+			std::shared_ptr<BakedModel> baked = std::make_shared<BakedModel>(path);
+			if(baked->IsBakedFrom(source)) return baked;
+		}
+		//Missing or out of date, so bake it again
+		if(!BakeModel(source, path)) return nullptr;
+		std::shared_ptr<BakedModel> baked = std::make_shared<BakedModel>(path);
+		if(!baked->IsValid()) {
+			Log::Error(std::format("Couldn't load baked model {}", path), true);
+			return nullptr;
+		}
+		return baked;
+	}
+	#endif
+}
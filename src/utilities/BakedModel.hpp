@@ -0,0 +1,219 @@
+#pragma once
+#include "main/ResourceManager.hpp"
+#include "utilities/Range3.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Version of the baked model format, files of other versions are baked again
+ */
+#define BAKED_MODEL_VERSION 2
+/**
+ * @brief Alignment of the vertex and index data in baked model files
+ */
+#define BAKED_MODEL_ALIGNMENT 16
+
+namespace StevEngine::Utilities {
+	/**
+	 * @brief Read only view of a file mapped into memory
+	 *
+	 * Pages are read from disk by the operating system when first accessed.
+	 */
+	class MappedFile {
+		public:
+			/**
+			 * @brief Map file into memory
+			 * @param path Path of the file
+			 */
+			MappedFile(const std::string& path);
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+			~MappedFile();
+
+			/**
+			 * @brief Check if the file was mapped
+			 * @return true if the data can be read, otherwise false
+			 */
+			bool IsOpen() const { return data; }
+
+			/**
+			 * @brief Get mapped data
+			 * @return Pointer to the start of the file, nullptr if not open
+			 */
+			const char* GetData() const { return data; }
+
+			/**
+			 * @brief Get size of mapped data
+			 * @return Size in bytes
+			 */
+			size_t GetSize() const { return size; }
+
+			/**
+			 * @brief Let the system drop mapped pages from memory, they are read from the file again when accessed
+			 *
+			 * Only whole pages inside the range are dropped. Must only be used on read only mapped data.
+			 * @param data Start of the range
+			 * @param size Size of the range in bytes
+			 */
+			static void Evict(const void* data, size_t size);
+
+		private:
+			const char* data = nullptr;  ///< Start of the mapped file
+			size_t size = 0;			 ///< Size of the file in bytes
+			#ifdef _WIN32
+			void* file = nullptr;		 ///< Windows file handle
+			void* mapping = nullptr;	 ///< Windows file mapping handle
+			#endif
+	};
+
+	/**
+	 * @brief Start of a baked model file
+	 *
+	 * Files are written in the native byte order and layout, so they are read without conversion.
+	 * The header is followed by one BakedMeshHeader per mesh, the strings, and the aligned vertex and index data.
+	 */
+	struct BakedModelHeader {
+		char magic[4];			///< Always "SEBM"
+		uint32_t version;		///< Format version, BAKED_MODEL_VERSION
+		uint64_t sourceSize;	///< Size of the source model file
+		uint64_t sourceHash;	///< Hash of the source model file, from HashSourceModel
+		uint32_t meshCount;		///< Number of meshes
+		uint32_t hasMaterials;	///< Whether the meshes have material data
+		uint32_t pathOffset;	///< Offset of the source model path
+		uint32_t pathLength;	///< Length of the source model path
+	};
+
+	/**
+	 * @brief Mesh entry of a baked model file
+	 */
+	struct BakedMeshHeader {
+		uint64_t vertexOffset;		///< Offset of the vertex data, VERTEX_COUNT floats per vertex
+		uint64_t indexOffset;		///< Offset of the index data
+		uint32_t vertexCount;		///< Number of vertices
+		uint32_t indexCount;		///< Number of indices
+		float bounds[6];			///< Bounding box of the vertices, low then high corner
+		uint8_t color[4];			///< Material base color
+		float ambient[3];			///< Material ambient light reflection
+		float diffuse[3];			///< Material diffuse light reflection
+		float specular[3];			///< Material specular light reflection
+		float shininess;			///< Material specular highlight size
+		uint32_t albedoPathOffset;	///< Offset of the albedo texture path
+		uint32_t albedoPathLength;	///< Length of the albedo texture path, 0 if none
+		uint32_t normalPathOffset;	///< Offset of the normal texture path
+		uint32_t normalPathLength;	///< Length of the normal texture path, 0 if none
+	};
+
+	/**
+	 * @brief View of one mesh in a baked model
+	 *
+	 * Points into the mapped file, so it is only valid while the baked model exists.
+	 */
+	struct BakedMesh {
+		std::span<const float> vertices;   ///< Vertex data in the GPU layout
+		std::span<const uint32_t> indices; ///< Vertex indices
+		Range3 bounds;					   ///< Bounding box of the vertices
+		const BakedMeshHeader* header;	   ///< Material values of the mesh
+		std::string_view albedoPath;	   ///< Resource path of the albedo texture, empty if none
+		std::string_view normalPath;	   ///< Resource path of the normal texture, empty if none
+	};
+
+	/**
+	 * @brief Model meshes baked into a binary file
+	 *
+	 * The file is memory mapped, and its vertex and index data are used directly
+	 * instead of parsing the source model.
+	 */
+	class BakedModel {
+		public:
+			/**
+			 * @brief Map baked model file
+			 * @param path Path of the baked file
+			 */
+			BakedModel(const std::string& path);
+
+			/**
+			 * @brief Check if the file is a complete baked model of the current version
+			 * @return true if the meshes can be read, otherwise false
+			 */
+			bool IsValid() const { return header; }
+
+			/**
+			 * @brief Check if the model was baked from a source file
+			 * @param source Source model file
+			 * @return true if the size and hash of the source match, otherwise false
+			 */
+			bool IsBakedFrom(const Resources::Resource& source) const;
+
+			/**
+			 * @brief Get path of the source model
+			 * @return Resource path the model was baked from
+			 */
+			std::string_view GetSourcePath() const;
+
+			/**
+			 * @brief Check if the meshes have material data
+			 * @return true if materials were baked, otherwise false
+			 */
+			bool HasMaterials() const { return header && header->hasMaterials; }
+
+			/**
+			 * @brief Get number of meshes
+			 * @return Mesh count
+			 */
+			uint32_t GetMeshCount() const { return header ? header->meshCount : 0; }
+
+			/**
+			 * @brief Get mesh data
+			 * @param index Mesh index
+			 * @return View of the mesh in the mapped file
+			 */
+			BakedMesh GetMesh(uint32_t index) const;
+
+		private:
+			/**
+			 * @brief Check that a range lies within the mapped file
+			 * @param offset Start of the range
+			 * @param size Size of the range in bytes
+			 * @return true if inside, otherwise false
+			 */
+			bool InFile(uint64_t offset, uint64_t size) const;
+
+			MappedFile file;							///< Mapped baked file
+			const BakedModelHeader* header = nullptr;	///< File header, nullptr if the file is not valid
+			const BakedMeshHeader* meshes = nullptr;	///< Mesh entries
+	};
+
+	/**
+	 * @brief Get hash identifying the contents of a source model file
+	 *
+	 * Hashes 32 bytes per step, so checking a baked model costs little next to loading it.
+	 * @param source Source model file
+	 * @return FNV-1a style hash of the file data
+	 */
+	uint64_t HashSourceModel(const Resources::Resource& source);
+
+	#ifdef StevEngine_MODELS
+	/**
+	 * @brief Parse model and write its meshes to a baked model file
+	 *
+	 * Only reads texture paths, without decoding or uploading the textures, so it can run offline or on any thread.
+	 * @param source Source model file
+	 * @param path Path of the baked file to write
+	 * @return true if written, false if the model could not be parsed or the file not written
+	 */
+	bool BakeModel(const Resources::Resource& source, const std::string& path);
+
+	/**
+	 * @brief Load baked model, baking it first if the file is missing or out of date
+	 * @param source Source model file
+	 * @param path Path of the baked file
+	 * @return Baked model, or nullptr if it could not be baked
+	 */
+	std::shared_ptr<BakedModel> LoadBakedModel(const Resources::Resource& source, const std::string& path);
+	#endif
+}
@@ -0,0 +1,165 @@
+#include "BoundingVolumeTree.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace StevEngine::Utilities {
+	//Leaves
+	uint32_t BoundingVolumeTree::Insert(const Range3& bounds, void* data) {
+		uint32_t leaf = AllocateNode();
+		nodes[leaf].bounds = Fatten(bounds);
+		nodes[leaf].data = data;
+		nodes[leaf].height = 0;
+		InsertLeaf(leaf);
+		leafCount++;
+		return leaf;
+	}
+
+	void BoundingVolumeTree::Remove(uint32_t proxy) {
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		leafCount--;
+	}
+
+	bool BoundingVolumeTree::Move(uint32_t proxy, const Range3& bounds) {
+		Range3 fat = Fatten(bounds);
+		const Range3& stored = nodes[proxy].bounds;
+		//Keep the stored box while it still fits closely enough
+		if(stored.Contains(bounds) && stored.GetSurfaceArea() <= 2 * fat.GetSurfaceArea()) return false;
+		RemoveLeaf(proxy);
+		nodes[proxy].bounds = fat;
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	Range3 BoundingVolumeTree::Fatten(const Range3& bounds) {
+		Vector3 size = bounds.GetSize();
+		return bounds.Expanded(Vector3(
+			std::abs(size.X) * marginScale + minimumMargin,
+			std::abs(size.Y) * marginScale + minimumMargin,
+			std::abs(size.Z) * marginScale + minimumMargin
+		));
+	}
+
+	//Nodes
+	uint32_t BoundingVolumeTree::AllocateNode() {
+		if(freeNodes == none) {
+			nodes.emplace_back();
+			return nodes.size() - 1;
+		}
+		uint32_t index = freeNodes;
+		freeNodes = nodes[index].parent;
+		nodes[index] = Node();
+		return index;
+	}
+
+	void BoundingVolumeTree::FreeNode(uint32_t index) {
+		nodes[index].parent = freeNodes;
+		nodes[index].children[0] = none;
+		nodes[index].children[1] = none;
+		nodes[index].data = nullptr;
+		nodes[index].height = -1;
+		freeNodes = index;
+	}
+
+	void BoundingVolumeTree::InsertLeaf(uint32_t leaf) {
+		if(root == none) {
+			root = leaf;
+			nodes[leaf].parent = none;
+			return;
+		}
+		//Walk down to the sibling with the lowest cost, where the cost is the surface area added to the tree
+		const Range3 bounds = nodes[leaf].bounds;
+		uint32_t index = root;
+		while(!nodes[index].IsLeaf()) {
+			const Node& node = nodes[index];
+			double area = node.bounds.GetSurfaceArea();
+			double combinedArea = Range3::Combine(node.bounds, bounds).GetSurfaceArea();
+			//Cost of making a new branch here, and the cost every level below adds by growing this branch
+			double branchCost = 2 * combinedArea;
+			double inheritedCost = 2 * (combinedArea - area);
+			double childCosts[2];
+			for(int i = 0; i < 2; i++) {
+				const Node& child = nodes[node.children[i]];
+				double grownArea = Range3::Combine(child.bounds, bounds).GetSurfaceArea();
+				childCosts[i] = (child.IsLeaf() ? grownArea : grownArea - child.bounds.GetSurfaceArea()) + inheritedCost;
+			}
+			if(branchCost < childCosts[0] && branchCost < childCosts[1]) break;
+			index = node.children[childCosts[0] < childCosts[1] ? 0 : 1];
+		}
+		//Replace the sibling with a branch holding both
+		uint32_t sibling = index;
+		uint32_t oldParent = nodes[sibling].parent;
+		uint32_t branch = AllocateNode();
+		nodes[branch].parent = oldParent;
+		nodes[branch].bounds = Range3::Combine(nodes[sibling].bounds, bounds);
+		nodes[branch].height = nodes[sibling].height + 1;
+		nodes[branch].children[0] = sibling;
+		nodes[branch].children[1] = leaf;
+		nodes[sibling].parent = branch;
+		nodes[leaf].parent = branch;
+		if(oldParent == none) root = branch;
+		else nodes[oldParent].children[nodes[oldParent].children[0] == sibling ? 0 : 1] = branch;
+		FixUpwards(oldParent);
+	}
+
+	void BoundingVolumeTree::RemoveLeaf(uint32_t leaf) {
+		if(leaf == root) {
+			root = none;
+			return;
+		}
+		//Put the sibling in the place of the parent branch
+		uint32_t parent = nodes[leaf].parent;
+		uint32_t grandParent = nodes[parent].parent;
+		uint32_t sibling = nodes[parent].children[nodes[parent].children[0] == leaf ? 1 : 0];
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+		if(grandParent == none) root = sibling;
+		else {
+			nodes[grandParent].children[nodes[grandParent].children[0] == parent ? 0 : 1] = sibling;
+			FixUpwards(grandParent);
+		}
+	}
+
+	void BoundingVolumeTree::FixUpwards(uint32_t index) {
+		while(index != none) {
+			index = Balance(index);
+			Node& node = nodes[index];
+			const Node& a = nodes[node.children[0]];
+			const Node& b = nodes[node.children[1]];
+			node.bounds = Range3::Combine(a.bounds, b.bounds);
+			node.height = std::max(a.height, b.height) + 1;
+			index = node.parent;
+		}
+	}
+
+	uint32_t BoundingVolumeTree::Balance(uint32_t index) {
+		Node& node = nodes[index];
+		if(node.IsLeaf() || node.height < 2) return index;
+		uint32_t left = node.children[0];
+		uint32_t right = node.children[1];
+		int32_t difference = nodes[right].height - nodes[left].height;
+		if(std::abs(difference) <= 1) return index;
+		//Rotate the taller child up, it takes the place of this branch and keeps its own taller child
+		int taller = difference > 0 ? 1 : 0;
+		uint32_t up = node.children[taller];
+		uint32_t parent = node.parent;
+		Node& upNode = nodes[up];
+		uint32_t upChildren[2] = { upNode.children[0], upNode.children[1] };
+		upNode.children[0] = index;
+		upNode.parent = parent;
+		node.parent = up;
+		if(parent == none) root = up;
+		else nodes[parent].children[nodes[parent].children[0] == index ? 0 : 1] = up;
+		//This branch keeps the shorter grandchild, so the taller one stays higher in the tree
+		int keep = nodes[upChildren[0]].height > nodes[upChildren[1]].height ? 0 : 1;
+		upNode.children[1] = upChildren[keep];
+		node.children[taller] = upChildren[1 - keep];
+		nodes[upChildren[1 - keep]].parent = index;
+		nodes[upChildren[keep]].parent = up;
+		//Fix this branch now, the caller fixes the one that moved up
+		node.bounds = Range3::Combine(nodes[node.children[0]].bounds, nodes[node.children[1]].bounds);
+		node.height = std::max(nodes[node.children[0]].height, nodes[node.children[1]].height) + 1;
+		return up;
+	}
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include "utilities/Frustum.hpp"
+#include "utilities/Range3.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace StevEngine::Utilities {
+	/**
+	 * @brief Dynamic bounding volume hierarchy of axis aligned boxes
+	 *
+	 * Every leaf holds a box and a pointer to user data, and every branch holds the box around its two children.
+	 * Leaves are inserted next to the sibling that grows the tree's surface area the least,
+	 * and the tree is kept balanced by rotating branches on the way back up.
+	 * Leaf boxes are stored with a margin, so moving a leaf a short distance only needs a check instead of a reinsertion.
+	 */
+	class BoundingVolumeTree {
+		public:
+			/** @brief Proxy or node index value used for none */
+			static constexpr uint32_t none = UINT32_MAX;
+
+			/**
+			 * @brief Add a leaf
+			 * @param bounds Box of the leaf
+			 * @param data User data of the leaf
+			 * @return Proxy of the leaf, stays valid until removed
+			 */
+			uint32_t Insert(const Range3& bounds, void* data);
+
+			/**
+			 * @brief Remove a leaf
+			 * @param proxy Proxy of the leaf
+			 */
+			void Remove(uint32_t proxy);
+
+			/**
+			 * @brief Change the box of a leaf
+			 *
+			 * The leaf is only reinserted if the new box is outside its stored box, or much smaller than it.
+			 * @param proxy Proxy of the leaf
+			 * @param bounds New box of the leaf
+			 * @return true if the leaf was reinserted
+			 */
+			bool Move(uint32_t proxy, const Range3& bounds);
+
+			/**
+			 * @brief Get user data of a leaf
+			 * @param proxy Proxy of the leaf
+			 * @return User data
+			 */
+			void* GetData(uint32_t proxy) const { return nodes[proxy].data; }
+
+			/**
+			 * @brief Get stored box of a leaf, including the margin
+			 * @param proxy Proxy of the leaf
+			 * @return Stored box
+			 */
+			const Range3& GetBounds(uint32_t proxy) const { return nodes[proxy].bounds; }
+
+			/**
+			 * @brief Get number of leaves
+			 * @return Leaf count
+			 */
+			uint32_t GetCount() const { return leafCount; }
+
+			/**
+			 * @brief Get height of the tree
+			 * @return Number of branches from the root to the deepest leaf
+			 */
+			int32_t GetHeight() const { return root == none ? 0 : nodes[root].height; }
+
+			/**
+			 * @brief Call a function for every leaf passing a test
+			 *
+			 * Branches failing the test are skipped with all their leaves, and the leaves of branches fully inside are not tested.
+			 * The tree must not be changed from the function.
+			 * @param test Function taking a box and returning its Containment
+			 * @param function Function taking the user data of a leaf
+			 */
+			template<typename Test, typename Function> void Query(Test&& test, Function&& function) const {
+				if(root == none) return;
+				//Nodes to visit, and whether they are known to be inside, which never exceed the height plus one
+				std::pair<uint32_t, bool> fixedStack[queryStackSize];
+				std::vector<std::pair<uint32_t, bool>> heapStack;
+				std::pair<uint32_t, bool>* stack = fixedStack;
+				if(nodes[root].height >= queryStackSize) {
+					heapStack.resize(nodes[root].height + 1);
+					stack = heapStack.data();
+				}
+				size_t count = 0;
+				stack[count++] = { root, false };
+				while(count > 0) {
+					auto [index, inside] = stack[--count];
+					const Node& node = nodes[index];
+					if(!inside) {
+						Containment containment = test(node.bounds);
+						if(containment == OUTSIDE) continue;
+						inside = (containment == INSIDE);
+					}
+					if(node.IsLeaf()) function(node.data);
+					else {
+						stack[count++] = { node.children[0], inside };
+						stack[count++] = { node.children[1], inside };
+					}
+				}
+			}
+
+		private:
+			/** @brief Leaf, branch, or free node */
+			struct Node {
+				Range3 bounds;							///< Box of the leaf with margin, or around both children
+				void* data = nullptr;					///< User data of a leaf
+				uint32_t parent = none;					///< Parent branch, or next free node
+				uint32_t children[2] = { none, none };	///< Children of a branch
+				int32_t height = 0;						///< 0 for leaves, -1 for free nodes
+
+				/** @brief Check if the node is a leaf */
+				bool IsLeaf() const { return children[0] == none; }
+			};
+
+			/**
+			 * @brief Get a free node, reusing removed ones
+			 * @return Node index
+			 */
+			uint32_t AllocateNode();
+
+			/**
+			 * @brief Return a node to the free list
+			 * @param index Node index
+			 */
+			void FreeNode(uint32_t index);
+
+			/**
+			 * @brief Link a leaf into the tree
+			 * @param leaf Node index of the leaf
+			 */
+			void InsertLeaf(uint32_t leaf);
+
+			/**
+			 * @brief Unlink a leaf from the tree, freeing its parent branch
+			 * @param leaf Node index of the leaf
+			 */
+			void RemoveLeaf(uint32_t leaf);
+
+			/**
+			 * @brief Rebalance, and recalculate boxes and heights from a node up to the root
+			 * @param index First node to fix
+			 */
+			void FixUpwards(uint32_t index);
+
+			/**
+			 * @brief Rotate the taller child of a branch up, if its children differ in height by more than one
+			 * @param index Node index of the branch
+			 * @return Node index of the branch now in its place
+			 */
+			uint32_t Balance(uint32_t index);
+
+			/**
+			 * @brief Add the margin to a leaf box
+			 * @param bounds Box of the leaf
+			 * @return Box to store
+			 */
+			static Range3 Fatten(const Range3& bounds);
+
+			static constexpr double marginScale = 0.1;	///< Margin around leaf boxes, relative to their size
+			static constexpr double minimumMargin = 0.1;  ///< Margin around leaf boxes, added to the relative margin
+			static constexpr int32_t queryStackSize = 64;	///< Query stack kept on the call stack, enough for any balanced tree
+
+			std::vector<Node> nodes;	 ///< Every node, proxies are indices
+			uint32_t root = none;		///< Root node
+			uint32_t freeNodes = none;   ///< First free node, linked through the parent index
+			uint32_t leafCount = 0;	  ///< Number of leaves
+	};
+}
@@ -41,6 +41,9 @@ namespace StevEngine {
 			/** @brief Create white color */
 			Color() : r(255), g(255), b(255), a(255) {};
 
+			/** @brief Equality comparison */
+			bool operator== (const Color& other) const { return r == other.r && g == other.g && b == other.b && a == other.a; }
+
 			/**
 			 * @brief Get color as float array
 			 * @return Array of normalized float values [r,g,b,a]
@@ -0,0 +1,35 @@
+#include "Frustum.hpp"
+#include "Matrix4.hpp"
+#include "Vector4.hpp"
+
+namespace StevEngine::Utilities {
+	Frustum::Frustum(const Matrix4& viewProjection) {
+		//A point is inside when -w <= x, y, z <= w in clip space, which gives a plane from the sum or difference of two rows
+		Vector4 w = viewProjection.GetRow(3);
+		for(int axis = 0; axis < 3; axis++) {
+			Vector4 row = viewProjection.GetRow(axis);
+			planes[axis * 2] = { Vector3(w.W + row.W, w.X + row.X, w.Y + row.Y), w.Z + row.Z };
+			planes[axis * 2 + 1] = { Vector3(w.W - row.W, w.X - row.X, w.Y - row.Y), w.Z - row.Z };
+		}
+	}
+
+	Containment Frustum::Test(const Range3& range) const {
+		Containment result = INSIDE;
+		for(const Plane& plane : planes) {
+			//Corners furthest along and against the plane normal
+			Vector3 furthest = Vector3(
+				plane.normal.X >= 0 ? range.High.X : range.Low.X,
+				plane.normal.Y >= 0 ? range.High.Y : range.Low.Y,
+				plane.normal.Z >= 0 ? range.High.Z : range.Low.Z
+			);
+			Vector3 nearest = Vector3(
+				plane.normal.X >= 0 ? range.Low.X : range.High.X,
+				plane.normal.Y >= 0 ? range.Low.Y : range.High.Y,
+				plane.normal.Z >= 0 ? range.Low.Z : range.High.Z
+			);
+			if(Vector3::Dot(plane.normal, furthest) + plane.distance < 0) return OUTSIDE;
+			if(Vector3::Dot(plane.normal, nearest) + plane.distance < 0) result = INTERSECTING;
+		}
+		return result;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "utilities/Range3.hpp"
+#include "utilities/Vector3.hpp"
+
+namespace StevEngine::Utilities {
+	class Matrix4;
+
+	/** @brief Position of a volume relative to another */
+	enum Containment {
+		OUTSIDE,	  ///< No overlap
+		INTERSECTING, ///< Partly inside
+		INSIDE		///< Fully inside
+	};
+
+	/**
+	 * @brief Volume seen by a camera, bounded by six planes
+	 *
+	 * Used to skip objects that can not be seen.
+	 */
+	class Frustum {
+		public:
+			/**
+			 * @brief Create frustum from a camera's matrices
+			 * @param viewProjection Projection matrix multiplied by the view matrix
+			 */
+			Frustum(const Matrix4& viewProjection);
+
+			/**
+			 * @brief Check if a bounding box is in view
+			 * @param range Bounding box, in the same space as the view matrix
+			 * @return Whether the box is outside, partly inside or fully inside the frustum
+			 */
+			Containment Test(const Range3& range) const;
+
+		private:
+			/** @brief Plane with the inside of the frustum on the side its normal points to */
+			struct Plane {
+				Vector3 normal;   ///< Direction towards the inside, not normalized
+				double distance;  ///< Offset along the normal
+			};
+
+			Plane planes[6];  ///< Left, right, bottom, top, near and far planes
+	};
+}
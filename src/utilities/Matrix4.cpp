@@ -4,9 +4,12 @@
 #include "utilities/Vector2.hpp"
 #include "utilities/Vector3.hpp"
 #include "utilities/Vector4.hpp"
+#include "utilities/SIMD.hpp"
 #include <cmath>
 #include <string>
 
+using StevEngine::Utilities::SIMD::Double4;
+
 namespace StevEngine::Utilities {
 	//Constructors
 	Matrix4::Matrix4(double data[4][4]) {
@@ -47,100 +50,61 @@ namespace StevEngine::Utilities {
 	Vector4 Matrix4::GetColumn(int i) const {
 		return Vector4(raw[0][i], raw[1][i], raw[2][i], raw[3][i]);
 	}
-	double GetDeterminantMatrix2(Vector2 row1, Vector2 row2) {
-		return row1.X * row2.Y - row1.Y * row2.X;
-	}
-	double GetDeterminantMatrix3(Vector3 row1, Vector3 row2, Vector3 row3) {
-		double a = row1.X;
-		double b = row1.Y;
-		double c = row1.Z;
+	/** @brief Determinants of the 2x2 sub matrices used by the closed form inverse */
+	struct SubDeterminants {
+		double s0, s1, s2, s3, s4, s5;  ///< From the top two rows
+		double c0, c1, c2, c3, c4, c5;  ///< From the bottom two rows
 
-		double da = GetDeterminantMatrix2(Vector2(row2.Y, row2.Z), Vector2(row3.Y, row3.Z));
-		double db = GetDeterminantMatrix2(Vector2(row2.X, row2.Z), Vector2(row3.X, row3.Z));
-		double dc = GetDeterminantMatrix2(Vector2(row2.X, row2.Y), Vector2(row2.X, row2.Y));
+		SubDeterminants(const double m[4][4])
+		  : s0(m[0][0] * m[1][1] - m[1][0] * m[0][1]),
+			s1(m[0][0] * m[1][2] - m[1][0] * m[0][2]),
+			s2(m[0][0] * m[1][3] - m[1][0] * m[0][3]),
+			s3(m[0][1] * m[1][2] - m[1][1] * m[0][2]),
+			s4(m[0][1] * m[1][3] - m[1][1] * m[0][3]),
+			s5(m[0][2] * m[1][3] - m[1][2] * m[0][3]),
+			c0(m[2][0] * m[3][1] - m[3][0] * m[2][1]),
+			c1(m[2][0] * m[3][2] - m[3][0] * m[2][2]),
+			c2(m[2][0] * m[3][3] - m[3][0] * m[2][3]),
+			c3(m[2][1] * m[3][2] - m[3][1] * m[2][2]),
+			c4(m[2][1] * m[3][3] - m[3][1] * m[2][3]),
+			c5(m[2][2] * m[3][3] - m[3][2] * m[2][3]) {}
 
-		return (a * da) - (b * db) + (c * dc);
-	}
+		double Determinant() const {
+			return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		}
+	};
 	double Matrix4::GetDeterminant() const {
-		double a = raw[0][0];
-		double b = raw[0][1];
-		double c = raw[0][2];
-		double d = raw[0][3];
-
-		double da = GetDeterminantMatrix3(
-			Vector3(raw[1][1], raw[1][2], raw[1][3]),
-			Vector3(raw[2][1], raw[2][2], raw[2][3]),
-			Vector3(raw[3][1], raw[3][2], raw[3][3])
-		);
-		double db = GetDeterminantMatrix3(
-			Vector3(raw[0][1], raw[0][2], raw[0][3]),
-			Vector3(raw[2][1], raw[2][2], raw[2][3]),
-			Vector3(raw[3][1], raw[3][2], raw[3][3])
-		);
-		double dc = GetDeterminantMatrix3(
-			Vector3(raw[0][1], raw[0][2], raw[0][3]),
-			Vector3(raw[1][1], raw[1][2], raw[1][3]),
-			Vector3(raw[3][1], raw[3][2], raw[3][3])
-		);
-		double dd = GetDeterminantMatrix3(
-			Vector3(raw[0][1], raw[0][2], raw[0][3]),
-			Vector3(raw[1][1], raw[1][2], raw[1][3]),
-			Vector3(raw[2][1], raw[2][2], raw[2][3])
-		);
-
-		return (a * da) - (b * db) + (c * dc) - (d * dd);
+		return SubDeterminants(raw).Determinant();
 	}
 	Matrix4& Matrix4::Inverse() {
-		Matrix4 result = Inverse(*this);
-		//Set current raw
-		for(int i = 0; i < 4; i++) {
-			for(int j = 0; j < 4; j++) {
-				raw[i][j] = result.raw[i][j];
-			}
-		}
+		*this = Inverse(*this);
 		return *this;
 	}
 	Matrix4 Matrix4::Inverse(const Matrix4& matrix) {
+		const double (&m)[4][4] = matrix.raw;
+		SubDeterminants d(m);
+		//Adjugate from the sub determinants, each row combining three cofactor terms
+		Double4 c5s5 = Double4::Set(d.c5, d.c5, d.s5, d.s5);
+		Double4 c4s4 = Double4::Set(d.c4, d.c4, d.s4, d.s4);
+		Double4 c3s3 = Double4::Set(d.c3, d.c3, d.s3, d.s3);
+		Double4 c2s2 = Double4::Set(d.c2, d.c2, d.s2, d.s2);
+		Double4 c1s1 = Double4::Set(d.c1, d.c1, d.s1, d.s1);
+		Double4 c0s0 = Double4::Set(d.c0, d.c0, d.s0, d.s0);
+		Double4 scale = Double4::Splat(1 / d.Determinant());
 		Matrix4 result;
-		//Matrix of Minors
-		for(int i = 0; i < 4; i++) {
-			int row1 = i + 1;
-			int row2 = i + 2;
-			int row3 = i + 3;
-			if(row1 > 3) row1 -= 4;
-			if(row2 > 3) row2 -= 4;
-			if(row3 > 3) row3 -= 4;
-			for(int j = 0; j < 4; j++) {
-				int col1 = i + 1;
-				int col2 = i + 2;
-				int col3 = i + 3;
-				if(col1 > 3) col1 -= 4;
-				if(col2 > 3) col2 -= 4;
-				if(col3 > 3) col3 -= 4;
-
-				result.raw[i][j] = GetDeterminantMatrix3(
-					Vector3(matrix.raw[row1][col1], matrix.raw[row1][col2], matrix.raw[row1][col3]),
-					Vector3(matrix.raw[row2][col1], matrix.raw[row2][col2], matrix.raw[row2][col3]),
-					Vector3(matrix.raw[row3][col1], matrix.raw[row3][col2], matrix.raw[row3][col3])
-				);
-			}
-		}
-		//Matrix of Cofactors
-		for(int i = 0; i < 4; i++) {
-			bool evenRow = (i % 2 == 0);
-			for(int j = 0; j < 4; j++) {
-				bool evenColumn = (j % 2 == 0);
-				if(evenRow && !evenColumn) {
-					result.raw[i][j] = -result.raw[i][j];
-				} else if(!evenRow && evenColumn) {
-					result.raw[i][j] = -result.raw[i][j];
-				}
-			}
-		}
-		//Adjugate/Adjoint
-		result.Transpose();
-		//Multiply by 1/Determinant
-		return result * (1 / matrix.GetDeterminant());
+		(Double4::MulAdd(Double4::Set( m[1][1], -m[0][1],  m[3][1], -m[2][1]), c5s5,
+		 Double4::MulAdd(Double4::Set(-m[1][2],  m[0][2], -m[3][2],  m[2][2]), c4s4,
+		 Double4::Set( m[1][3], -m[0][3],  m[3][3], -m[2][3]) * c3s3)) * scale).Store(result.raw[0]);
+		(Double4::MulAdd(Double4::Set(-m[1][0],  m[0][0], -m[3][0],  m[2][0]), c5s5,
+		 Double4::MulAdd(Double4::Set( m[1][2], -m[0][2],  m[3][2], -m[2][2]), c2s2,
+		 Double4::Set(-m[1][3],  m[0][3], -m[3][3],  m[2][3]) * c1s1)) * scale).Store(result.raw[1]);
+		(Double4::MulAdd(Double4::Set( m[1][0], -m[0][0],  m[3][0], -m[2][0]), c4s4,
+		 Double4::MulAdd(Double4::Set(-m[1][1],  m[0][1], -m[3][1],  m[2][1]), c2s2,
+		 Double4::Set( m[1][3], -m[0][3],  m[3][3], -m[2][3]) * c0s0)) * scale).Store(result.raw[2]);
+		(Double4::MulAdd(Double4::Set(-m[1][0],  m[0][0], -m[3][0],  m[2][0]), c3s3,
+		 Double4::MulAdd(Double4::Set( m[1][1], -m[0][1],  m[3][1], -m[2][1]), c1s1,
+		 Double4::Set(-m[1][2],  m[0][2], -m[3][2],  m[2][2]) * c0s0)) * scale).Store(result.raw[3]);
+		return result;
 	}
 	Matrix4 Matrix4::Transpose(const Matrix4& matrix) {
 		return Matrix4(matrix.GetColumn(0), matrix.GetColumn(1), matrix.GetColumn(2), matrix.GetColumn(3));
@@ -173,10 +137,19 @@ namespace StevEngine::Utilities {
 	}
 	Matrix4  Matrix4::operator	*   (const Matrix4& other) const {
 		Matrix4 result;
+		//Each result row is the rows of other weighted by a row of this
+		Double4 rows[4] = {
+			Double4::Load(other.raw[0]),
+			Double4::Load(other.raw[1]),
+			Double4::Load(other.raw[2]),
+			Double4::Load(other.raw[3])
+		};
 		for(int i = 0; i < 4; i++) {
-			for(int j = 0; j < 4; j++) {
-				result.raw[i][j] = Vector4::Dot(this->GetRow(i), other.GetColumn(j));
-			}
+			Double4 row = rows[0] * Double4::Splat(raw[i][0]);
+			row = Double4::MulAdd(rows[1], Double4::Splat(raw[i][1]), row);
+			row = Double4::MulAdd(rows[2], Double4::Splat(raw[i][2]), row);
+			row = Double4::MulAdd(rows[3], Double4::Splat(raw[i][3]), row);
+			row.Store(result.raw[i]);
 		}
 		return result;
 	}
@@ -189,21 +162,12 @@ namespace StevEngine::Utilities {
 	}
 	Matrix4  Matrix4::operator	*   (const double& value) const {
 		Matrix4 result;
-		for(int i = 0; i < 4; i++) {
-			for(int j = 0; j < 4; j++) {
-				result.raw[i][j] *= value;
-			}
-		}
+		Double4 factor = Double4::Splat(value);
+		for(int i = 0; i < 4; i++) (Double4::Load(raw[i]) * factor).Store(result.raw[i]);
 		return result;
 	}
 	Matrix4  Matrix4::operator	/   (const double& value) const {
-		Matrix4 result;
-		for(int i = 0; i < 4; i++) {
-			for(int j = 0; j < 4; j++) {
-				result.raw[i][j] *= value;
-			}
-		}
-		return result;
+		return *this * (1 / value);
 	}
 	bool	 Matrix4::operator   ==  (const Matrix4& other) const {
 		for(int i = 0; i < 4; i++) {
@@ -225,13 +189,19 @@ namespace StevEngine::Utilities {
 		}
 		return "[" + str + "]";
 	}
-	const float* Matrix4::data() const {
-		float* out = new float[4*4];
-		for(int i = 0; i < 4; i++) {
-			for(int j = 0; j < 4; j++) {
-				out[i + j * 4] = (float)raw[i][j];
-			}
+	Matrix4f Matrix4::ToFloat() const {
+		Matrix4f out;
+		for(int j = 0; j < 4; j++) {
+			Double4::Set(raw[0][j], raw[1][j], raw[2][j], raw[3][j]).StoreFloat(out.values + j * 4);
+		}
+		return out;
+	}
+	Matrix4f Matrix4::ToFloatRelative(const Vector3& origin) const {
+		Matrix4f out;
+		for(int j = 0; j < 3; j++) {
+			Double4::Set(raw[0][j], raw[1][j], raw[2][j], raw[3][j]).StoreFloat(out.values + j * 4);
 		}
+		Double4::Set(raw[0][3] - origin.X, raw[1][3] - origin.Y, raw[2][3] - origin.Z, raw[3][3]).StoreFloat(out.values + 12);
 		return out;
 	}
 	//Static creators
@@ -259,15 +229,15 @@ namespace StevEngine::Utilities {
 			{0,0,0,1}
 		);
 	}
-	Matrix4 Matrix4::FromTranslationRotationScale(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
-		//Translation
-		Utilities::Matrix4 translationMatrix = Utilities::Matrix4::FromTranslation(position);
-		//Rotate
-		Utilities::Matrix4 rotationMatrix = Utilities::Matrix4::FromRotation(rotation);
-		//Scale
-		Utilities::Matrix4 scaleMatrix = Utilities::Matrix4::FromScale(scale);
-		//Combined
-		return (translationMatrix * (rotationMatrix * scaleMatrix));
+	Matrix4 Matrix4::FromTranslationRotationScale(const Vector3& position, const Quaternion& q, const Vector3& scale) {
+		//Same as translation * rotation * scale, without the multiplications
+		Matrix4 result;
+		Double4 scaleRow = Double4::Set(scale.X, scale.Y, scale.Z, 1);
+		(Double4::Set(2*((q.W*q.W) + (q.X*q.X)) - 1,	2*((q.X*q.Y) - (q.W*q.Z)),		2*((q.X*q.Z) + (q.W*q.Y)),		position.X) * scaleRow).Store(result.raw[0]);
+		(Double4::Set(2*((q.X*q.Y) + (q.W*q.Z)),		2*((q.W*q.W) + (q.Y*q.Y)) - 1,	2*((q.Y*q.Z) - (q.W*q.X)),		position.Y) * scaleRow).Store(result.raw[1]);
+		(Double4::Set(2*((q.X*q.Z) - (q.W*q.Y)),		2*((q.Y*q.Z) + (q.W*q.X)),		2*((q.W*q.W) + (q.Z*q.Z)) - 1,	position.Z) * scaleRow).Store(result.raw[2]);
+		Double4::Set(0, 0, 0, 1).Store(result.raw[3]);
+		return result;
 	}
 	Matrix4 Matrix4::FromOrthographic(float width, float height, float clipNear, float clipFar) {
 		return Matrix4({
@@ -296,6 +266,48 @@ namespace StevEngine::Utilities {
 			{0, 0, -1, 0},
 		});
 	}
+	//Batch operations
+	void Matrix4::TransformPoints(const Matrix4& matrix, std::span<const Vector3> points, std::span<Vector3> out) {
+		const double (&m)[4][4] = matrix.raw;
+		for(size_t i = 0; i < points.size(); i++) {
+			const Vector3& point = points[i];
+			out[i] = Vector3(
+				(point.X * m[0][0]) + (point.Y * m[0][1]) + (point.Z * m[0][2]) + m[0][3],
+				(point.X * m[1][0]) + (point.Y * m[1][1]) + (point.Z * m[1][2]) + m[1][3],
+				(point.X * m[2][0]) + (point.Y * m[2][1]) + (point.Z * m[2][2]) + m[2][3]
+			);
+		}
+	}
+	void Matrix4::Multiply(const Matrix4& left, std::span<const Matrix4> matrices, std::span<Matrix4> out) {
+		//Rows of the left matrix are reused as weights for every matrix
+		Double4 weights[4][4];
+		for(int i = 0; i < 4; i++) for(int j = 0; j < 4; j++) weights[i][j] = Double4::Splat(left.raw[i][j]);
+		for(size_t n = 0; n < matrices.size(); n++) {
+			const Matrix4& matrix = matrices[n];
+			Double4 rows[4] = {
+				Double4::Load(matrix.raw[0]),
+				Double4::Load(matrix.raw[1]),
+				Double4::Load(matrix.raw[2]),
+				Double4::Load(matrix.raw[3])
+			};
+			for(int i = 0; i < 4; i++) {
+				Double4 row = rows[0] * weights[i][0];
+				row = Double4::MulAdd(rows[1], weights[i][1], row);
+				row = Double4::MulAdd(rows[2], weights[i][2], row);
+				row = Double4::MulAdd(rows[3], weights[i][3], row);
+				row.Store(out[n].raw[i]);
+			}
+		}
+	}
+	void Matrix4::FromTranslationRotationScale(std::span<const Vector3> positions, std::span<const Quaternion> rotations, std::span<const Vector3> scales, std::span<Matrix4> out) {
+		for(size_t i = 0; i < positions.size(); i++) out[i] = FromTranslationRotationScale(positions[i], rotations[i], scales[i]);
+	}
+	void Matrix4::ToFloat(std::span<const Matrix4> matrices, std::span<Matrix4f> out) {
+		for(size_t i = 0; i < matrices.size(); i++) out[i] = matrices[i].ToFloat();
+	}
+	void Matrix4::ToFloatRelative(std::span<const Matrix4> matrices, const Vector3& origin, std::span<Matrix4f> out) {
+		for(size_t i = 0; i < matrices.size(); i++) out[i] = matrices[i].ToFloatRelative(origin);
+	}
 	//Static matrices
 	const Matrix4 Matrix4::identity = Matrix4(
 		Vector4(1,0,0,0),
@@ -313,7 +325,10 @@ namespace StevEngine::Utilities {
 	}
 	//Write to stream
 	template <> void Stream::Write<Utilities::Matrix4>(const Utilities::Matrix4& data) {
-		auto raw = data.data();
-		for(int i = 0; i < 4 * 4; i++) *this << raw[i];
+		//Same column order as read
+		for(int i = 0; i < 4; i++) {
+			Vector4 column = data.GetColumn(i);
+			*this << column.W << column.X << column.Y << column.Z;
+		}
 	}
 }
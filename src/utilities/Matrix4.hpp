@@ -2,12 +2,27 @@
 #include "utilities/Quaternion.hpp"
 #include "utilities/Vector4.hpp"
 
+#include <span>
+
 namespace StevEngine::Utilities {
+	/**
+	 * @brief Column major float matrix for uploading to the GPU
+	 *
+	 * Aligned to 16 bytes, so it can be copied into buffers with vector instructions.
+	 */
+	struct alignas(16) Matrix4f {
+		float values[16];  ///< Values, one column after another
+
+		/** @brief Get raw float array */
+		const float* data() const { return values; }
+	};
+
 	/**
 	 * @brief 4x4 matrix for 3D transformations
 	 *
 	 * Implements common matrix operations for 3D transformations including
 	 * translation, rotation, scaling, and projection matrices.
+	 * Values are kept as doubles, and operations use the instruction set selected in SIMD.hpp.
 	 */
 	class Matrix4 {
 		public:
@@ -97,7 +112,17 @@ namespace StevEngine::Utilities {
 
 			//Conversions
 			explicit operator std::string() const;  ///< Convert to string
-			const float* data() const;			 ///< Get raw float array
+			Matrix4f ToFloat() const;			  ///< Convert to column major floats
+
+			/**
+			 * @brief Convert transform to column major floats, with its translation relative to an origin
+			 *
+			 * The translation is subtracted in double precision before converting,
+			 * so transforms far from the world origin keep their precision near the camera.
+			 * @param origin World position to make the translation relative to
+			 * @return Relative float matrix
+			 */
+			Matrix4f ToFloatRelative(const Vector3& origin) const;
 
 			//Static creators
 			/**
@@ -162,6 +187,47 @@ namespace StevEngine::Utilities {
 			 */
 			static Matrix4 FromPerspective(float fovx, float aspect, float clipNear, float clipFar);
 
+			//Batch operations
+			/**
+			 * @brief Transform many points by the same matrix
+			 * @param matrix Transformation matrix
+			 * @param points Points to transform
+			 * @param out Transformed points, at least as many as points
+			 */
+			static void TransformPoints(const Matrix4& matrix, std::span<const Vector3> points, std::span<Vector3> out);
+
+			/**
+			 * @brief Multiply many matrices by the same matrix
+			 * @param left Matrix on the left of every multiplication
+			 * @param matrices Matrices on the right
+			 * @param out Products, at least as many as matrices
+			 */
+			static void Multiply(const Matrix4& left, std::span<const Matrix4> matrices, std::span<Matrix4> out);
+
+			/**
+			 * @brief Create many combined TRS matrices
+			 * @param positions Translations
+			 * @param rotations Rotations, as many as positions
+			 * @param scales Scales, as many as positions
+			 * @param out Combined matrices, at least as many as positions
+			 */
+			static void FromTranslationRotationScale(std::span<const Vector3> positions, std::span<const Quaternion> rotations, std::span<const Vector3> scales, std::span<Matrix4> out);
+
+			/**
+			 * @brief Convert many matrices to column major floats
+			 * @param matrices Matrices to convert
+			 * @param out Converted matrices, at least as many as matrices
+			 */
+			static void ToFloat(std::span<const Matrix4> matrices, std::span<Matrix4f> out);
+
+			/**
+			 * @brief Convert many transforms to column major floats, with translations relative to an origin
+			 * @param matrices Transforms to convert
+			 * @param origin World position to make translations relative to
+			 * @param out Converted matrices, at least as many as matrices
+			 */
+			static void ToFloatRelative(std::span<const Matrix4> matrices, const Vector3& origin, std::span<Matrix4f> out);
+
 			//Static matrices
 			static const Matrix4 identity;  ///< Identity matrix
 			static const Matrix4 zero;	  ///< Zero matrix
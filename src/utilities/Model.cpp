@@ -8,6 +8,8 @@
 #include "utilities/Range3.hpp"
 #include "utilities/Color.hpp"
 #include <cstddef>
+#include <exception>
+#include <unordered_map>
 
 #include "assimp/Importer.hpp"
 #include "assimp/mesh.h"
@@ -17,15 +19,17 @@
 #include "assimp/material.h"
 
 namespace StevEngine::Utilities {
-	Assimp::Importer importer;
-	Model::Model(const Resources::Resource& file) : path(file.path)
+	//Importers keep their scene until the next read, so every thread needs its own
+	thread_local Assimp::Importer importer;
+	Model::Model(const Resources::Resource& file) : Model(file, true) {}
+	Model::Model(const Resources::Resource& file, bool finish, bool loadTextures) : path(file.path)
 	{
 		//Load scene
 		std::string fileType = file.path.substr(file.path.find_last_of('.') + 1);
-		assimpScene = importer.ReadFileFromMemory(file.GetRawData(), file.GetSize(), aiProcess_Triangulate | aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph | aiProcess_GenNormals | aiProcess_GenBoundingBoxes | aiProcess_JoinIdenticalVertices | aiProcess_GenUVCoords | aiProcess_FlipUVs, fileType.c_str());
+		const aiScene* assimpScene = importer.ReadFileFromMemory(file.GetRawData(), file.GetSize(), aiProcess_Triangulate | aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph | aiProcess_GenNormals | aiProcess_GenBoundingBoxes | aiProcess_JoinIdenticalVertices | aiProcess_GenUVCoords | aiProcess_FlipUVs, fileType.c_str());
 		if(!assimpScene || assimpScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !assimpScene->mRootNode) {
 			Log::Error(std::format("Couldn't load {}: {}", file.path, importer.GetErrorString()), true);
-			assimpScene = NULL;
+			importer.FreeScene();
 			return;
 		}
 		#ifdef StevEngine_SHOW_WINDOW
@@ -34,6 +38,9 @@ namespace StevEngine::Utilities {
 
 		//Read meshes
 		meshes.reserve(assimpScene->mNumMeshes);
+		#ifdef StevEngine_SHOW_WINDOW
+		pendingMaterials.reserve(assimpScene->mNumMeshes);
+		#endif
 		for(int i = 0; i < assimpScene->mNumMeshes; i++) {
 			aiMesh* assimpMesh = assimpScene->mMeshes[i];
 			std::vector<Vertex> vertices;
@@ -60,7 +67,7 @@ namespace StevEngine::Utilities {
 			}
 			//Materials
 			#ifdef StevEngine_SHOW_WINDOW
-				Visuals::Material material;
+				MeshMaterialData material = { Utilities::Color(), Utilities::Vector3(1.0), Utilities::Vector3(1.0), Utilities::Vector3(1.0), 32.0f, "", "", Visuals::Texture::empty, Visuals::Texture::empty };
 				if(hasMaterials) {
 					aiMaterial* assimpMaterial = assimpScene->mMaterials[assimpMesh->mMaterialIndex];
 					//Ambient
@@ -80,33 +87,85 @@ namespace StevEngine::Utilities {
 					//Albedo texture
 					aiString albedoPath;
 					bool hasAlbedo = assimpMaterial->GetTexture(aiTextureType_BASE_COLOR, 0, &albedoPath) == AI_SUCCESS;
-					Visuals::Texture albedo = hasAlbedo ? Visuals::Texture(Resources::resourceManager.GetFile(std::string(albedoPath.C_Str()))) : Visuals::Texture::empty;
+					Visuals::Texture albedo = hasAlbedo && loadTextures ? Visuals::Texture(Resources::resourceManager.GetFile(std::string(albedoPath.C_Str()))) : Visuals::Texture::empty;
 					//Normal texture
 					aiString normalPath;
 					bool hasNormal = assimpMaterial->GetTexture(aiTextureType_BASE_COLOR, 0, &normalPath) == AI_SUCCESS;
-					Visuals::Texture normal = hasNormal ? Visuals::Texture(Resources::resourceManager.GetFile(std::string(normalPath.C_Str()))) : Visuals::Texture::empty;
-					//Create material
-					material = Visuals::Material(
+					Visuals::Texture normal = hasNormal && loadTextures ? Visuals::Texture(Resources::resourceManager.GetFile(std::string(normalPath.C_Str()))) : Visuals::Texture::empty;
+					//Material is created once the textures can be uploaded
+					material = {
 						Utilities::Color(diffuse.r, diffuse.g, diffuse.b),
 						Utilities::Vector3(ambient.r, ambient.g, ambient.b),
 						Utilities::Vector3(diffuse.r, diffuse.g, diffuse.b),
 						Utilities::Vector3(specular.r, specular.g, specular.b) * shininessStrength,
 						shininess,
+						hasAlbedo ? std::string(albedoPath.C_Str()) : "",
+						hasNormal ? std::string(normalPath.C_Str()) : "",
 						albedo,
 						normal
-					);
+					};
 				}
 				//Push mesh
-				meshes.emplace_back(vertices, indices, material);
+				pendingMaterials.push_back(material);
+				meshes.emplace_back(vertices, indices, Visuals::Material());
 			#else
 				//Push mesh
 				meshes.emplace_back(vertices, indices);
 			#endif
 		}
+		//Meshes are copied, so the scene is not needed anymore
+		importer.FreeScene();
+		loaded = true;
+		if(finish) FinishMaterials();
+	}
+
+	void Model::FinishMaterials() {
+		#ifdef StevEngine_SHOW_WINDOW
+		for(size_t i = 0; i < pendingMaterials.size(); i++) {
+			const MeshMaterialData& data = pendingMaterials[i];
+			meshes[i].material = Visuals::Material(data.color, data.ambient, data.diffuse, data.specular, data.shininess, data.albedo, data.normal);
+		}
+		pendingMaterials.clear();
+		#endif
+	}
+
+	//Async loading
+	ModelLoad::ModelLoad(const Resources::Resource& file) : path(file.path) {
+		//Jobs can not throw, so errors are logged and leave no model, like files that could not be parsed
+		//Parsing can take seconds, so it runs in the background instead of inside a frame waiting for other jobs
+		job = jobs.ScheduleBackground([this, file] () {
+			try {
+				std::unique_ptr<Model> parsed = std::unique_ptr<Model>(new Model(file, false));
+				if(parsed->IsLoaded()) model = std::move(parsed);
+			} catch(const std::exception& error) {
+				Log::Error(std::format("Couldn't load {}: {}", file.path, error.what()), true);
+			}
+		});
+	}
+
+	ModelLoad::~ModelLoad() {
+		jobs.Wait(job);
+	}
+
+	const Model* ModelLoad::Get() {
+		jobs.Wait(job);
+		if(model && !finished) {
+			model->FinishMaterials();
+			finished = true;
+		}
+		return model.get();
 	}
 
-	std::vector<Mesh> Model::GetMeshes() const {
-		return meshes;
+	ModelHandle LoadModelAsync(const Resources::Resource& file) {
+		static std::unordered_map<std::string, std::weak_ptr<ModelLoad>> loading;
+		std::weak_ptr<ModelLoad>& entry = loading[file.path];
+		ModelHandle handle = entry.lock();
+		if(handle) return handle;
+		handle = std::make_shared<ModelLoad>(file);
+		entry = handle;
+		//Forget loads no longer in use
+		std::erase_if(loading, [] (const auto& load) { return load.second.expired(); });
+		return handle;
 	}
 }
 #endif
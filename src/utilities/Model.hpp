@@ -2,10 +2,12 @@
 #ifdef StevEngine_MODELS
 #include "assimp/scene.h"
 
+#include "main/JobSystem.hpp"
 #include "main/ResourceManager.hpp"
 #include "utilities/Vertex.hpp"
 #include "visuals/Material.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace StevEngine::Utilities {
@@ -37,13 +39,36 @@ namespace StevEngine::Utilities {
 		#endif
 	};
 
+	#ifdef StevEngine_SHOW_WINDOW
+	/**
+	 * @brief Material values read from a model file
+	 *
+	 * Textures are only decoded here, the material is created once they can be uploaded.
+	 */
+	struct MeshMaterialData {
+		Utilities::Color color;			///< Base color tint
+		Utilities::Vector3 ambient;		///< Ambient light reflection
+		Utilities::Vector3 diffuse;		///< Diffuse light reflection
+		Utilities::Vector3 specular;	///< Specular light reflection
+		float shininess;				///< Specular highlight size
+		std::string albedoPath;			///< Resource path of the albedo texture, empty if none
+		std::string normalPath;			///< Resource path of the normal texture, empty if none
+		Visuals::Texture albedo;		///< Albedo/color texture
+		Visuals::Texture normal;		///< Normal map texture
+	};
+	#endif
+
 	/**
 	 * @brief 3D model data container
 	 *
 	 * Loads and stores 3D model data using Assimp.
 	 * Contains multiple meshes with vertices, indices and materials.
+	 * Loading is split into parsing the file, which can run on any thread,
+	 * and finishing the materials, which uploads textures and has to run on the render thread.
 	 */
 	class Model {
+		friend class ModelLoad;
+		friend bool BakeModel(const Resources::Resource& source, const std::string& path);
 		public:
 			/**
 			 * @brief Load model from resource
@@ -63,11 +88,92 @@ namespace StevEngine::Utilities {
 			 * @brief Get all meshes in model
 			 * @return Vector of mesh data
 			 */
-			std::vector<Mesh> GetMeshes() const;
+			const std::vector<Mesh>& GetMeshes() const { return meshes; }
+
+			/**
+			 * @brief Check if the model file was parsed
+			 * @return true if parsed, false if it could not be read and the model has no meshes
+			 */
+			bool IsLoaded() const { return loaded; }
 
 		private:
-			const aiScene* assimpScene;  ///< Assimp scene data
+			/**
+			 * @brief Parse model from resource without creating its materials
+			 * @param file Resource containing model data
+			 * @param finish Whether to create the materials directly
+			 * @param loadTextures Whether to decode the textures, or only read their paths
+			 */
+			Model(const Resources::Resource& file, bool finish, bool loadTextures = true);
+
+			/**
+			 * @brief Create the materials of all meshes, uploading their textures
+			 */
+			void FinishMaterials();
+
 			std::vector<Mesh> meshes;	 ///< Processed mesh data
+			bool loaded = false;		 ///< Whether the model file was parsed
+			#ifdef StevEngine_SHOW_WINDOW
+			std::vector<MeshMaterialData> pendingMaterials;  ///< Material data of each mesh, until the materials are created
+			#endif
+	};
+
+	/**
+	 * @brief Model being loaded on the job system
+	 *
+	 * The file is parsed by a background job on a worker thread, with one importer per thread so several models load in parallel.
+	 * The model is finished on the first call to Get, which has to happen on the render thread.
+	 */
+	class ModelLoad {
+		public:
+			/**
+			 * @brief Start loading model
+			 * @param file Resource containing model data
+			 */
+			ModelLoad(const Resources::Resource& file);
+
+			/**
+			 * @brief Wait for the job to finish, as it writes to this load
+			 */
+			~ModelLoad();
+
+			/** @brief Path to model file */
+			const std::string path;
+
+			/**
+			 * @brief Check if the model file has been parsed, or failed to
+			 * @return true if Get will not have to wait, otherwise false
+			 */
+			bool IsReady() const { return job->IsDone(); }
+
+			/**
+			 * @brief Check if loading failed, because the file could not be parsed or a texture of the model is missing
+			 * @return true if the load is ready and failed, otherwise false
+			 */
+			bool IsFailed() const { return IsReady() && !model; }
+
+			/**
+			 * @brief Get loaded model, waiting for it if it is not parsed yet
+			 * @return Loaded model, or nullptr if loading failed
+			 */
+			const Model* Get();
+
+		private:
+			JobHandle job;					///< Job parsing the file
+			std::unique_ptr<Model> model;	///< Parsed model, set once the job is done, nullptr if it failed
+			bool finished = false;			///< Whether the materials have been created
 	};
+
+	/** @brief Shared handle to a loading model */
+	using ModelHandle = std::shared_ptr<ModelLoad>;
+
+	/**
+	 * @brief Load model in the background
+	 *
+	 * Loads of the same file are shared while any handle to them exists.
+	 * Must be called from the main thread, as the shared loads are not locked.
+	 * @param file Resource containing model data
+	 * @return Handle to the loading model
+	 */
+	ModelHandle LoadModelAsync(const Resources::Resource& file);
 }
 #endif
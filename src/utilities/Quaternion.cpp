@@ -1,6 +1,7 @@
 #include "Quaternion.hpp"
 #include "utilities/Stream.hpp"
 #include "utilities/Vector4.hpp"
+#include "utilities/SIMD.hpp"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -52,15 +53,16 @@ namespace StevEngine::Utilities {
 		return *this;
 	}
 	double Quaternion::Magnitude() const {
-		return sqrt(pow(W, 2) + pow(X, 2) + pow(Y, 2) + pow(Z, 2));
+		return sqrt(W * W + X * X + Y * Y + Z * Z);
 	}
 	Quaternion& Quaternion::Normalize() {
 		double mag = Magnitude();
 		if (mag != 0) {
-			W /= mag;
-			X /= mag;
-			Y /= mag;
-			Z /= mag;
+			double scale = 1 / mag;
+			W *= scale;
+			X *= scale;
+			Y *= scale;
+			Z *= scale;
 		}
 		return *this;
 	}
@@ -92,13 +94,17 @@ namespace StevEngine::Utilities {
 	Quaternion Quaternion::operator - (const Quaternion& other) const {
 		return Quaternion(W - other.W, Vector3(X,Y,Z) - Vector3(other.X, other.Y, other.Z));
 	}
+	static_assert(sizeof(Quaternion) == 4 * sizeof(double), "Quaternion components are loaded as one array");
 	Quaternion Quaternion::operator * (const Quaternion& other) const {
-		return Quaternion(
-			W * other.W - X * other.X - Y * other.Y - Z * other.Z,
-			W * other.X + X * other.W + Y * other.Z - Z * other.Y,
-			W * other.Y - X * other.Z + Y * other.W + Z * other.X,
-			W * other.Z + X * other.Y - Y * other.X + Z * other.W
-		);
+		using SIMD::Double4;
+		//Sum of the other quaternion's components, reordered and weighted by each component of this
+		double out[4];
+		Double4 result = Double4::Load(&other.W) * Double4::Splat(W);
+		result = Double4::MulAdd(Double4::Set(-other.X, other.W, -other.Z, other.Y), Double4::Splat(X), result);
+		result = Double4::MulAdd(Double4::Set(-other.Y, other.Z, other.W, -other.X), Double4::Splat(Y), result);
+		result = Double4::MulAdd(Double4::Set(-other.Z, -other.Y, other.X, other.W), Double4::Splat(Z), result);
+		result.Store(out);
+		return Quaternion(out[0], out[1], out[2], out[3]);
 	}
 	Quaternion Quaternion::operator * (const double& other) const {
 		return Quaternion(
@@ -117,24 +123,22 @@ namespace StevEngine::Utilities {
 		);
 	}
 	Quaternion& Quaternion::operator *= (const Quaternion& other) {
-		double w = W * other.W - X * other.X - Y * other.Y - Z * other.Z;
-		double x = W * other.X + X * other.W + Y * other.Z - Z * other.Y;
-		double y = W * other.Y - X * other.Z + Y * other.W + Z * other.X;
-		double z = W * other.Z + X * other.Y - Y * other.X + Z * other.W;
-
-		W = w;
-		X = x;
-		Y = y;
-		Z = z;
-
-		return *this;
+		return *this = *this * other;
 	}
 	bool Quaternion::operator == (const Quaternion& other) const {
 		return (W == other.W) &&(X == other.X) && (Y == other.Y) && (Z == other.Z);
 	}
 	//Vector operators
 	Vector3 Quaternion::operator*(const Vector3& v) const {
-		return v + Vector3::Cross(Vector3(X, Y, Z), (v * W + Vector3::Cross(Vector3(X, Y, Z), v))) * 2;
+		//v + 2 * cross(q, v * w + cross(q, v)), written out to skip the temporary vectors
+		double tx = 2 * (Y * v.Z - Z * v.Y);
+		double ty = 2 * (Z * v.X - X * v.Z);
+		double tz = 2 * (X * v.Y - Y * v.X);
+		return Vector3(
+			v.X + W * tx + (Y * tz - Z * ty),
+			v.Y + W * ty + (Z * tx - X * tz),
+			v.Z + W * tz + (X * ty - Y * tx)
+		);
 	}
 	//Conversions
 	Quaternion::operator std::string() const {
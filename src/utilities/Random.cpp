@@ -7,6 +7,9 @@ namespace StevEngine::Utilities {
 		srand((unsigned int)time(NULL));
 		return true;
 	}
+	void SetRandomSeed(unsigned int seed) {
+		srand(seed);
+	}
 
 	bool setseed = SetRandomSeed();
 
@@ -32,5 +32,15 @@ namespace StevEngine::Utilities {
 	 */
 	int GetRandomInt(int max);
 
+	/**
+	 * @brief Seed random generator from the current time
+	 * @return true, so it can initialize a global
+	 */
 	const bool SetRandomSeed();
+
+	/**
+	 * @brief Seed random generator with a fixed seed, for reproducible sequences
+	 * @param seed Seed value
+	 */
+	void SetRandomSeed(unsigned int seed);
 }
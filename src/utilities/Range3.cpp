@@ -1,6 +1,9 @@
 #include "Range3.hpp"
 #include "Vector3.hpp"
+#include "Matrix4.hpp"
 #include "utilities/Stream.hpp"
+#include <algorithm>
+#include <cmath>
 #include <format>
 #include <string>
 
@@ -29,6 +32,44 @@ namespace StevEngine::Utilities {
 	Vector3 Range3::GetSize() const {
 		return High - Low;
 	}
+
+	double Range3::GetSurfaceArea() const {
+		Vector3 size = GetSize();
+		return 2 * (size.X * size.Y + size.Y * size.Z + size.Z * size.X);
+	}
+
+	bool Range3::Contains(const Range3& other) const {
+		return Low.X <= other.Low.X && Low.Y <= other.Low.Y && Low.Z <= other.Low.Z
+			&& other.High.X <= High.X && other.High.Y <= High.Y && other.High.Z <= High.Z;
+	}
+
+	bool Range3::Intersects(const Range3& other) const {
+		return Low.X <= other.High.X && Low.Y <= other.High.Y && Low.Z <= other.High.Z
+			&& other.Low.X <= High.X && other.Low.Y <= High.Y && other.Low.Z <= High.Z;
+	}
+
+	Range3 Range3::Expanded(const Vector3& amount) const {
+		return Range3(Low - amount, High + amount);
+	}
+
+	Range3 Range3::Transformed(const Matrix4& matrix) const {
+		//Transform the center, and add up how far each axis of the extents reaches along each new axis
+		Vector3 center = matrix * GetCenter();
+		Vector3 extents = GetSize() / 2;
+		auto reach = [&] (int axis) {
+			Vector4 row = matrix.GetRow(axis);
+			return std::abs(row.W) * extents.X + std::abs(row.X) * extents.Y + std::abs(row.Y) * extents.Z;
+		};
+		Vector3 size = Vector3(reach(0), reach(1), reach(2));
+		return Range3(center - size, center + size);
+	}
+
+	Range3 Range3::Combine(const Range3& a, const Range3& b) {
+		return Range3(
+			Vector3(std::min(a.Low.X, b.Low.X), std::min(a.Low.Y, b.Low.Y), std::min(a.Low.Z, b.Low.Z)),
+			Vector3(std::max(a.High.X, b.High.X), std::max(a.High.Y, b.High.Y), std::max(a.High.Z, b.High.Z))
+		);
+	}
 	//Conversions
 	Range3::operator std::string() const {
 		return std::format("[({}), ({})]", (std::string)Low, (std::string)High);
@@ -7,6 +7,7 @@
 
 namespace StevEngine::Utilities {
 	class Vector3;
+	class Matrix4;
 
 	/**
 	 * @brief Axis-aligned bounding box in 3D space
@@ -54,6 +55,48 @@ namespace StevEngine::Utilities {
 			 */
 			Vector3 GetSize() const;
 
+			/**
+			 * @brief Get surface area of range
+			 * @return Area of the six sides
+			 */
+			double GetSurfaceArea() const;
+
+			/**
+			 * @brief Check if another range is fully inside this range
+			 * @param other Range to check
+			 * @return true if inside or equal
+			 */
+			bool Contains(const Range3& other) const;
+
+			/**
+			 * @brief Check if another range overlaps this range
+			 * @param other Range to check
+			 * @return true if overlapping or touching
+			 */
+			bool Intersects(const Range3& other) const;
+
+			/**
+			 * @brief Get range grown by an amount in every direction
+			 * @param amount Distance to grow along each axis
+			 * @return Grown range
+			 */
+			Range3 Expanded(const Vector3& amount) const;
+
+			/**
+			 * @brief Get smallest range containing this range after a transformation
+			 * @param matrix Transformation matrix
+			 * @return Transformed range
+			 */
+			Range3 Transformed(const Matrix4& matrix) const;
+
+			/**
+			 * @brief Get smallest range containing two ranges
+			 * @param a First range
+			 * @param b Second range
+			 * @return Combined range
+			 */
+			static Range3 Combine(const Range3& a, const Range3& b);
+
 			//Conversions
 			explicit operator std::string() const; 			///< Convert to string
 			#ifdef StevEngine_PHYSICS
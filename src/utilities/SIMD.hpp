@@ -0,0 +1,211 @@
+#pragma once
+
+//Select instruction set, unless the scalar fallback is forced
+#if defined(StevEngine_SCALAR_MATH)
+#elif defined(__AVX__)
+#define StevEngine_SIMD_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define StevEngine_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define StevEngine_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace StevEngine::Utilities::SIMD {
+	/** @brief Name of the instruction set used by the math types */
+	#if defined(StevEngine_SIMD_AVX)
+	inline constexpr const char* backend = "AVX";
+	#elif defined(StevEngine_SIMD_SSE2)
+	inline constexpr const char* backend = "SSE2";
+	#elif defined(StevEngine_SIMD_NEON)
+	inline constexpr const char* backend = "NEON";
+	#else
+	inline constexpr const char* backend = "Scalar";
+	#endif
+
+	/**
+	 * @brief Four doubles operated on together
+	 *
+	 * Wraps a 256 bit register with AVX, or a pair of 128 bit registers with SSE2 and NEON.
+	 * Without either, the same operations run on a plain array.
+	 * Loads and stores are unaligned, so any double array can be used.
+	 */
+	struct Double4 {
+		#if defined(StevEngine_SIMD_AVX)
+		__m256d v;
+		#elif defined(StevEngine_SIMD_SSE2)
+		__m128d lo, hi;
+		#elif defined(StevEngine_SIMD_NEON)
+		float64x2_t lo, hi;
+		#else
+		double v[4];
+		#endif
+
+		/**
+		 * @brief Load four consecutive doubles
+		 * @param values Values to load
+		 * @return Loaded values
+		 */
+		static Double4 Load(const double* values) {
+			Double4 result;
+			#if defined(StevEngine_SIMD_AVX)
+			result.v = _mm256_loadu_pd(values);
+			#elif defined(StevEngine_SIMD_SSE2)
+			result.lo = _mm_loadu_pd(values);
+			result.hi = _mm_loadu_pd(values + 2);
+			#elif defined(StevEngine_SIMD_NEON)
+			result.lo = vld1q_f64(values);
+			result.hi = vld1q_f64(values + 2);
+			#else
+			for (int i = 0; i < 4; i++) result.v[i] = values[i];
+			#endif
+			return result;
+		}
+
+		/**
+		 * @brief Create from separate values
+		 * @return Values in order
+		 */
+		static Double4 Set(double a, double b, double c, double d) {
+			Double4 result;
+			#if defined(StevEngine_SIMD_AVX)
+			result.v = _mm256_setr_pd(a, b, c, d);
+			#elif defined(StevEngine_SIMD_SSE2)
+			result.lo = _mm_setr_pd(a, b);
+			result.hi = _mm_setr_pd(c, d);
+			#elif defined(StevEngine_SIMD_NEON)
+			double values[4] = { a, b, c, d };
+			result.lo = vld1q_f64(values);
+			result.hi = vld1q_f64(values + 2);
+			#else
+			result.v[0] = a; result.v[1] = b; result.v[2] = c; result.v[3] = d;
+			#endif
+			return result;
+		}
+
+		/**
+		 * @brief Create with the same value in every lane
+		 * @param value Value to repeat
+		 * @return Repeated value
+		 */
+		static Double4 Splat(double value) {
+			Double4 result;
+			#if defined(StevEngine_SIMD_AVX)
+			result.v = _mm256_set1_pd(value);
+			#elif defined(StevEngine_SIMD_SSE2)
+			result.lo = result.hi = _mm_set1_pd(value);
+			#elif defined(StevEngine_SIMD_NEON)
+			result.lo = result.hi = vdupq_n_f64(value);
+			#else
+			for (int i = 0; i < 4; i++) result.v[i] = value;
+			#endif
+			return result;
+		}
+
+		/**
+		 * @brief Store four consecutive doubles
+		 * @param out Array to store in
+		 */
+		void Store(double* out) const {
+			#if defined(StevEngine_SIMD_AVX)
+			_mm256_storeu_pd(out, v);
+			#elif defined(StevEngine_SIMD_SSE2)
+			_mm_storeu_pd(out, lo);
+			_mm_storeu_pd(out + 2, hi);
+			#elif defined(StevEngine_SIMD_NEON)
+			vst1q_f64(out, lo);
+			vst1q_f64(out + 2, hi);
+			#else
+			for (int i = 0; i < 4; i++) out[i] = v[i];
+			#endif
+		}
+
+		/**
+		 * @brief Convert to floats and store them
+		 * @param out Array to store in
+		 */
+		void StoreFloat(float* out) const {
+			#if defined(StevEngine_SIMD_AVX)
+			_mm_storeu_ps(out, _mm256_cvtpd_ps(v));
+			#elif defined(StevEngine_SIMD_SSE2)
+			_mm_storeu_ps(out, _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+			#elif defined(StevEngine_SIMD_NEON)
+			vst1q_f32(out, vcombine_f32(vcvt_f32_f64(lo), vcvt_f32_f64(hi)));
+			#else
+			for (int i = 0; i < 4; i++) out[i] = (float)v[i];
+			#endif
+		}
+
+		/**
+		 * @brief Multiply and add
+		 * @return a * b + c
+		 */
+		static Double4 MulAdd(const Double4& a, const Double4& b, const Double4& c) {
+			Double4 result;
+			#if defined(StevEngine_SIMD_AVX) && defined(__FMA__)
+			result.v = _mm256_fmadd_pd(a.v, b.v, c.v);
+			#elif defined(StevEngine_SIMD_AVX)
+			result.v = _mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v);
+			#elif defined(StevEngine_SIMD_SSE2)
+			result.lo = _mm_add_pd(_mm_mul_pd(a.lo, b.lo), c.lo);
+			result.hi = _mm_add_pd(_mm_mul_pd(a.hi, b.hi), c.hi);
+			#elif defined(StevEngine_SIMD_NEON)
+			result.lo = vfmaq_f64(c.lo, a.lo, b.lo);
+			result.hi = vfmaq_f64(c.hi, a.hi, b.hi);
+			#else
+			for (int i = 0; i < 4; i++) result.v[i] = a.v[i] * b.v[i] + c.v[i];
+			#endif
+			return result;
+		}
+
+		Double4 operator+ (const Double4& other) const {
+			Double4 result;
+			#if defined(StevEngine_SIMD_AVX)
+			result.v = _mm256_add_pd(v, other.v);
+			#elif defined(StevEngine_SIMD_SSE2)
+			result.lo = _mm_add_pd(lo, other.lo);
+			result.hi = _mm_add_pd(hi, other.hi);
+			#elif defined(StevEngine_SIMD_NEON)
+			result.lo = vaddq_f64(lo, other.lo);
+			result.hi = vaddq_f64(hi, other.hi);
+			#else
+			for (int i = 0; i < 4; i++) result.v[i] = v[i] + other.v[i];
+			#endif
+			return result;
+		}
+
+		Double4 operator- (const Double4& other) const {
+			Double4 result;
+			#if defined(StevEngine_SIMD_AVX)
+			result.v = _mm256_sub_pd(v, other.v);
+			#elif defined(StevEngine_SIMD_SSE2)
+			result.lo = _mm_sub_pd(lo, other.lo);
+			result.hi = _mm_sub_pd(hi, other.hi);
+			#elif defined(StevEngine_SIMD_NEON)
+			result.lo = vsubq_f64(lo, other.lo);
+			result.hi = vsubq_f64(hi, other.hi);
+			#else
+			for (int i = 0; i < 4; i++) result.v[i] = v[i] - other.v[i];
+			#endif
+			return result;
+		}
+
+		Double4 operator* (const Double4& other) const {
+			Double4 result;
+			#if defined(StevEngine_SIMD_AVX)
+			result.v = _mm256_mul_pd(v, other.v);
+			#elif defined(StevEngine_SIMD_SSE2)
+			result.lo = _mm_mul_pd(lo, other.lo);
+			result.hi = _mm_mul_pd(hi, other.hi);
+			#elif defined(StevEngine_SIMD_NEON)
+			result.lo = vmulq_f64(lo, other.lo);
+			result.hi = vmulq_f64(hi, other.hi);
+			#else
+			for (int i = 0; i < 4; i++) result.v[i] = v[i] * other.v[i];
+			#endif
+			return result;
+		}
+	};
+}
@@ -83,12 +83,8 @@ namespace StevEngine::Utilities {
 	Vector3::operator std::string() const {
 		return std::format("[{}, {}, {}]", X, Y, Z);
 	}
-	const float* Vector3::data() const {
-		float* data = new float[3];
-		data[0] = (float)X;
-		data[1] = (float)Y;
-		data[2] = (float)Z;
-		return data;
+	Vector3f Vector3::ToFloat() const {
+		return { (float)X, (float)Y, (float)Z };
 	}
 	#ifdef StevEngine_PHYSICS
 	Vector3::operator JPH::DVec3() const {
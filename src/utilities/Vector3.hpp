@@ -8,6 +8,18 @@
 namespace StevEngine::Utilities {
 	class Vector2;
 
+	/**
+	 * @brief Float vector for uploading to the GPU
+	 *
+	 * Render side values are floats relative to the camera, while world positions stay as doubles in Vector3.
+	 */
+	struct Vector3f {
+		float X, Y, Z;  ///< Vector components
+
+		/** @brief Get raw float array */
+		const float* data() const { return &X; }
+	};
+
 	/**
 	 * @brief 3D vector class
 	 *
@@ -64,7 +76,7 @@ namespace StevEngine::Utilities {
 			//Conversions
 			explicit operator Vector2() const;		///< Convert to Vector2
 			explicit operator std::string() const;	///< Convert to string
-			const float* data() const;			   ///< Get raw float array
+			Vector3f ToFloat() const;				///< Convert to float vector
 
 			#ifdef StevEngine_PHYSICS
 			operator JPH::DVec3() const;					///< Convert to Jolt double vector
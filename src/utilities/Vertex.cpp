@@ -1,7 +1,63 @@
 #include "Vertex.hpp"
 
+#include <array>
+#include <cmath>
+#include <unordered_map>
+
 namespace StevEngine::Utilities {
 	bool Vertex::operator== (const Vertex o) const {
 		return o.position == position && o.uv == uv && o.normal == normal && o.tangent == tangent;
 	}
+
+	//Welding
+	using WeldKey = std::array<int64_t, VERTEX_COUNT>;
+	struct WeldKeyHash {
+		size_t operator() (const WeldKey& key) const {
+			size_t hash = 0;
+			for(int64_t value : key) hash = (hash ^ std::hash<int64_t>()(value)) * 1099511628211ULL;
+			return hash;
+		}
+	};
+
+	std::vector<Vertex> WeldVertices(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+		std::vector<Vertex> unique;
+		std::unordered_map<WeldKey, uint32_t, WeldKeyHash> lookup;
+		lookup.reserve(vertices.size());
+		indices.clear();
+		indices.reserve(vertices.size());
+		auto round = [] (double value) { return (int64_t)std::llround(value * VERTEX_WELD_PRECISION); };
+		for(const Vertex& v : vertices) {
+			WeldKey key = {
+				round(v.position.X), round(v.position.Y), round(v.position.Z),
+				round(v.uv.X), round(v.uv.Y),
+				round(v.normal.X), round(v.normal.Y), round(v.normal.Z),
+				round(v.tangent.X), round(v.tangent.Y), round(v.tangent.Z)
+			};
+			auto [entry, added] = lookup.try_emplace(key, unique.size());
+			if(added) unique.push_back(v);
+			indices.push_back(entry->second);
+		}
+		return unique;
+	}
+
+	std::vector<float> ToFloatList(const std::vector<Vertex>& vertices) {
+		std::vector<float> result;
+		result.resize(vertices.size() * VERTEX_COUNT);
+		int j = 0;
+		for(int i = 0; i < vertices.size(); i++) {
+			const Vertex& vertex = vertices[i];
+			result[j++] = vertex.position.X;
+			result[j++] = vertex.position.Y;
+			result[j++] = vertex.position.Z;
+			result[j++] = vertex.uv.X;
+			result[j++] = vertex.uv.Y;
+			result[j++] = vertex.normal.X;
+			result[j++] = vertex.normal.Y;
+			result[j++] = vertex.normal.Z;
+			result[j++] = vertex.tangent.X;
+			result[j++] = vertex.tangent.Y;
+			result[j++] = vertex.tangent.Z;
+		}
+		return result;
+	}
 }
@@ -2,6 +2,8 @@
 #include "utilities/Vector2.hpp"
 #include "utilities/Vector3.hpp"
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace StevEngine::Utilities {
 	/** @brief Number of floats per vertex */
@@ -9,6 +11,8 @@ namespace StevEngine::Utilities {
 
 	/** @brief Total size of vertex in bytes */
 	const size_t VERTEX_SIZE = (VERTEX_COUNT) * sizeof(float);
+	/** @brief Steps per unit vertex attributes are rounded to when welding */
+	const double VERTEX_WELD_PRECISION = 1e5;
 
 	/**
 	 * @brief 3D mesh vertex data structure
@@ -42,4 +46,21 @@ namespace StevEngine::Utilities {
 		 */
 		bool operator==(const Vertex o) const;
 	};
+
+	/**
+	 * @brief Merge vertices with the same attributes
+	 *
+	 * Attributes are rounded to VERTEX_WELD_PRECISION and looked up in a hash map, so it takes linear time.
+	 * @param vertices Vertices to merge
+	 * @param indices Filled with the index of each vertex in the merged vertices
+	 * @return Merged vertices, in order of first use
+	 */
+	std::vector<Vertex> WeldVertices(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+	/**
+	 * @brief Convert vertices to the layout uploaded to the GPU
+	 * @param vertices Vertices to convert
+	 * @return VERTEX_COUNT floats per vertex
+	 */
+	std::vector<float> ToFloatList(const std::vector<Vertex>& vertices);
 }
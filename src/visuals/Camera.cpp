@@ -39,6 +39,10 @@ namespace StevEngine::Visuals {
 		return rotation * translation;
 	}
 
+	Matrix4 Camera::GetRelativeView() const {
+		return Matrix4::FromRotation(Quaternion::Conjugate(GetParent().GetWorldRotation()));
+	}
+
 	Matrix4 Camera::GetProjection() const {
 		GameSettings s = engine->GetGameSettings();
 		float aspect = (float)s.WIDTH / s.HEIGHT;
@@ -50,6 +50,14 @@ namespace StevEngine {
 				 */
 				Utilities::Matrix4 GetView() const;
 
+				/**
+				 * @brief Get view matrix for positions relative to the camera
+				 *
+				 * Only rotates, as the camera is at the origin of relative positions.
+				 * @return Relative view transformation matrix
+				 */
+				Utilities::Matrix4 GetRelativeView() const;
+
 				/**
 				 * @brief Get projection matrix for camera
 				 * @return Projection matrix based on current settings
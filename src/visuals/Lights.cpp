@@ -5,97 +5,70 @@
 #include "main/Component.hpp"
 #include "utilities/Vector3.hpp"
 
+#include <algorithm>
+#include <cmath>
+
+//Smallest visible change of a color channel
+#define LIGHT_CUTOFF (1.0 / 256)
+
 using namespace StevEngine::Renderer;
 
 namespace StevEngine::Visuals {
-	Light::Light(uint32_t shaderID, Utilities::Vector3 diffuse, Utilities::Vector3 specular, std::string type)
-	  : shaderLightID(shaderID), diffuse(diffuse), specular(specular) {};
+	Light::Light(Utilities::Vector3 diffuse, Utilities::Vector3 specular, std::string type)
+	  : diffuse(diffuse), specular(specular) {};
 	//Create light components
 	DirectionalLight::DirectionalLight(Utilities::Vector3 diffuse, Utilities::Vector3 specular)
-	  : Light(Renderer::render.GetLightID("DirectionalLight"), diffuse, specular, "DirectionalLight") {
+	  : Light(diffuse, specular, "DirectionalLight") {
 		Renderer::render.AddLight((Light*)this);
 	}
 	PointLight::PointLight(Utilities::Vector3 diffuse, Utilities::Vector3 specular, float constant, float linear, float quadratic)
-	  : Light(Renderer::render.GetLightID("PointLight"), diffuse, specular, "PointLight"), constant(constant), linear(linear), quadratic(quadratic) {
+	  : Light(diffuse, specular, "PointLight"), constant(constant), linear(linear), quadratic(quadratic) {
 		Renderer::render.AddLight(this);
 	}
 	SpotLight::SpotLight(Utilities::Vector3 diffuse, Utilities::Vector3 specular, float cutOff, float outerCutOff)
-	  : Light(Renderer::render.GetLightID("SpotLight"), diffuse, specular, "SpotLight"), cutOff(cutOff), outerCutOff(outerCutOff) {
+	  : Light(diffuse, specular, "SpotLight"), cutOff(cutOff), outerCutOff(outerCutOff) {
 		Renderer::render.AddLight(this);
 	}
 	//Update shader information functions
-	void DirectionalLight::UpdateShader(const ShaderProgram& program) const {
-		std::string part = "directionalLights[" + std::to_string(shaderLightID) + "].";
-		program.SetShaderUniform((part + "basic.diffuse").c_str(), diffuse);
-		program.SetShaderUniform((part + "basic.specular").c_str(), specular);
-
-		program.SetShaderUniform((part + "direction").c_str(), GetParent().GetWorldRotation().Forward());
-	}
-	void DirectionalLight::ResetShader(const ShaderProgram& program) const {
-		std::string part = "directionalLights[" + std::to_string(shaderLightID) + "].";
-		program.SetShaderUniform((part + "basic.diffuse").c_str(), Utilities::Vector3());
-		program.SetShaderUniform((part + "basic.specular").c_str(), Utilities::Vector3());
-
-		program.SetShaderUniform((part + "direction").c_str(), Utilities::Vector3());
-	}
-	DirectionalLight::~DirectionalLight() {
-		ResetShader(render.GetDefaultFragmentShaderProgram());
-	}
-	void PointLight::UpdateShader(const ShaderProgram& program) const {
-		std::string part = "pointLights[" + std::to_string(shaderLightID) + "].";
-		program.SetShaderUniform((part + "basic.diffuse").c_str(), diffuse);
-		program.SetShaderUniform((part + "basic.specular").c_str(), specular);
-
-		program.SetShaderUniform((part + "position").c_str(), GetParent().GetWorldPosition());
-
-		program.SetShaderUniform((part + "constant").c_str(), constant);
-		program.SetShaderUniform((part + "linear").c_str(), linear);
-		program.SetShaderUniform((part + "quadratic").c_str(), quadratic);
-	}
-	void PointLight::ResetShader(const ShaderProgram& program) const {
-		std::string part = "pointLights[" + std::to_string(shaderLightID) + "].";
-		program.SetShaderUniform((part + "basic.diffuse").c_str(), Utilities::Vector3());
-		program.SetShaderUniform((part + "basic.specular").c_str(), Utilities::Vector3());
-
-		program.SetShaderUniform((part + "position").c_str(), Utilities::Vector3());
-
-		program.SetShaderUniform((part + "constant").c_str(), 0);
-		program.SetShaderUniform((part + "linear").c_str(), 0);
-		program.SetShaderUniform((part + "quadratic").c_str(), 0);
-	}
-	PointLight::~PointLight() {
-		ResetShader(render.GetDefaultFragmentShaderProgram());
-	}
-	void SpotLight::UpdateShader(const ShaderProgram& program) const {
-		std::string part = "spotLights[" + std::to_string(shaderLightID) + "].";
-		program.SetShaderUniform((part + "basic.diffuse").c_str(), diffuse);
-		program.SetShaderUniform((part + "basic.specular").c_str(), specular);
-
-		program.SetShaderUniform((part + "position").c_str(), GetParent().GetWorldPosition());
-		program.SetShaderUniform((part + "position").c_str(), GetParent().GetWorldRotation().Forward());
-
-		program.SetShaderUniform((part + "cutOff").c_str(), cutOff);
-		program.SetShaderUniform((part + "outerCutOff").c_str(), outerCutOff);
-	}
-	void SpotLight::ResetShader(const ShaderProgram& program) const {
-		std::string part = "spotLights[" + std::to_string(shaderLightID) + "].";
-		program.SetShaderUniform((part + "basic.diffuse").c_str(), Utilities::Vector3());
-		program.SetShaderUniform((part + "basic.specular").c_str(), Utilities::Vector3());
-
-		program.SetShaderUniform((part + "position").c_str(), Utilities::Vector3());
-		program.SetShaderUniform((part + "direction").c_str(), Utilities::Vector3());
-
-		program.SetShaderUniform((part + "cutOff").c_str(), 0);
-		program.SetShaderUniform((part + "outerCutOff").c_str(), 0);
-	}
-	SpotLight::~SpotLight() {
-		ResetShader(render.GetDefaultFragmentShaderProgram());
+	void DirectionalLight::UpdateShader(FrameLights& lights) const {
+		DirectionalLightData& data = lights.directionalLights.emplace_back();
+		data.direction = GetParent().GetWorldRotation().Forward().ToFloat();
+		data.diffuse = diffuse.ToFloat();
+		data.specular = specular.ToFloat();
+	}
+	float PointLight::GetRange() const {
+		//Solve constant + linear * d + quadratic * d^2 = brightest / cutoff
+		double brightest = std::max({ diffuse.X, diffuse.Y, diffuse.Z, specular.X, specular.Y, specular.Z });
+		double a = brightest / LIGHT_CUTOFF;
+		if(a <= constant) return 0;
+		if(quadratic > 0) return (-linear + std::sqrt(linear * linear + 4 * quadratic * (a - constant))) / (2 * quadratic);
+		if(linear > 0) return (a - constant) / linear;
+		return INFINITY;
+	}
+	void PointLight::UpdateShader(FrameLights& lights) const {
+		lights.pointLightRanges.push_back(GetRange());
+		PointLightData& data = lights.pointLights.emplace_back();
+		data.position = (GetParent().GetWorldPosition() - render.GetRenderOrigin()).ToFloat();
+		data.diffuse = diffuse.ToFloat();
+		data.specular = specular.ToFloat();
+		data.constant = constant;
+		data.linear = linear;
+		data.quadratic = quadratic;
+	}
+	void SpotLight::UpdateShader(FrameLights& lights) const {
+		SpotLightData& data = lights.spotLights.emplace_back();
+		data.position = (GetParent().GetWorldPosition() - render.GetRenderOrigin()).ToFloat();
+		data.direction = GetParent().GetWorldRotation().Forward().ToFloat();
+		data.diffuse = diffuse.ToFloat();
+		data.specular = specular.ToFloat();
+		data.cutOff = cutOff;
+		data.outerCutOff = outerCutOff;
 	}
 	Light::~Light() {
 		Renderer::render.RemoveLight(this);
 	}
 	//Export/Import lights
-	Light::Light(Utilities::Stream& stream, std::string type) : shaderLightID(Renderer::render.GetLightID(type)) {
+	Light::Light(Utilities::Stream& stream, std::string type) {
 		stream >> diffuse >> specular;
 	}
 	DirectionalLight::DirectionalLight(Utilities::Stream& stream) : Light(stream, DIRECTIONAL_LIGHT_TYPE) {
@@ -2,7 +2,7 @@
 #ifdef StevEngine_RENDERER_GL
 #include "main/Component.hpp"
 #include "utilities/Vector3.hpp"
-#include "visuals/shaders/ShaderProgram.hpp"
+#include "visuals/renderer/LightClusters.hpp"
 
 #define DIRECTIONAL_LIGHT_TYPE "DirectionalLight"
 #define POINT_LIGHT_TYPE "PointLight"
@@ -21,27 +21,14 @@ namespace StevEngine::Visuals {
 			Utilities::Vector3 specular;	///< Specular light color
 
 			/**
-			 * @brief Update shader uniforms for this light
-			 * @param program Shader program to update
+			 * @brief Add this light to the lights of the frame
+			 * @param lights Lights of the frame to add to
 			 */
-			virtual void UpdateShader(const Renderer::ShaderProgram& program) const = 0;
-
-			/**
-			 * @brief Reset shader uniforms for this light
-			 * @param program Shader program to reset
-			 */
-			virtual void ResetShader(const Renderer::ShaderProgram& program) const = 0;
-
-			/**
-			 * @brief Get shader light ID
-			 * @return Light index in shader
-			 */
-			uint32_t GetShaderLightID() const { return shaderLightID; }
+			virtual void UpdateShader(Renderer::FrameLights& lights) const = 0;
 
 		protected:
-			Light(uint32_t shaderID, Utilities::Vector3 diffuse, Utilities::Vector3 specular, std::string type);
+			Light(Utilities::Vector3 diffuse, Utilities::Vector3 specular, std::string type);
 			Light(Utilities::Stream& stream, std::string type);
-			const uint32_t shaderLightID;  ///< Light index in shader
 			virtual ~Light();
 	};
 
@@ -79,9 +66,7 @@ namespace StevEngine::Visuals {
 			 */
 			Utilities::Stream Export(Utilities::StreamType type) const;
 
-			void UpdateShader(const Renderer::ShaderProgram& program) const;
-			void ResetShader(const Renderer::ShaderProgram& program) const;
-			~DirectionalLight();
+			void UpdateShader(Renderer::FrameLights& lights) const;
 	};
 
 	/**
@@ -125,9 +110,15 @@ namespace StevEngine::Visuals {
 			float linear;	 ///< Linear attenuation factor
 			float quadratic;  ///< Quadratic attenuation factor
 
-			void UpdateShader(const Renderer::ShaderProgram& program) const;
-			void ResetShader(const Renderer::ShaderProgram& program) const;
-			~PointLight();
+			/**
+			 * @brief Get distance the light reaches
+			 *
+			 * Past it the attenuated light is below the smallest visible color step, so fragments further away skip the light.
+			 * @return Distance, infinite if the light does not attenuate
+			 */
+			float GetRange() const;
+
+			void UpdateShader(Renderer::FrameLights& lights) const;
 	};
 
 	/**
@@ -169,9 +160,7 @@ namespace StevEngine::Visuals {
 			float cutOff;		///< Inner cone angle in degrees
 			float outerCutOff;   ///< Outer cone angle in degrees
 
-			void UpdateShader(const Renderer::ShaderProgram& program) const;
-			void ResetShader(const Renderer::ShaderProgram& program) const;
-			~SpotLight();
+			void UpdateShader(Renderer::FrameLights& lights) const;
 	};
 
 	// Register light components
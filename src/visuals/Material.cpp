@@ -33,6 +33,16 @@ namespace StevEngine::Visuals {
 	void Material::FreeNormal() {
 		if(normal.IsBound()) normal.FreeTexture();
 	}
+
+	//Comparison
+	static bool SameTexture(const Texture& a, const Texture& b) {
+		if(a.IsBound() != b.IsBound()) return false;
+		return !a.IsBound() || a.GetGLLocation() == b.GetGLLocation();
+	}
+	bool Material::SharesShadingWith(const Material& other) const {
+		return ambient == other.ambient && diffuse == other.diffuse && specular == other.specular && shininess == other.shininess
+			&& SameTexture(albedo, other.albedo) && SameTexture(normal, other.normal);
+	}
 }
 
 namespace StevEngine::Utilities {
@@ -64,7 +64,7 @@ namespace StevEngine::Visuals {
 			void SetAlbedo(const Texture& textureData);
 
 			/**
-			 * @brief Free albedo texture resources
+			 * @brief Free albedo texture resources, once no other material uses them
 			 */
 			void FreeAlbedo();
 
@@ -81,10 +81,19 @@ namespace StevEngine::Visuals {
 			void SetNormal(const Texture& normalData);
 
 			/**
-			 * @brief Free normal map resources
+			 * @brief Free normal map resources, once no other material uses them
 			 */
 			void FreeNormal();
 
+			/**
+			 * @brief Check if materials only differ in color
+			 *
+			 * Objects with such materials can be drawn together, with the color passed per instance.
+			 * @param other Material to compare with
+			 * @return Whether everything but the color is the same
+			 */
+			bool SharesShadingWith(const Material& other) const;
+
 		private:
 			Texture albedo = Texture::empty;  ///< Albedo/color texture
 			Texture normal = Texture::empty;  ///< Normal map texture
@@ -4,9 +4,11 @@
 
 #include "utilities/Stream.hpp"
 #include "visuals/renderer/RenderSystem.hpp"
+#include "visuals/renderer/MeshAssets.hpp"
 #include "visuals/renderer/Object.hpp"
 #include "visuals/Material.hpp"
 #include "utilities/Model.hpp"
+#include <format>
 #include <vector>
 
 using namespace StevEngine::Renderer;
@@ -16,25 +18,53 @@ namespace StevEngine::Visuals {
 		std::vector<Renderer::Object> objects;
 		const auto& meshes = model.GetMeshes();
 		objects.reserve(meshes.size());
-		for(const auto& mesh : meshes) {
-			std::vector<Utilities::Vertex> vertices;
-			vertices.reserve(mesh.vertices.size());
-			std::vector<uint32_t> indices;
-			indices.reserve(mesh.indices.size());
-
-			vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
-			indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
-
-			objects.push_back(Renderer::Object(vertices, indices, model.hasMaterials ? mesh.material : material));
+		for(size_t i = 0; i < meshes.size(); i++) {
+			//Every renderer of the model shares the geometry of each mesh
+			const Utilities::Mesh& mesh = meshes[i];
+			std::shared_ptr<ObjectGeometry> geometry = meshAssets.Get(std::format("{}#{}", model.path, i), [&mesh] () {
+				return std::make_shared<ObjectGeometry>(mesh.vertices, mesh.indices);
+			});
+			objects.emplace_back(geometry, model.hasMaterials ? mesh.material : material);
+		}
+		return objects;
+	}
+	std::vector<Renderer::Object> CreateRenderObjects(const std::shared_ptr<const Utilities::BakedModel>& file, const Material& material) {
+		const Utilities::BakedModel& model = *file;
+		std::vector<Renderer::Object> objects;
+		objects.reserve(model.GetMeshCount());
+		for(uint32_t i = 0; i < model.GetMeshCount(); i++) {
+			//Same names as parsed models, so both share the geometry
+			Utilities::BakedMesh mesh = model.GetMesh(i);
+			std::shared_ptr<ObjectGeometry> geometry = meshAssets.Get(std::format("{}#{}", model.GetSourcePath(), i), [&mesh, &file] () {
+				return std::make_shared<ObjectGeometry>(mesh.vertices, mesh.indices, mesh.bounds, file);
+			});
+			if(!model.HasMaterials()) {
+				objects.emplace_back(geometry, material);
+				continue;
+			}
+			const Utilities::BakedMeshHeader& values = *mesh.header;
+			objects.emplace_back(geometry, Material(
+				Utilities::Color(values.color[0], values.color[1], values.color[2], values.color[3]),
+				Utilities::Vector3(values.ambient[0], values.ambient[1], values.ambient[2]),
+				Utilities::Vector3(values.diffuse[0], values.diffuse[1], values.diffuse[2]),
+				Utilities::Vector3(values.specular[0], values.specular[1], values.specular[2]),
+				values.shininess,
+				mesh.albedoPath.empty() ? Texture::empty : Texture(Resources::resourceManager.GetFile(std::string(mesh.albedoPath))),
+				mesh.normalPath.empty() ? Texture::empty : Texture(Resources::resourceManager.GetFile(std::string(mesh.normalPath)))
+			));
 		}
 		return objects;
 	}
 	ModelRenderer::ModelRenderer(const Utilities::Model& model, const Material& material, Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale)
-	  : model(model), objects(CreateRenderObjects(model, material)) {}
+	  : position(position), rotation(rotation), scale(scale), modelPath(model.path), defaultMaterial(material), objects(CreateRenderObjects(model, material)) {}
+	ModelRenderer::ModelRenderer(std::shared_ptr<const Utilities::BakedModel> model, const Material& material, Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale)
+	  : position(position), rotation(rotation), scale(scale), modelPath(model->GetSourcePath()), defaultMaterial(material), objects(CreateRenderObjects(model, material)) {}
+	ModelRenderer::ModelRenderer(Utilities::ModelHandle model, const Material& material, Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale)
+	  : position(position), rotation(rotation), scale(scale), modelPath(model->path), defaultMaterial(material), loading(model) {}
 	ModelRenderer::ModelRenderer(Utilities::Stream& stream)
-	  : model(Utilities::Model(Resources::resourceManager.GetFile(stream.Read<std::string>()))),
-		objects(CreateRenderObjects(model,
-		Material(stream.Read<Material>())))
+	  : modelPath(stream.Read<std::string>()),
+		defaultMaterial(stream.Read<Material>()),
+		loading(Utilities::LoadModelAsync(Resources::resourceManager.GetFile(modelPath)))
 	{
 		uint32_t shaderCount = stream.Read<uint32_t>();
 		for(int i = 0; i < shaderCount; i++)
@@ -43,7 +73,7 @@ namespace StevEngine::Visuals {
 
 	Utilities::Stream ModelRenderer::Export(Utilities::StreamType type) const {
 		Utilities::Stream stream(type);
-		stream << model.path << position << rotation << scale;
+		stream << modelPath << position << rotation << scale;
 		stream << (uint32_t)shaders.size();
 		for(auto&[_, program] : shaders)
 			stream << program.Export(type);
@@ -57,8 +87,23 @@ namespace StevEngine::Visuals {
 			object.material.FreeNormal();
 		}
 	}
+	void ModelRenderer::FinishLoading() {
+		//Textures are uploaded here, so this has to run on the render thread
+		//Models that failed to load are drawn as nothing
+		const Utilities::Model* model = loading->Get();
+		if(model) objects = CreateRenderObjects(*model, defaultMaterial);
+		loading.reset();
+		for(auto& object : objects) {
+			for(auto&[_, program] : shaders) object.AddShader(program);
+		}
+	}
 	//Main draw function
 	void ModelRenderer::Draw(const Utilities::Matrix4& transform) {
+		//Keep drawing nothing until the model is parsed
+		if(loading) {
+			if(!loading->IsReady()) return;
+			FinishLoading();
+		}
 		//New transform
 		Utilities::Matrix4 trnsfm = Utilities::Matrix4::FromTranslationRotationScale(position, rotation, scale) * transform;
 		//Draw objects
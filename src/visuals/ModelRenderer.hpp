@@ -1,6 +1,7 @@
 #pragma once
 #ifdef StevEngine_RENDERER_GL
 #include "main/Component.hpp"
+#include "utilities/BakedModel.hpp"
 #include "utilities/Model.hpp"
 #include "utilities/Quaternion.hpp"
 #include "utilities/Vector3.hpp"
@@ -16,6 +17,7 @@ namespace StevEngine::Visuals {
 	 *
 	 * Handles rendering of 3D mesh data with materials and shaders.
 	 * Supports multiple meshes per model with individual materials.
+	 * Can be created from a model that is still loading, and draws nothing until it is ready.
 	 */
 	class ModelRenderer : public Component {
 		public:
@@ -34,6 +36,38 @@ namespace StevEngine::Visuals {
 						  Utilities::Vector3 scale = Utilities::Vector3(1)
 			);
 
+			/**
+			 * @brief Create model renderer for a model that is loading
+			 * @param model Handle to the loading model
+			 * @param material Default material if model has none
+			 * @param position Local position offset
+			 * @param rotation Local rotation offset
+			 * @param scale Local scale modifier
+			 */
+			ModelRenderer(Utilities::ModelHandle model,
+						  const Material& material = Material(),
+						  Utilities::Vector3 position = Utilities::Vector3(),
+						  Utilities::Quaternion rotation = Utilities::Quaternion(),
+						  Utilities::Vector3 scale = Utilities::Vector3(1)
+			);
+
+			/**
+			 * @brief Create model renderer from a baked model
+			 *
+			 * The mesh data is uploaded straight from the mapped file, which is kept open by the meshes.
+			 * @param model Baked model to render
+			 * @param material Default material if model has none
+			 * @param position Local position offset
+			 * @param rotation Local rotation offset
+			 * @param scale Local scale modifier
+			 */
+			ModelRenderer(std::shared_ptr<const Utilities::BakedModel> model,
+						  const Material& material = Material(),
+						  Utilities::Vector3 position = Utilities::Vector3(),
+						  Utilities::Quaternion rotation = Utilities::Quaternion(),
+						  Utilities::Vector3 scale = Utilities::Vector3(1)
+			);
+
 			/**
 			 * @brief Create model renderer from text serialized data
 			 * @param stream Stream containing serialized component data
@@ -60,9 +94,15 @@ namespace StevEngine::Visuals {
 			/** @brief Local scale modifier */
 			Utilities::Vector3 scale = Utilities::Vector3(1);
 
+			/**
+			 * @brief Check if the model has finished loading
+			 * @return true if the meshes are ready, otherwise false
+			 */
+			bool IsLoaded() const { return !loading; }
+
 			/**
 			 * @brief Get number of meshes in model
-			 * @return Mesh count
+			 * @return Mesh count, 0 while loading
 			 */
 			size_t MeshCount() const { return objects.size(); }
 
@@ -104,7 +144,14 @@ namespace StevEngine::Visuals {
 			~ModelRenderer();
 
 		private:
-			Utilities::Model model;				 	///< Source 3D model data
+			/**
+			 * @brief Create render objects once the model is loaded
+			 */
+			void FinishLoading();
+
+			std::string modelPath;				 	///< Path of the source 3D model
+			Material defaultMaterial;				///< Material of meshes without one
+			Utilities::ModelHandle loading;			///< Model being loaded, nullptr once loaded
 			std::vector<Renderer::Object> objects;  ///< Renderable objects for each mesh
 			std::map<Renderer::ShaderType, Renderer::ShaderProgram> shaders;  ///< Shader programs by type
 	};
@@ -5,6 +5,7 @@
 #include "utilities/Vertex.hpp"
 #include "utilities/Quaternion.hpp"
 #include "visuals/renderer/RenderComponent.hpp"
+#include "visuals/renderer/MeshAssets.hpp"
 #include "visuals/renderer/Object.hpp"
 #include "visuals/Material.hpp"
 
@@ -12,6 +13,7 @@
 #include <glad/gl.h>
 #include <math.h>
 #include <array>
+#include <format>
 #include <vector>
 
 using namespace StevEngine::Renderer;
@@ -20,6 +22,27 @@ using namespace StevEngine::Utilities;
 namespace StevEngine {
 	namespace Visuals {
 		const float pi2 = (2*M_PI);
+		//Cache
+		Object PrimitiveObject(PrimitiveShape shape, TextureType textureType, bool smooth, int detail, const Material& material, RenderType renderType) {
+			//Cubes have no smoothing or detail level
+			if(shape == CUBE) {
+				smooth = false;
+				detail = 0;
+			}
+			std::string name = std::format("Primitive/{}/{}/{}/{}", (int)shape, (int)textureType, smooth, detail);
+			std::shared_ptr<ObjectGeometry> geometry = meshAssets.Get(name, [=] () {
+				std::vector<Vertex> vertices;
+				switch (shape) {
+					case CUBE: vertices = CubeVertices(textureType); break;
+					case UVSPHERE: vertices = UVSphereVertices(textureType, smooth, detail); break;
+					case ICOSPHERE: vertices = IcosphereVertices(textureType, smooth, detail); break;
+					case CYLINDER: vertices = CylinderVertices(textureType, smooth, detail); break;
+					case CAPSULE: vertices = CapsuleVertices(textureType, smooth, detail); break;
+				}
+				return std::make_shared<ObjectGeometry>(vertices);
+			});
+			return Object(geometry, material, renderType);
+		}
 		//Cube
 		const std::vector<Vertex> CubeVertices(TextureType textureType) {
 			std::array<Vertex, 6*6> vertices;
@@ -107,12 +130,12 @@ namespace StevEngine {
 			return std::vector<Vertex>(vertices.begin(), vertices.end());
 		}
 		CubePrimitive::CubePrimitive(Vector3 position, Quaternion rotation, Vector3 scale, const Material& material, TextureType textureType, Renderer::RenderType renderType)
-		  : RenderComponent(Object(CubeVertices(textureType), material, renderType), position, rotation, scale), textureType(textureType) {}
+		  : RenderComponent(PrimitiveObject(CUBE, textureType, false, 0, material, renderType), position, rotation, scale), textureType(textureType) {}
 
 		CubePrimitive::CubePrimitive(Utilities::Stream& stream)
-		  : RenderComponent(Object({}, Material()), stream), textureType((TextureType)stream.Read<uint32_t>())
+		  : RenderComponent(Object(std::vector<Vertex>(), Material()), stream), textureType((TextureType)stream.Read<uint32_t>())
 		{
-			object = Object(CubeVertices(textureType), object.material);
+			SetRenderObject(PrimitiveObject(CUBE, textureType, false, 0, object.material, object.GetRenderType()));
 		}
 
 		Utilities::Stream CubePrimitive::Export(Utilities::StreamType type) const {
@@ -250,12 +273,12 @@ namespace StevEngine {
 			return vertices;
 		}
 		UVSpherePrimitive::UVSpherePrimitive(Vector3 position, Quaternion rotation, Vector3 scale, Material material, bool smooth, TextureType textureType, Renderer::RenderType renderType)
-		  : RenderComponent(Object(UVSphereVertices(textureType, smooth), material, renderType), position, rotation, scale), textureType(textureType), smooth(smooth) {}
+		  : RenderComponent(PrimitiveObject(UVSPHERE, textureType, smooth, CIRCLE_DETAIL, material, renderType), position, rotation, scale), textureType(textureType), smooth(smooth) {}
 
 		UVSpherePrimitive::UVSpherePrimitive(Utilities::Stream& stream)
-		  : RenderComponent(Object({}, Material()), stream), textureType((TextureType)stream.Read<uint32_t>()), smooth(stream.Read<bool>())
+		  : RenderComponent(Object(std::vector<Vertex>(), Material()), stream), textureType((TextureType)stream.Read<uint32_t>()), smooth(stream.Read<bool>())
 		{
-			object = Object(UVSphereVertices(textureType, smooth), object.material, object.GetRenderType());
+			SetRenderObject(PrimitiveObject(UVSPHERE, textureType, smooth, CIRCLE_DETAIL, object.material, object.GetRenderType()));
 		}
 
 		Utilities::Stream UVSpherePrimitive::Export(Utilities::StreamType type) const {
@@ -442,12 +465,12 @@ namespace StevEngine {
 			return vertices;
 		}
 		IcospherePrimitive::IcospherePrimitive(Vector3 position, Quaternion rotation, Vector3 scale, Material material, bool smooth, TextureType textureType, Renderer::RenderType renderType)
-		  : RenderComponent(Object(IcosphereVertices(textureType, smooth), material, renderType), position, rotation, scale), textureType(textureType), smooth(smooth) {}
+		  : RenderComponent(PrimitiveObject(ICOSPHERE, textureType, smooth, ICOSPHERE_DETAIL, material, renderType), position, rotation, scale), textureType(textureType), smooth(smooth) {}
 
 		IcospherePrimitive::IcospherePrimitive(Utilities::Stream& stream)
-		  : RenderComponent(Object({}, Material()), stream), textureType((TextureType)stream.Read<uint32_t>()), smooth(stream.Read<bool>())
+		  : RenderComponent(Object(std::vector<Vertex>(), Material()), stream), textureType((TextureType)stream.Read<uint32_t>()), smooth(stream.Read<bool>())
 		{
-			object = Object(UVSphereVertices(textureType, smooth), object.material, object.GetRenderType());
+			SetRenderObject(PrimitiveObject(ICOSPHERE, textureType, smooth, ICOSPHERE_DETAIL, object.material, object.GetRenderType()));
 		}
 
 		Utilities::Stream IcospherePrimitive::Export(Utilities::StreamType type) const {
@@ -574,11 +597,11 @@ namespace StevEngine {
 			return vertices;
 		}
 		CylinderPrimitive::CylinderPrimitive(Vector3 position, Quaternion rotation, Vector3 scale, Material material, bool smooth, TextureType textureType, Renderer::RenderType renderType)
-		  : RenderComponent(Object(CylinderVertices(textureType, smooth), material, renderType), position, rotation, scale), textureType(textureType), smooth(smooth) {}
+		  : RenderComponent(PrimitiveObject(CYLINDER, textureType, smooth, CIRCLE_DETAIL, material, renderType), position, rotation, scale), textureType(textureType), smooth(smooth) {}
 		CylinderPrimitive::CylinderPrimitive(Utilities::Stream& stream)
-		  : RenderComponent(Object({}, Material()), stream), textureType((TextureType)stream.Read<uint32_t>()), smooth(stream.Read<bool>())
+		  : RenderComponent(Object(std::vector<Vertex>(), Material()), stream), textureType((TextureType)stream.Read<uint32_t>()), smooth(stream.Read<bool>())
 		{
-			object = Object(CylinderVertices(textureType, smooth), object.material, object.GetRenderType());
+			SetRenderObject(PrimitiveObject(CYLINDER, textureType, smooth, CIRCLE_DETAIL, object.material, object.GetRenderType()));
 		}
 
 		Utilities::Stream CylinderPrimitive::Export(Utilities::StreamType type) const {
@@ -644,11 +667,11 @@ namespace StevEngine {
 			return vertices;
 		}
 		CapsulePrimitive::CapsulePrimitive(Vector3 position, Quaternion rotation, Vector3 scale, Material material, bool smooth, TextureType textureType, Renderer::RenderType renderType)
-		  : RenderComponent(Object(CapsuleVertices(textureType, smooth), material, renderType), position, rotation, scale), textureType(textureType), smooth(smooth) {}
+		  : RenderComponent(PrimitiveObject(CAPSULE, textureType, smooth, CIRCLE_DETAIL, material, renderType), position, rotation, scale), textureType(textureType), smooth(smooth) {}
 		CapsulePrimitive::CapsulePrimitive(Utilities::Stream& stream)
-		  : RenderComponent(Object({}, Material()), stream), textureType((TextureType)stream.Read<uint32_t>()), smooth(stream.Read<bool>())
+		  : RenderComponent(Object(std::vector<Vertex>(), Material()), stream), textureType((TextureType)stream.Read<uint32_t>()), smooth(stream.Read<bool>())
 		{
-			object = Object(UVSphereVertices(textureType, smooth), object.material, object.GetRenderType());
+			SetRenderObject(PrimitiveObject(CAPSULE, textureType, smooth, CIRCLE_DETAIL, object.material, object.GetRenderType()));
 		}
 		Utilities::Stream CapsulePrimitive::Export(Utilities::StreamType type) const {
 			Utilities::Stream stream(type);
@@ -12,6 +12,8 @@
 #define CAPSULE_PRIMITIVE_TYPE "CapsulePrimitive"
 
 #define RADIUS 0.5
+#define CIRCLE_DETAIL 30	//Segments around circular primitives
+#define ICOSPHERE_DETAIL 3	//Subdivisions of the icosphere
 
 const double phi = (1 + sqrt(5)) / 2;
 
@@ -25,6 +27,32 @@ namespace StevEngine {
 			COVER	///< Texture stretches to cover surface
 		};
 
+		/**
+		 * @brief Shapes of primitives
+		 */
+		enum PrimitiveShape {
+			CUBE,	   ///< CubeVertices
+			UVSPHERE,   ///< UVSphereVertices
+			ICOSPHERE,  ///< IcosphereVertices
+			CYLINDER,   ///< CylinderVertices
+			CAPSULE	 ///< CapsuleVertices
+		};
+
+		/**
+		 * @brief Get object with the geometry of a primitive
+		 *
+		 * Geometry is built once for each shape, texture type, smoothing and detail, and shared through the mesh assets
+		 * by every object returned for it while any of them exist, so identical primitives are uploaded and drawn from one mesh.
+		 * @param shape Primitive shape
+		 * @param textureType Texture mapping mode
+		 * @param smooth Use smooth shading, ignored by cubes
+		 * @param detail Detail level, ignored by cubes
+		 * @param material Material of the returned object
+		 * @param renderType Object rendering mode
+		 * @return Object sharing the cached geometry
+		 */
+		Renderer::Object PrimitiveObject(PrimitiveShape shape, TextureType textureType, bool smooth, int detail, const Material& material, Renderer::RenderType renderType = Renderer::SOLID);
+
 		/**
 		 * @brief Get cube primitive vertices
 		 */
@@ -81,7 +109,7 @@ namespace StevEngine {
 		/**
 		 * @brief Get uv sphere primitive vertices
 		 */
-		const std::vector<Utilities::Vertex> UVSphereVertices(TextureType textureType, bool smooth, int detail = 30, float height = RADIUS);
+		const std::vector<Utilities::Vertex> UVSphereVertices(TextureType textureType, bool smooth, int detail = CIRCLE_DETAIL, float height = RADIUS);
 
 		/**
 		 * @brief UV-mapped sphere primitive renderer
@@ -137,7 +165,7 @@ namespace StevEngine {
 		/**
 		 * @brief Get ico sphere primitive vertices
 		 */
-		const std::vector<Utilities::Vertex> IcosphereVertices(TextureType textureType, bool smooth, int detail = 3);
+		const std::vector<Utilities::Vertex> IcosphereVertices(TextureType textureType, bool smooth, int detail = ICOSPHERE_DETAIL);
 
 		/**
 		 * @brief Icosphere primitive renderer
@@ -193,7 +221,7 @@ namespace StevEngine {
 		/**
 		 * @brief Get cylinder primitive vertices
 		 */
-		const std::vector<Utilities::Vertex> CylinderVertices(TextureType textureType, bool smooth, int detail = 30, double height = RADIUS);
+		const std::vector<Utilities::Vertex> CylinderVertices(TextureType textureType, bool smooth, int detail = CIRCLE_DETAIL, double height = RADIUS);
 
 		/**
 		 * @brief Cylinder primitive renderer
@@ -249,7 +277,7 @@ namespace StevEngine {
 		/**
 		 * @brief Get capsule primitive vertices
 		 */
-		const std::vector<Utilities::Vertex> CapsuleVertices(TextureType textureType, bool smooth, int detail = 30);
+		const std::vector<Utilities::Vertex> CapsuleVertices(TextureType textureType, bool smooth, int detail = CIRCLE_DETAIL);
 
 		/**
 		 * @brief Capsule primitive renderer
@@ -310,4 +338,4 @@ namespace StevEngine {
 		inline bool capsule = CreateComponents::RegisterComponentType<CapsulePrimitive>(CAPSULE_PRIMITIVE_TYPE);
 	}
 }
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -1,17 +1,20 @@
 #ifdef StevEngine_RENDERER_GL
 #include "TerrainRenderer.hpp"
+#include "visuals/renderer/MeshAssets.hpp"
 #include "visuals/renderer/Object.hpp"
 #include "visuals/Material.hpp"
 #include "utilities/Vector2.hpp"
 #include "utilities/Vector3.hpp"
 #include "utilities/Terrain.hpp"
 
+#include <cstring>
+#include <format>
 #include <vector>
 
 using namespace StevEngine::Utilities;
 
 namespace StevEngine::Visuals {
-	Renderer::Object CreateRenderObject(const TerrainData& data, Material material, bool smooth) {
+	std::shared_ptr<Renderer::ObjectGeometry> CreateGeometry(const TerrainData& data, bool smooth) {
 		std::vector<Vertex> vertices;
 		std::vector<uint32_t> indices;
 		double halfSize = (data.size - 1) / 2.0;
@@ -91,15 +94,26 @@ namespace StevEngine::Visuals {
 				}
 			}
 		}
-		return Renderer::Object(vertices, indices, material);
+		return std::make_shared<Renderer::ObjectGeometry>(vertices, indices);
+	}
+	Renderer::Object CreateRenderObject(const TerrainData& data, Material material, bool smooth) {
+		//Terrains with the same heights share geometry, found by a hash of the heights
+		uint64_t hash = 14695981039346656037ULL;
+		for(uint32_t i = 0; i < data.size * data.size; i++) {
+			uint64_t bits;
+			std::memcpy(&bits, &data.points[i], sizeof(bits));
+			hash = (hash ^ bits) * 1099511628211ULL;
+		}
+		std::string name = std::format("Terrain/{}/{}/{}/{:016x}", data.size, data.step, smooth, hash);
+		return Renderer::Object(Renderer::meshAssets.Get(name, [&data, smooth] () { return CreateGeometry(data, smooth); }), material);
 	}
 	TerrainRenderer::TerrainRenderer(const TerrainData& data, Material material, bool smooth)
 	  : data(data), smooth(smooth), RenderComponent(CreateRenderObject(data, material, smooth)) {}
 
 	TerrainRenderer::TerrainRenderer(Utilities::Stream& stream)
-	  : RenderComponent(Renderer::Object({}, {}), stream), data(TerrainData(stream.Read<TerrainData>())), smooth(stream.Read<bool>())
+	  : RenderComponent(Renderer::Object(std::vector<Vertex>(), Material()), stream), data(TerrainData(stream.Read<TerrainData>())), smooth(stream.Read<bool>())
 	{
-		object = CreateRenderObject(data, object.material, smooth);
+		SetRenderObject(CreateRenderObject(data, object.material, smooth));
 	}
 
 	Utilities::Stream TerrainRenderer::Export(Utilities::StreamType type) const {
@@ -7,31 +7,50 @@
 #include <SDL.h>
 #include <SDL_image.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace StevEngine::Visuals {
 	const Texture Texture::empty = Texture();
 
-	Texture::Texture(Resources::Resource file) : path(file.path), bound(false) {
-		surface = IMG_Load_RW(file.GetSDLData(), true);
+	Texture::TextureData::~TextureData() {
+		if(surface) SDL_FreeSurface(surface);
+		if(bound) glDeleteTextures(1, &GLLocation);
+	}
+
+	Texture::Texture(Resources::Resource file) : path(file.path) {
+		//Share the image of textures loaded from the same file
+		//Models load their textures on worker threads
+		static std::mutex loadedMutex;
+		static std::unordered_map<std::string, std::weak_ptr<TextureData>> loaded;
+		{
+			std::lock_guard lock(loadedMutex);
+			data = loaded[path].lock();
+			if(data) return;
+		}
+		//Decode without holding the lock, and keep the first image if another thread loaded it meanwhile
+		std::shared_ptr<TextureData> decoded = std::make_shared<TextureData>();
+		decoded->surface = IMG_Load_RW(file.GetSDLData(), true);
+		std::lock_guard lock(loadedMutex);
+		std::weak_ptr<TextureData>& entry = loaded[path];
+		data = entry.lock();
+		if(data) return;
+		data = decoded;
+		entry = data;
+		//Forget images no longer in use
+		std::erase_if(loaded, [] (const auto& image) { return image.second.expired(); });
 	}
-	Texture::Texture(const Texture& copy) : path(copy.path), GLLocation(copy.GLLocation), surface(copy.surface), bound(copy.bound) {}
+	Texture::Texture(const Texture& copy) : path(copy.path), data(copy.data) {}
 	void Texture::operator=(const Texture& copy) {
-		//if(bound) FreeTexture();
-		bound = copy.bound;
 		path = copy.path;
-		GLLocation = copy.GLLocation;
-		surface = copy.surface;
+		data = copy.data;
 	}
 	Texture::~Texture() {}
 	void Texture::BindTexture(bool force) {
-		if(IsBound()) {
-			if(force) FreeTexture();
-			else return;
-		}
-		if(!surface) {
-			GLLocation = 0;
-			bound = false;
-			return;
-		};
+		//The image is freed once bound, so it can not be bound again
+		if(!data || !data->surface) return;
+		SDL_Surface* surface = data->surface;
+		GLuint& GLLocation = data->GLLocation;
 		glGenTextures(1, &GLLocation);
 		glBindTexture(GL_TEXTURE_2D, GLLocation);
 		//Genereate texture
@@ -41,15 +60,16 @@ namespace StevEngine::Visuals {
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, convertedSurface->w, convertedSurface->h, 0, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, convertedSurface->pixels);
 		glGenerateMipmap(GL_TEXTURE_2D);
 		//Set bound
-		bound = true;
+		data->bound = true;
 		//Free surface data
 		SDL_FreeSurface(surface);
 		SDL_FreeSurface(convertedSurface);
+		data->surface = nullptr;
 	}
 	void Texture::FreeTexture() {
 		if(!IsBound()) return Log::Error("Texture is not bound!", true);
-		glDeleteTextures(1, &GLLocation);
-		bound = false;
+		//Deleted from GPU memory by the last texture using it
+		data.reset();
 	}
 
 	ComputeTexture::ComputeTexture(uint32_t width, uint32_t height, GLenum format) : width(width), height(height), format(format) {}
@@ -61,6 +81,8 @@ namespace StevEngine::Visuals {
 			if(force) FreeTexture();
 			else return;
 		}
+		data = std::make_shared<TextureData>();
+		GLuint& GLLocation = data->GLLocation;
 		glCreateTextures(GL_TEXTURE_2D, 1, &GLLocation);
 		glTextureStorage2D(GLLocation, 1, format, width, height);
 		glTextureParameteri(GLLocation, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -68,14 +90,14 @@ namespace StevEngine::Visuals {
 		glTextureParameteri(GLLocation, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTextureParameteri(GLLocation, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		//Set bound
-		bound = true;
+		data->bound = true;
 	}
 	bool ComputeTexture::AttachToFrameBuffer(uint32_t framebuffer, GLenum attachmentType) {
 		if(!IsBound()) {
 			Log::Error("Texture is not bound!", true);
 			return false;
 		}
-		glNamedFramebufferTexture(framebuffer, attachmentType, GLLocation, 0);
+		glNamedFramebufferTexture(framebuffer, attachmentType, GetGLLocation(), 0);
 		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		{
 			Log::Error("Framebuffer is not complete!", true);
@@ -92,7 +114,7 @@ namespace StevEngine::Visuals {
 			(void*)0,
 			GL_DYNAMIC_DRAW);
 		// bind texture
-		glBindTexture(GL_TEXTURE_2D, GLLocation);
+		glBindTexture(GL_TEXTURE_2D, GetGLLocation());
 		// transfer texture into PBO
 		glGetTexImage(GL_TEXTURE_2D, 0, format, pixel, (GLvoid*)0);
 		//map buffer to array
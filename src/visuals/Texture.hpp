@@ -5,6 +5,7 @@
 #include <glad/gl.h>
 
 #include <cstdint>
+#include <memory>
 
 namespace StevEngine::Visuals {
 	/**
@@ -12,6 +13,8 @@ namespace StevEngine::Visuals {
 	 *
 	 * Manages loading, binding and cleanup of OpenGL textures.
 	 * Supports loading from image files and provides texture state management.
+	 * Copies of a texture, and textures loaded from the same file, share one image and OpenGL texture,
+	 * which is freed when the last of them is freed or destroyed.
 	 */
 	class Texture {
 		public:
@@ -40,13 +43,16 @@ namespace StevEngine::Visuals {
 
 			/**
 			 * @brief Bind texture to OpenGL
-			 * Generates and configures texture in GPU memory
+			 * Generates and configures texture in GPU memory.
+			 * Textures loaded from the same file share one upload, and the image is freed once uploaded,
+			 * so a bound texture is never uploaded again.
+			 * @param force Ignored, only there to match ComputeTexture::BindTexture
 			 */
 			void BindTexture(bool force = false);
 
 			/**
-			 * @brief Free texture from OpenGL
-			 * Releases texture from GPU memory
+			 * @brief Stop using the texture
+			 * Releases texture from GPU memory once no other texture shares it
 			 */
 			void FreeTexture();
 
@@ -54,13 +60,13 @@ namespace StevEngine::Visuals {
 			 * @brief Check if texture is bound to OpenGL
 			 * @return True if texture is in GPU memory
 			 */
-			bool IsBound() const { return bound; };
+			bool IsBound() const { return data && data->bound; };
 
 			/**
 			 * @brief Get OpenGL texture ID
 			 * @return OpenGL texture location
 			 */
-			GLuint GetGLLocation() const { return GLLocation; };
+			GLuint GetGLLocation() const { return data ? data->GLLocation : 0; };
 
 			/**
 			 * @brief Get texture file path
@@ -72,13 +78,21 @@ namespace StevEngine::Visuals {
 			const static Texture empty;
 
 		protected:
+			/** @brief Image and OpenGL texture, shared by copies of a texture */
+			struct TextureData {
+				SDL_Surface* surface = nullptr;  ///< SDL surface containing image data, freed once bound
+				GLuint GLLocation = 0;		   ///< OpenGL texture ID
+				bool bound = false;			  ///< Whether texture is bound to OpenGL
+
+				/** @brief Free the image and OpenGL texture */
+				~TextureData();
+			};
+
 			/** @brief Create empty texture */
-			Texture() : bound(false), surface(nullptr), GLLocation(0) {};
+			Texture() {};
 
-			std::string path;		 ///< Path to texture file
-			SDL_Surface* surface;	 ///< SDL surface containing image data
-			GLuint GLLocation;	   ///< OpenGL texture ID
-			bool bound;			  ///< Whether texture is bound to OpenGL
+			std::string path;					///< Path to texture file
+			std::shared_ptr<TextureData> data;  ///< Shared image and OpenGL texture, nullptr if empty or freed
 	};
 
 	class ComputeTexture : public Texture {
@@ -96,6 +110,7 @@ namespace StevEngine::Visuals {
 			/**
 			 * @brief Bind texture to OpenGL
 			 * Generates and configures texture in GPU memory
+			 * @param force Whether to create a new texture if already bound
 			 */
 			void BindTexture(bool force = false);
 
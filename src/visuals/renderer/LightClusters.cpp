@@ -0,0 +1,153 @@
+#ifdef StevEngine_RENDERER_GL
+#include "LightClusters.hpp"
+#include "main/Profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <glad/gl.h>
+
+using namespace StevEngine::Utilities;
+
+namespace StevEngine::Renderer {
+	//Frame lights
+	void FrameLights::Clear() {
+		directionalLights.clear();
+		pointLights.clear();
+		pointLightRanges.clear();
+		spotLights.clear();
+	}
+
+	//Light clusters
+	void LightClusters::Init() {
+		//Buffers start zeroed, so nothing is read from uninitialized memory before the first frame
+		std::vector<uint8_t> zeros(initialStorageCapacity, 0);
+		for(uint32_t binding = 0; binding < storage.size(); binding++) {
+			StorageBuffer& buffer = storage[binding];
+			glGenBuffers(1, &buffer.buffer);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer.buffer);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, initialStorageCapacity, zeros.data(), GL_STREAM_DRAW);
+			buffer.capacity = initialStorageCapacity;
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer.buffer);
+		}
+	}
+
+	//Transform a point from clip space into view space, rows are stored as (W, X, Y, Z) for columns 0 to 3
+	static Vector3 Unproject(const Matrix4& inverseProjection, double x, double y, double z) {
+		auto row = [&] (int i) {
+			Vector4 r = inverseProjection.GetRow(i);
+			return r.W * x + r.X * y + r.Y * z + r.Z;
+		};
+		double w = row(3);
+		return Vector3(row(0) / w, row(1) / w, row(2) / w);
+	}
+
+	void LightClusters::UpdateBounds(const Matrix4& projection) {
+		if(!bounds.empty() && projection == boundsProjection) return;
+		boundsProjection = projection;
+		Matrix4 inverse = Matrix4::Inverse(projection);
+		//Depth range, the view looks down negative Z
+		nearDepth = std::max(-Unproject(inverse, 0, 0, -1).Z, 0.001);
+		farDepth = std::max(-Unproject(inverse, 0, 0, 1).Z, nearDepth * 2);
+		depthScale = sizeZ / std::log(farDepth / nearDepth);
+		//Bounds of the points where the lines through the tile corners cross the slice depths
+		bounds.resize(clusterCount);
+		for(uint32_t z = 0; z < sizeZ; z++) {
+			double depths[2] = { nearDepth * std::exp(z / depthScale), nearDepth * std::exp((z + 1) / depthScale) };
+			for(uint32_t y = 0; y < sizeY; y++) {
+				for(uint32_t x = 0; x < sizeX; x++) {
+					ClusterBounds& cluster = bounds[x + sizeX * (y + sizeY * z)];
+					cluster.min = Vector3(INFINITY);
+					cluster.max = Vector3(-INFINITY);
+					for(uint32_t corner = 0; corner < 4; corner++) {
+						double ndcX = -1 + 2.0 * (x + (corner & 1)) / sizeX;
+						double ndcY = -1 + 2.0 * (y + (corner >> 1)) / sizeY;
+						Vector3 nearPoint = Unproject(inverse, ndcX, ndcY, -1);
+						Vector3 farPoint = Unproject(inverse, ndcX, ndcY, 1);
+						for(double depth : depths) {
+							double t = (depth + nearPoint.Z) / (nearPoint.Z - farPoint.Z);
+							Vector3 point = nearPoint + (farPoint - nearPoint) * t;
+							cluster.min = Vector3(std::min(cluster.min.X, point.X), std::min(cluster.min.Y, point.Y), std::min(cluster.min.Z, point.Z));
+							cluster.max = Vector3(std::max(cluster.max.X, point.X), std::max(cluster.max.Y, point.Y), std::max(cluster.max.Z, point.Z));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	uint32_t LightClusters::GetSlice(double depth) const {
+		if(depth <= nearDepth) return 0;
+		double slice = std::log(depth / nearDepth) * depthScale;
+		return slice >= sizeZ ? sizeZ - 1 : (uint32_t)slice;
+	}
+
+	void LightClusters::Build(const Matrix4& view, const Matrix4& projection, const FrameLights& lights) {
+		StevEngine_PROFILE_ZONE("LightClusters::Build");
+		UpdateBounds(projection);
+		//Find the clusters each point light reaches
+		binnedClusters.clear();
+		binnedLights.clear();
+		for(uint32_t light = 0; light < lights.pointLights.size(); light++) {
+			double range = lights.pointLightRanges[light];
+			if(range <= 0) continue;
+			const Vector3f& position = lights.pointLights[light].position;
+			Vector3 center = view * Vector3(position.X, position.Y, position.Z);
+			double depth = -center.Z;
+			if(depth + range < nearDepth || depth - range > farDepth) continue;
+			double rangeSquared = range * range;
+			uint32_t lastSlice = GetSlice(depth + range);
+			for(uint32_t z = GetSlice(depth - range); z <= lastSlice; z++) {
+				for(uint32_t cluster = z * sizeX * sizeY; cluster < (z + 1) * sizeX * sizeY; cluster++) {
+					//Distance to the closest point of the cluster
+					const ClusterBounds& cell = bounds[cluster];
+					double dx = std::max({ cell.min.X - center.X, 0.0, center.X - cell.max.X });
+					double dy = std::max({ cell.min.Y - center.Y, 0.0, center.Y - cell.max.Y });
+					double dz = std::max({ cell.min.Z - center.Z, 0.0, center.Z - cell.max.Z });
+					if(dx * dx + dy * dy + dz * dz > rangeSquared) continue;
+					binnedClusters.push_back(cluster);
+					binnedLights.push_back(light);
+				}
+			}
+		}
+		//Sort the binned lights by cluster, by counting the lights of each cluster first
+		clusters.assign(clusterCount, { 0, 0 });
+		for(uint32_t cluster : binnedClusters) clusters[cluster].count++;
+		uint32_t offset = 0;
+		for(LightClusterData& cluster : clusters) {
+			cluster.offset = offset;
+			offset += cluster.count;
+			cluster.count = 0;
+		}
+		lightIndices.resize(offset);
+		for(size_t i = 0; i < binnedLights.size(); i++) {
+			LightClusterData& cluster = clusters[binnedClusters[i]];
+			lightIndices[cluster.offset + cluster.count++] = binnedLights[i];
+		}
+	}
+
+	void LightClusters::UploadStorage(StorageBuffer& storage, const void* data, size_t size) {
+		if(size == 0) return;
+		while(storage.capacity < size) storage.capacity *= 2;
+		//Give the old contents to the driver, so the upload does not wait for draws still reading them
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, storage.buffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, storage.capacity, NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, data);
+	}
+
+	void LightClusters::Upload(const FrameLights& lights) {
+		UploadStorage(storage[DIRECTIONAL_LIGHTS_BLOCK], lights.directionalLights.data(), lights.directionalLights.size() * sizeof(DirectionalLightData));
+		UploadStorage(storage[POINT_LIGHTS_BLOCK], lights.pointLights.data(), lights.pointLights.size() * sizeof(PointLightData));
+		UploadStorage(storage[SPOT_LIGHTS_BLOCK], lights.spotLights.data(), lights.spotLights.size() * sizeof(SpotLightData));
+		UploadStorage(storage[LIGHT_CLUSTERS_BLOCK], clusters.data(), clusters.size() * sizeof(LightClusterData));
+		UploadStorage(storage[LIGHT_INDICES_BLOCK], lightIndices.data(), lightIndices.size() * sizeof(uint32_t));
+	}
+
+	void LightClusters::FillLightsBlock(LightsBlock& block) const {
+		block.clusterNear = nearDepth;
+		block.clusterSize[0] = sizeX;
+		block.clusterSize[1] = sizeY;
+		block.clusterSize[2] = sizeZ;
+		block.clusterDepthScale = depthScale;
+	}
+}
+#endif
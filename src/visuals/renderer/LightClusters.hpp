@@ -0,0 +1,118 @@
+#pragma once
+#ifdef StevEngine_RENDERER_GL
+#include "utilities/Matrix4.hpp"
+#include "utilities/Vector3.hpp"
+#include "visuals/shaders/UniformBlocks.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace StevEngine::Renderer {
+	/**
+	 * @brief Lights of a frame, added by each light component
+	 *
+	 * There is no limit on the number of lights of any type.
+	 */
+	struct FrameLights {
+		std::vector<DirectionalLightData> directionalLights;  ///< Directional lights, used by every fragment
+		std::vector<PointLightData> pointLights;			  ///< Point lights, used by the fragments of the clusters they reach
+		std::vector<float> pointLightRanges;				  ///< Distance each point light reaches
+		std::vector<SpotLightData> spotLights;				///< Spot lights, used by every fragment
+
+		/** @brief Remove every light */
+		void Clear();
+	};
+
+	/**
+	 * @brief Grid of clusters dividing the view frustum, with the point lights reaching each cluster
+	 *
+	 * The screen is split into tiles, and the view depth into slices growing exponentially with distance,
+	 * so clusters are about as deep as they are wide.
+	 * Point lights are binned on the CPU each frame by testing their range against the view space bounds of the clusters,
+	 * and each fragment only calculates the point lights of its cluster.
+	 */
+	class LightClusters {
+		public:
+			static constexpr uint32_t sizeX = 16;  ///< Clusters along the screen width
+			static constexpr uint32_t sizeY = 9;   ///< Clusters along the screen height
+			static constexpr uint32_t sizeZ = 24;  ///< Clusters along the view depth
+			static constexpr uint32_t clusterCount = sizeX * sizeY * sizeZ;  ///< Number of clusters
+
+			/** @brief Create the light storage buffers, needs an OpenGL context */
+			void Init();
+
+			/**
+			 * @brief Bin the point lights of a frame into clusters
+			 * @param view View matrix for positions relative to the camera
+			 * @param projection Projection matrix
+			 * @param lights Lights of the frame, positioned relative to the camera
+			 */
+			void Build(const Utilities::Matrix4& view, const Utilities::Matrix4& projection, const FrameLights& lights);
+
+			/**
+			 * @brief Upload the lights of a frame and the built clusters to the storage buffers
+			 * @param lights Lights of the frame
+			 */
+			void Upload(const FrameLights& lights);
+
+			/**
+			 * @brief Fill the cluster grid parameters of the lights block
+			 * @param block Lights block to fill
+			 */
+			void FillLightsBlock(LightsBlock& block) const;
+
+			const std::vector<LightClusterData>& GetClusters() const { return clusters; }  ///< Get range of the light indices used by each cluster
+			const std::vector<uint32_t>& GetLightIndices() const { return lightIndices; }  ///< Get point light indices of every cluster
+
+		private:
+			/** @brief Storage buffer grown when its contents do not fit */
+			struct StorageBuffer {
+				uint32_t buffer = 0;	///< Buffer name
+				size_t capacity = 0;	///< Size of the buffer in bytes
+			};
+
+			/** @brief View space bounds of a cluster */
+			struct ClusterBounds {
+				Utilities::Vector3 min;  ///< Minimum corner
+				Utilities::Vector3 max;  ///< Maximum corner
+			};
+
+			/**
+			 * @brief Calculate the depth slices and cluster bounds of a projection, if it changed
+			 * @param projection Projection matrix
+			 */
+			void UpdateBounds(const Utilities::Matrix4& projection);
+
+			/**
+			 * @brief Get the depth slice of a view depth
+			 * @param depth Distance in front of the camera
+			 * @return Depth slice, clamped to the grid
+			 */
+			uint32_t GetSlice(double depth) const;
+
+			/**
+			 * @brief Replace the contents of a storage buffer
+			 * @param storage Buffer to upload to
+			 * @param data Data to upload
+			 * @param size Size of the data in bytes
+			 */
+			static void UploadStorage(StorageBuffer& storage, const void* data, size_t size);
+
+			static constexpr size_t initialStorageCapacity = 1 << 12;  ///< Bytes each storage buffer starts with
+
+			std::array<StorageBuffer, 5> storage;  ///< Storage buffers, by storage block binding
+
+			Utilities::Matrix4 boundsProjection = Utilities::Matrix4(0.0);  ///< Projection the bounds were calculated for
+			std::vector<ClusterBounds> bounds;  ///< View space bounds of each cluster
+			double nearDepth = 0.1;   ///< View depth of the near plane
+			double farDepth = 1000;   ///< View depth of the far plane
+			double depthScale = 1;	///< Depth slices per logarithmic unit of view depth
+
+			std::vector<LightClusterData> clusters;  ///< Range of the light indices used by each cluster
+			std::vector<uint32_t> lightIndices;	  ///< Point light indices of every cluster, in cluster order
+			std::vector<uint32_t> binnedClusters;	///< Cluster of each binned light, while building
+			std::vector<uint32_t> binnedLights;	  ///< Light of each binned light, while building
+	};
+}
+#endif
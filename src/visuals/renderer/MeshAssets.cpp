@@ -0,0 +1,29 @@
+#ifdef StevEngine_RENDERER_GL
+#include "MeshAssets.hpp"
+
+namespace StevEngine::Renderer {
+	MeshAssets meshAssets = MeshAssets();
+
+	std::shared_ptr<ObjectGeometry> MeshAssets::Get(const std::string& name, const std::function<std::shared_ptr<ObjectGeometry>()>& create) {
+		std::weak_ptr<ObjectGeometry>& entry = meshes[name];
+		std::shared_ptr<ObjectGeometry> geometry = entry.lock();
+		if(geometry) return geometry;
+		geometry = create();
+		entry = geometry;
+		//Forget geometry no longer in use
+		std::erase_if(meshes, [] (const auto& mesh) { return mesh.second.expired(); });
+		return geometry;
+	}
+
+	std::shared_ptr<ObjectGeometry> MeshAssets::Find(const std::string& name) const {
+		auto mesh = meshes.find(name);
+		return mesh == meshes.end() ? nullptr : mesh->second.lock();
+	}
+
+	size_t MeshAssets::GetLoadedCount() const {
+		size_t count = 0;
+		for(const auto& [_, mesh] : meshes) if(!mesh.expired()) count++;
+		return count;
+	}
+}
+#endif
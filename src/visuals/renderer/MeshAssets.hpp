@@ -0,0 +1,47 @@
+#pragma once
+#ifdef StevEngine_RENDERER_GL
+#include "Object.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace StevEngine::Renderer {
+	/**
+	 * @brief Cache of object geometry shared between objects
+	 *
+	 * Geometry is looked up by a unique name, such as the model path and mesh index,
+	 * so every object using the same mesh holds one copy of its vertex data and one upload.
+	 * The cache does not own the geometry, which is freed when the last object using it is destroyed.
+	 */
+	class MeshAssets {
+		public:
+			/**
+			 * @brief Get geometry by name, creating it if it is not loaded
+			 * @param name Unique name of the geometry
+			 * @param create Function creating the geometry, only called if it is not loaded
+			 * @return Shared geometry
+			 */
+			std::shared_ptr<ObjectGeometry> Get(const std::string& name, const std::function<std::shared_ptr<ObjectGeometry>()>& create);
+
+			/**
+			 * @brief Get geometry by name, if it is loaded
+			 * @param name Unique name of the geometry
+			 * @return Shared geometry, or nullptr if not loaded
+			 */
+			std::shared_ptr<ObjectGeometry> Find(const std::string& name) const;
+
+			/**
+			 * @brief Get number of loaded geometries
+			 * @return Geometries still used by an object
+			 */
+			size_t GetLoadedCount() const;
+
+		private:
+			std::unordered_map<std::string, std::weak_ptr<ObjectGeometry>> meshes;  ///< Geometry by name, expired once unused
+	};
+
+	extern MeshAssets meshAssets;  ///< Global mesh asset cache
+}
+#endif
@@ -0,0 +1,161 @@
+#ifdef StevEngine_RENDERER_GL
+#include "MeshBuffers.hpp"
+#include "main/Log.hpp"
+#include "utilities/Vertex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <glad/gl.h>
+
+namespace StevEngine::Renderer {
+	//Range allocator
+	uint32_t RangeAllocator::Allocate(uint32_t count) {
+		//Reuse the first free range that fits
+		for(size_t i = 0; i < freeRanges.size(); i++) {
+			BufferRange& range = freeRanges[i];
+			if(range.count < count) continue;
+			uint32_t start = range.start;
+			range.start += count;
+			range.count -= count;
+			if(range.count == 0) freeRanges.erase(freeRanges.begin() + i);
+			return start;
+		}
+		uint32_t start = end;
+		end += count;
+		return start;
+	}
+	void RangeAllocator::Free(BufferRange range) {
+		if(range.count == 0) return;
+		auto next = std::lower_bound(freeRanges.begin(), freeRanges.end(), range.start, [] (const BufferRange& r, uint32_t start) { return r.start < start; });
+		//Merge with the following free range
+		if(next != freeRanges.end() && range.start + range.count == next->start) {
+			range.count += next->count;
+			next = freeRanges.erase(next);
+		}
+		//Merge with the preceding free range
+		if(next != freeRanges.begin()) {
+			BufferRange& previous = *(next - 1);
+			if(previous.start + previous.count == range.start) {
+				previous.count += range.count;
+				range = previous;
+				next = freeRanges.erase(next - 1);
+			}
+		}
+		//Give ranges at the end back to the unused space
+		if(range.start + range.count == end) end = range.start;
+		else freeRanges.insert(next, range);
+	}
+
+	//GPU mesh
+	GPUMesh::~GPUMesh() {
+		buffers->Free(allocation);
+	}
+
+	//Mesh buffers
+	void MeshBuffers::Init() {
+		glGenVertexArrays(1, &VAO);
+		glBindVertexArray(VAO);
+		// position layout
+		glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, 0);
+		glVertexAttribBinding(0, 0);
+		glEnableVertexAttribArray(0);
+		// uv layout
+		glVertexAttribFormat(1, 2, GL_FLOAT, GL_FALSE, (3) * sizeof(float));
+		glVertexAttribBinding(1, 0);
+		glEnableVertexAttribArray(1);
+		// Normal and Tangent layout
+		glVertexAttribFormat(2, 3, GL_FLOAT, GL_FALSE, (3 + 2) * sizeof(float));
+		glVertexAttribBinding(2, 0);
+		glEnableVertexAttribArray(2);
+		glVertexAttribFormat(3, 3, GL_FLOAT, GL_FALSE, (3 + 2 + 3) * sizeof(float));
+		glVertexAttribBinding(3, 0);
+		glEnableVertexAttribArray(3);
+		// Instance transform layout, a column per location
+		for(uint32_t column = 0; column < 4; column++) {
+			glVertexAttribFormat(4 + column, 4, GL_FLOAT, GL_FALSE, offsetof(InstanceData, transform) + column * 4 * sizeof(float));
+			glVertexAttribBinding(4 + column, 1);
+			glEnableVertexAttribArray(4 + column);
+		}
+		// Instance color layout
+		glVertexAttribFormat(8, 4, GL_FLOAT, GL_FALSE, offsetof(InstanceData, color));
+		glVertexAttribBinding(8, 1);
+		glEnableVertexAttribArray(8);
+		glVertexBindingDivisor(1, 1);
+		//Buffers
+		Reserve(VBO, vertexCapacity, initialVertexCapacity, Utilities::VERTEX_SIZE);
+		Reserve(EBO, indexCapacity, initialIndexCapacity, sizeof(uint32_t));
+		glBindVertexBuffer(0, VBO, 0, Utilities::VERTEX_SIZE);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+		//Instance buffer, never empty so draws without instances still read valid data
+		glGenBuffers(1, &instanceVBO);
+		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+		glBufferData(GL_ARRAY_BUFFER, initialInstanceCapacity * sizeof(InstanceData), NULL, GL_STREAM_DRAW);
+		instanceCapacity = initialInstanceCapacity;
+		glBindVertexBuffer(1, instanceVBO, 0, sizeof(InstanceData));
+	}
+
+	bool MeshBuffers::Reserve(uint32_t& buffer, uint32_t& capacity, uint32_t needed, size_t elementSize) {
+		if(needed <= capacity) return false;
+		uint32_t newCapacity = std::max(capacity, 1u);
+		while(newCapacity < needed) newCapacity *= 2;
+		//Copy the old contents into the new buffer on the GPU
+		uint32_t newBuffer;
+		glGenBuffers(1, &newBuffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, newCapacity * elementSize, NULL, GL_STATIC_DRAW);
+		if(buffer) {
+			glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, capacity * elementSize);
+			glDeleteBuffers(1, &buffer);
+			Log::Debug(std::format("Mesh buffer grown from {} to {} elements", capacity, newCapacity), true);
+		}
+		buffer = newBuffer;
+		capacity = newCapacity;
+		return true;
+	}
+
+	std::shared_ptr<GPUMesh> MeshBuffers::Upload(const float* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+		std::shared_ptr<GPUMesh> mesh = std::make_shared<GPUMesh>();
+		mesh->buffers = shared_from_this();
+		MeshAllocation& allocation = mesh->allocation;
+		allocation.vertices = { vertexRanges.Allocate(vertexCount), vertexCount };
+		allocation.indices = { indexRanges.Allocate(indexCount), indexCount };
+		//Grow buffers, and point the vertex array at the new ones
+		glBindVertexArray(VAO);
+		if(Reserve(VBO, vertexCapacity, vertexRanges.GetEnd(), Utilities::VERTEX_SIZE)) glBindVertexBuffer(0, VBO, 0, Utilities::VERTEX_SIZE);
+		if(Reserve(EBO, indexCapacity, indexRanges.GetEnd(), sizeof(uint32_t))) glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+		//Upload
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferSubData(GL_ARRAY_BUFFER, allocation.vertices.start * Utilities::VERTEX_SIZE, vertexCount * Utilities::VERTEX_SIZE, vertices);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, allocation.indices.start * sizeof(uint32_t), indexCount * sizeof(uint32_t), indices);
+		return mesh;
+	}
+
+	void MeshBuffers::Free(const MeshAllocation& allocation) {
+		vertexRanges.Free(allocation.vertices);
+		indexRanges.Free(allocation.indices);
+	}
+
+	void MeshBuffers::Bind() const {
+		glBindVertexArray(VAO);
+	}
+
+	void MeshBuffers::UploadInstances(const InstanceData* instances, uint32_t count) {
+		if(count == 0) return;
+		while(instanceCapacity < count) instanceCapacity *= 2;
+		//Give the old contents to the driver, so the upload does not wait for draws still reading them
+		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+		glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(InstanceData), NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData), instances);
+	}
+
+	void MeshBuffers::Draw(const MeshAllocation& allocation, uint32_t mode) const {
+		glDrawElementsBaseVertex(mode, allocation.indices.count, GL_UNSIGNED_INT, (void*)(allocation.indices.start * sizeof(uint32_t)), allocation.vertices.start);
+	}
+
+	void MeshBuffers::DrawInstanced(const MeshAllocation& allocation, uint32_t mode, uint32_t firstInstance, uint32_t instanceCount) const {
+		glDrawElementsInstancedBaseVertexBaseInstance(mode, allocation.indices.count, GL_UNSIGNED_INT, (void*)(allocation.indices.start * sizeof(uint32_t)), instanceCount, allocation.vertices.start, firstInstance);
+	}
+}
+#endif
@@ -0,0 +1,159 @@
+#pragma once
+#ifdef StevEngine_RENDERER_GL
+#include "utilities/Matrix4.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace StevEngine::Renderer {
+	/** @brief Range of elements in a shared buffer */
+	struct BufferRange {
+		uint32_t start = 0;  ///< First element
+		uint32_t count = 0;  ///< Number of elements
+	};
+
+	/**
+	 * @brief Hands out ranges of elements from a buffer
+	 *
+	 * Freed ranges are kept sorted by start and merged with neighbouring free ranges,
+	 * and reused by the first allocation they fit. Ranges are otherwise taken from the end of the used elements.
+	 */
+	class RangeAllocator {
+		public:
+			/**
+			 * @brief Allocate a range of elements
+			 * @param count Number of elements
+			 * @return Start of the allocated range
+			 */
+			uint32_t Allocate(uint32_t count);
+
+			/**
+			 * @brief Return a range, so it can be allocated again
+			 * @param range Range to free
+			 */
+			void Free(BufferRange range);
+
+			/**
+			 * @brief Get end of the used elements
+			 * @return Number of elements the buffer needs to hold
+			 */
+			uint32_t GetEnd() const { return end; }
+
+		private:
+			std::vector<BufferRange> freeRanges;  ///< Free ranges before the end, sorted by start
+			uint32_t end = 0;					 ///< End of the used elements
+	};
+
+	/** @brief Location of a mesh in the shared mesh buffers */
+	struct MeshAllocation {
+		BufferRange vertices;  ///< Range in the vertex buffer, in vertices
+		BufferRange indices;   ///< Range in the index buffer, in indices
+	};
+
+	/** @brief Per instance data of an instanced draw, read by the vertex shader */
+	struct InstanceData {
+		Utilities::Matrix4f transform;  ///< Transform relative to the camera
+		float color[4];				 ///< Material color, normalized RGBA
+	};
+
+	class MeshBuffers;
+
+	/**
+	 * @brief Mesh uploaded to the shared mesh buffers
+	 *
+	 * Shared by every copy of an object, and freed when the last copy is destroyed.
+	 */
+	struct GPUMesh {
+		MeshAllocation allocation;			///< Location in the buffers
+		std::shared_ptr<MeshBuffers> buffers;  ///< Buffers the mesh is in, kept alive while the mesh is
+
+		~GPUMesh();
+	};
+
+	/**
+	 * @brief Shared vertex and index buffers for every mesh
+	 *
+	 * Meshes are uploaded once into ranges of two large buffers and drawn with a base vertex,
+	 * so drawing does not upload anything or switch buffers.
+	 * The buffers grow when full, by copying into larger buffers on the GPU.
+	 * A third buffer holds per instance data, for drawing many copies of a mesh in one draw call.
+	 */
+	class MeshBuffers : public std::enable_shared_from_this<MeshBuffers> {
+		public:
+			/** @brief Create the buffers and vertex layout, needs an OpenGL context */
+			void Init();
+
+			/**
+			 * @brief Upload a mesh
+			 * @param vertices Vertex data, VERTEX_COUNT floats per vertex
+			 * @param vertexCount Number of vertices
+			 * @param indices Index data, relative to the first vertex of the mesh
+			 * @param indexCount Number of indices
+			 * @return Uploaded mesh
+			 */
+			std::shared_ptr<GPUMesh> Upload(const float* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+			/**
+			 * @brief Free the ranges of a mesh
+			 * @param allocation Location of the mesh
+			 */
+			void Free(const MeshAllocation& allocation);
+
+			/** @brief Bind the vertex array using the buffers */
+			void Bind() const;
+
+			/**
+			 * @brief Draw a mesh, the buffers must be bound
+			 * @param allocation Location of the mesh
+			 * @param mode Primitive type to draw
+			 */
+			void Draw(const MeshAllocation& allocation, uint32_t mode) const;
+
+			/**
+			 * @brief Replace the contents of the instance buffer
+			 * @param instances Instance data
+			 * @param count Number of instances
+			 */
+			void UploadInstances(const InstanceData* instances, uint32_t count);
+
+			/**
+			 * @brief Draw copies of a mesh, one for each instance in a range of the instance buffer
+			 * @param allocation Location of the mesh
+			 * @param mode Primitive type to draw
+			 * @param firstInstance First instance in the instance buffer
+			 * @param instanceCount Number of instances
+			 */
+			void DrawInstanced(const MeshAllocation& allocation, uint32_t mode, uint32_t firstInstance, uint32_t instanceCount) const;
+
+			uint32_t GetVertexCapacity() const { return vertexCapacity; }  ///< Get vertices the vertex buffer can hold
+			uint32_t GetIndexCapacity() const { return indexCapacity; }	///< Get indices the index buffer can hold
+			uint32_t GetInstanceCapacity() const { return instanceCapacity; }  ///< Get instances the instance buffer can hold
+
+		private:
+			/**
+			 * @brief Grow a buffer to hold at least a number of elements, keeping its data
+			 * @param buffer Buffer to grow, replaced by the new buffer
+			 * @param capacity Elements the buffer holds, updated to the new capacity
+			 * @param needed Elements the buffer needs to hold
+			 * @param elementSize Size of an element in bytes
+			 * @return Whether the buffer was replaced
+			 */
+			bool Reserve(uint32_t& buffer, uint32_t& capacity, uint32_t needed, size_t elementSize);
+
+			static constexpr uint32_t initialVertexCapacity = 1 << 16;  ///< Vertices the vertex buffer starts with
+			static constexpr uint32_t initialIndexCapacity = 1 << 18;   ///< Indices the index buffer starts with
+			static constexpr uint32_t initialInstanceCapacity = 1 << 10;  ///< Instances the instance buffer starts with
+
+			uint32_t VAO = 0;  ///< Vertex Array Object
+			uint32_t VBO = 0;  ///< Vertex Buffer Object
+			uint32_t EBO = 0;  ///< Element Buffer Object
+			uint32_t instanceVBO = 0;  ///< Instance data buffer
+			uint32_t vertexCapacity = 0;  ///< Vertices the vertex buffer holds
+			uint32_t indexCapacity = 0;   ///< Indices the index buffer holds
+			uint32_t instanceCapacity = 0;  ///< Instances the instance buffer holds
+			RangeAllocator vertexRanges;  ///< Used ranges of the vertex buffer
+			RangeAllocator indexRanges;   ///< Used ranges of the index buffer
+	};
+}
+#endif
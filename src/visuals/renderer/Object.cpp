@@ -1,15 +1,14 @@
 #ifdef StevEngine_RENDERER_GL
 #include "Object.hpp"
+#include "utilities/BakedModel.hpp"
 #include "utilities/Vertex.hpp"
 #include "visuals/Texture.hpp"
 #include "visuals/Material.hpp"
 #include "visuals/renderer/RenderSystem.hpp"
-#include "visuals/Lights.hpp"
-#include "visuals/Camera.hpp"
-#include "main/SceneManager.hpp"
 
 #include <cstdint>
 #include <algorithm>
+#include <functional>
 
 #include "glad/gl.h"
 
@@ -17,24 +16,15 @@ using StevEngine::Utilities::Vertex;
 using namespace StevEngine::Visuals;
 
 namespace StevEngine::Renderer {
-	std::vector<float> ToFloatList(const std::vector<Vertex>& vertices);
-	uint32_t* SolidToWireframe(uint32_t* indices, uint32_t& size);
-	uint32_t* WireframeToSolid(uint32_t* indices, uint32_t& size);
+	std::vector<uint32_t> SolidToWireframe(std::span<const uint32_t> indices);
+	std::vector<uint32_t> WireframeToSolid(std::span<const uint32_t> indices);
 
-	Object::Object(const std::vector<Vertex>& vertices, const Visuals::Material& material, RenderType renderType)
-	  : material(material), renderType(renderType)
+	//Geometry
+	ObjectGeometry::ObjectGeometry(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+	  : vertices(Utilities::ToFloatList(vertices)), indices(indices)
 	{
-		//Create indices and filter out duplicates
-		std::vector<Vertex> uniqueVertices;
-		std::vector<uint32_t> newIndices;
-		size_t i = 0;
-		for (Vertex v : vertices) {
-			int index = std::find(uniqueVertices.begin(), uniqueVertices.end(), v) - uniqueVertices.begin();
-			if(index == uniqueVertices.size()) {
-				uniqueVertices.emplace_back(v);
-			}
-			newIndices.emplace_back(index);
-			//Bounding box:
+		//Bounding box:
+		for (const Vertex& v : vertices) {
 			if(v.position.X < boundingBox.Low.X) boundingBox.Low.X = v.position.X;
 			if(v.position.X > boundingBox.High.X) boundingBox.High.X = v.position.X;
 			if(v.position.Y < boundingBox.Low.Y) boundingBox.Low.Y = v.position.Y;
@@ -42,61 +32,51 @@ namespace StevEngine::Renderer {
 			if(v.position.Z < boundingBox.Low.Z) boundingBox.Low.Z = v.position.Z;
 			if(v.position.Z > boundingBox.High.Z) boundingBox.High.Z = v.position.Z;
 		}
-		//Fill vertex and index arrays
-		auto floatVertices = ToFloatList(uniqueVertices);
-		vertexCount = floatVertices.size();
-		this->vertices = new float[vertexCount];
-		for(int i = 0; i < vertexCount; i++) {
-			this->vertices[i] = floatVertices[i];
-		}
-		indexCount = newIndices.size();
-		this->indices = new uint32_t[indexCount];
-		for(int i = 0; i < indexCount; i++) {
-			this->indices[i] = newIndices[i];
-		}
-		if(renderType == WIREFRAME) {
-			this->indices = SolidToWireframe(indices, indexCount);
-		}
 	}
+	ObjectGeometry::ObjectGeometry(const std::vector<Vertex>& vertices) {
+		//Create indices and filter out duplicates
+		std::vector<uint32_t> uniqueIndices;
+		std::vector<Vertex> uniqueVertices = Utilities::WeldVertices(vertices, uniqueIndices);
+		*this = ObjectGeometry(uniqueVertices, uniqueIndices);
+	}
+	ObjectGeometry::ObjectGeometry(std::span<const float> vertices, std::span<const uint32_t> indices, const Utilities::Range3& boundingBox, std::shared_ptr<const void> file)
+	  : file(file), fileVertices(vertices), fileIndices(indices), boundingBox(boundingBox) {}
+
+	//Constructors
+	Object::Object(const std::vector<Vertex>& vertices, const Visuals::Material& material, RenderType renderType)
+	  : Object(std::make_shared<ObjectGeometry>(vertices), material, renderType) {}
 	Object::Object(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,  const Visuals::Material& material, RenderType renderType)
-	  : vertices(new float[vertices.size()]), indexCount(indices.size()), material(material), renderType(renderType)
+	  : Object(std::make_shared<ObjectGeometry>(vertices, indices), material, renderType) {}
+	Object::Object(std::shared_ptr<ObjectGeometry> geometry, const Visuals::Material& material, RenderType renderType)
+	  : geometry(geometry), material(material), renderType(SOLID)
 	{
-		auto floatVertices = ToFloatList(vertices);
-		vertexCount = floatVertices.size();
-		this->vertices = new float[vertexCount];
-		for(int i = 0; i < vertexCount; i++) {
-			this->vertices[i] = floatVertices[i];
-		}
-		this->indices = new uint32_t[indexCount];
-		for(int i = 0; i < indexCount; i++) {
-			this->indices[i] = indices[i];
-		}
-		if(renderType == WIREFRAME) {
-			this->indices = SolidToWireframe(this->indices, indexCount);
-		}
-		//Bounding box:
-		for (Vertex v : vertices) {
-			if(v.position.X < boundingBox.Low.X) boundingBox.Low.X = v.position.X;
-			if(v.position.X > boundingBox.High.X) boundingBox.High.X = v.position.X;
-			if(v.position.Y < boundingBox.Low.Y) boundingBox.Low.Y = v.position.Y;
-			if(v.position.Y > boundingBox.High.Y) boundingBox.High.Y = v.position.Y;
-			if(v.position.Z < boundingBox.Low.Z) boundingBox.Low.Z = v.position.Z;
-			if(v.position.Z > boundingBox.High.Z) boundingBox.High.Z = v.position.Z;
-		}
+		SetRenderType(renderType);
 	}
 	Object::Object(const Object& instance)
-	  : indices(instance.indices), indexCount(instance.indexCount), vertices(instance.vertices), vertexCount(instance.vertexCount), material(instance.material), boundingBox(instance.boundingBox), renderType(instance.renderType) {}
+	  : geometry(instance.geometry), material(instance.material), renderType(instance.renderType), instanced(instance.instanced) {}
 
 	//Set render type
 	void Object::SetRenderType(RenderType type) {
 		if(renderType == type) return;
-		if(type == WIREFRAME) {
-			//Convert from solid to wireframe
-			indices = SolidToWireframe(indices, indexCount);
-		} else {
-			//Convert from wireframe to solid
-			indices = WireframeToSolid(indices, indexCount);
+		//Objects sharing the geometry keep it, and share the converted geometry while it is in use
+		std::shared_ptr<ObjectGeometry> converted = geometry->converted.lock();
+		if(!converted) {
+			converted = std::make_shared<ObjectGeometry>(*geometry);
+			converted->gpuMesh.reset();
+			//Only the indices are copied, vertices in a mapped file stay there
+			if(type == WIREFRAME) {
+				//Convert from solid to wireframe
+				converted->indices = SolidToWireframe(geometry->GetIndices());
+			} else {
+				//Convert from wireframe to solid
+				converted->indices = WireframeToSolid(geometry->GetIndices());
+			}
+			converted->fileIndices = {};
+			converted->converted = geometry;
+			geometry->converted = converted;
 		}
+		//The new indices are uploaded on next draw
+		geometry = converted;
 		renderType = type;
 	}
 	//Shaders
@@ -110,71 +90,87 @@ namespace StevEngine::Renderer {
 	}
 
 	//Draw
-	void Object::Draw(Utilities::Matrix4 transform) const {
+	void Object::Draw(const Utilities::Matrix4f& transform) const {
 		//Object specific shaders
-		uint32_t pipeline;
-		const ShaderProgram* vertexProgram = &render.GetDefaultVertexShaderProgram();
-		const ShaderProgram* fragmentProgram = &render.GetDefaultFragmentShaderProgram();
-		bool usingCustomShaders = shaders.size() > 0;
-		bool usingCustomFragmentShader = false;
-		if(usingCustomShaders) {
-			//Set shader programs
-			glGenProgramPipelines(1, &pipeline);
-			glBindProgramPipeline(pipeline);
-			if(shaders.contains(VERTEX)) {
-				vertexProgram = &shaders.at(VERTEX);
-			}
-			glUseProgramStages(pipeline, GL_VERTEX_SHADER_BIT, vertexProgram->GetLocation());
-			if(shaders.contains(FRAGMENT)) {
-				fragmentProgram = &shaders.at(FRAGMENT);
-				usingCustomFragmentShader = true;
-			}
-			glUseProgramStages(pipeline, GL_FRAGMENT_SHADER_BIT, fragmentProgram->GetLocation());
-			//Update program with basic info
-			Visuals::Camera* camera = sceneManager.GetActiveScene().GetCamera();
-			//  View matrix
-			vertexProgram->SetShaderUniform("viewTransform", camera->GetView());
-			fragmentProgram->SetShaderUniform("viewPosition", camera->GetParent().GetWorldPosition());
-			fragmentProgram->SetShaderUniform("viewDirection", camera->GetParent().GetWorldRotation().Forward());
-			//  Projection matrix
-			vertexProgram->SetShaderUniform("projectionTransform", camera->GetProjection());
-			//  Ambient lighting
-			fragmentProgram->SetShaderUniform("ambientColor", render.GetAmbientLightColor());
-			fragmentProgram->SetShaderUniform("ambientStrength", render.GetAmbientLightStrength());
-			//	Other lights
-			for(auto light : render.GetLights()) {
-				light->UpdateShader(*fragmentProgram);
-			}
-		}
+		const ShaderProgram& vertexProgram = shaders.contains(VERTEX) ? shaders.at(VERTEX) : render.GetDefaultVertexShaderProgram();
+		const ShaderProgram& fragmentProgram = shaders.contains(FRAGMENT) ? shaders.at(FRAGMENT) : render.GetDefaultFragmentShaderProgram();
+		render.UseShaderPrograms(vertexProgram, fragmentProgram);
 		//Update transform
-		vertexProgram->SetShaderUniform("objectTransform", transform);
+		vertexProgram.SetShaderUniform("objectTransform", transform);
 		//Update material
 		UpdateShaderMaterial();
 		//Draw object
 		UpdateBuffers();
-		glDrawElements(renderType == WIREFRAME ? GL_LINES : GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
-		//Remove custom pipeline
-		if(usingCustomShaders) {
-			//Reset lights
-			if(usingCustomFragmentShader) {
-				for(Light* light : render.GetLights()) {
-					light->ResetShader(*fragmentProgram);
-				}
-			}
-			glBindProgramPipeline(render.GetShaderPipeline());
-			glDeleteProgramPipelines(1, &pipeline);
-		}
+		render.GetMeshBuffers().Draw(geometry->gpuMesh->allocation, renderType == WIREFRAME ? GL_LINES : GL_TRIANGLES);
+	}
+
+	void Object::DrawInstanced(uint32_t firstInstance, uint32_t instanceCount) const {
+		const ShaderProgram& vertexProgram = render.GetDefaultVertexShaderProgram();
+		const ShaderProgram& fragmentProgram = render.GetDefaultFragmentShaderProgram();
+		render.UseShaderPrograms(vertexProgram, fragmentProgram);
+		//Read transform and color per instance
+		vertexProgram.SetShaderUniform("instanced", true);
+		fragmentProgram.SetShaderUniform("instanced", true);
+		//Update material
+		UpdateShaderMaterial();
+		//Draw instances
+		UpdateBuffers();
+		render.GetMeshBuffers().DrawInstanced(geometry->gpuMesh->allocation, renderType == WIREFRAME ? GL_LINES : GL_TRIANGLES, firstInstance, instanceCount);
+		//Back to uniforms
+		vertexProgram.SetShaderUniform("instanced", false);
+		fragmentProgram.SetShaderUniform("instanced", false);
+	}
+
+	bool Object::CanInstanceWith(const Object& other) const {
+		return IsInstanced() && other.IsInstanced() && geometry->gpuMesh && geometry->gpuMesh == other.geometry->gpuMesh
+			&& renderType == other.renderType && material.SharesShadingWith(other.material);
+	}
+
+	uint64_t Object::GetStateKey() const {
+		//Shader pipeline, 0 for the default shaders
+		uint64_t pipeline = 0;
+		for(const auto& [type, program] : shaders) pipeline = pipeline * 31 + program.GetLocation();
+		if(!shaders.empty()) pipeline = pipeline % 255 + 1;
+		//Material, except color which can change without rebinding anything else
+		size_t materialHash = 0;
+		auto combine = [&materialHash] (double value) { materialHash = materialHash * 31 + std::hash<double>()(value); };
+		for(const Utilities::Vector3& vector : { material.ambient, material.diffuse, material.specular }) {
+			combine(vector.X);
+			combine(vector.Y);
+			combine(vector.Z);
+		}
+		combine(material.shininess);
+		//Textures
+		uint64_t textures = material.GetAlbedo().IsBound() ? material.GetAlbedo().GetGLLocation() : 0;
+		textures = textures * 31 + (material.GetNormal().IsBound() ? material.GetNormal().GetGLLocation() : 0);
+		//Geometry
+		uint64_t mesh = geometry->gpuMesh ? geometry->gpuMesh->allocation.vertices.start : 0;
+		return (pipeline << 40) | ((materialHash & 0xFFFF) << 24) | ((textures & 0xFFF) << 12) | (mesh & 0xFFF);
 	}
 
 	void Object::UpdateBuffers() const {
-		glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(float), vertices, GL_STATIC_DRAW);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		if(geometry->gpuMesh) return;
+		std::span<const float> vertices = geometry->GetVertices();
+		std::span<const uint32_t> indices = geometry->GetIndices();
+		geometry->gpuMesh = render.GetMeshBuffers().Upload(vertices.data(), vertices.size() / Utilities::VERTEX_COUNT, indices.data(), indices.size());
+		//Mapped data is only read again if the render type changes, so let the system drop it from memory
+		if(geometry->file) {
+			Utilities::MappedFile::Evict(vertices.data(), vertices.size_bytes());
+			if(geometry->fileIndices.data()) Utilities::MappedFile::Evict(indices.data(), indices.size_bytes());
+		}
 	}
 
 	void Object::UpdateShaderMaterial() const {
 		//Find fragment shader
 		const ShaderProgram* fragmentProgram = &render.GetDefaultFragmentShaderProgram();
 		if(shaders.contains(FRAGMENT)) fragmentProgram = &shaders.at(FRAGMENT);
+		//Skip what the previous object already set
+		const Visuals::Material* current = render.GetCurrentMaterial(*fragmentProgram);
+		render.SetCurrentMaterial(*fragmentProgram, material);
+		bool sameShading = current && current->SharesShadingWith(material);
+		//Material values are in the materials uniform block
+		if(!sameShading || !(current->color == material.color)) fragmentProgram->SetShaderUniform("materialIndex", render.GetMaterialIndex(material));
+		if(sameShading) return;
 		//Update texture
 		const Visuals::Texture& albedo = material.GetAlbedo();
 		bool isAlbedoTextured = albedo.IsBound();
@@ -193,38 +189,11 @@ namespace StevEngine::Renderer {
 			glBindTexture(GL_TEXTURE_2D, normalMap.GetGLLocation());
 			fragmentProgram->SetShaderUniform("normalTexture", 1);
 		}
-		//Update color
-		fragmentProgram->SetShaderUniform("objectMaterial.color", material.color);
-		//Update material
-		fragmentProgram->SetShaderUniform("objectMaterial.ambient", material.ambient);
-		fragmentProgram->SetShaderUniform("objectMaterial.diffuse", material.diffuse);
-		fragmentProgram->SetShaderUniform("objectMaterial.specular", material.specular);
-		fragmentProgram->SetShaderUniform("objectMaterial.shininess", material.shininess);
 	}
 
-	std::vector<float> ToFloatList(const std::vector<Vertex>& vertices) {
-		std::vector<float> result;
-		result.resize(vertices.size() * (Utilities::VERTEX_COUNT));
-		int j = 0;
-		for(int i = 0; i < vertices.size(); i++) {
-			const Vertex& vertex = vertices[i];
-			result[j++] = vertex.position.X;
-			result[j++] = vertex.position.Y;
-			result[j++] = vertex.position.Z;
-			result[j++] = vertex.uv.X;
-			result[j++] = vertex.uv.Y;
-			result[j++] = vertex.normal.X;
-			result[j++] = vertex.normal.Y;
-			result[j++] = vertex.normal.Z;
-			result[j++] = vertex.tangent.X;
-			result[j++] = vertex.tangent.Y;
-			result[j++] = vertex.tangent.Z;
-		}
-		return result;
-	}
-	uint32_t* SolidToWireframe(uint32_t* indices, uint32_t& size) {
-		uint32_t* newIndices = new uint32_t[size * 2];
-		for(int i = 0; i < size; i+=3) {
+	std::vector<uint32_t> SolidToWireframe(std::span<const uint32_t> indices) {
+		std::vector<uint32_t> newIndices(indices.size() * 2);
+		for(int i = 0; i + 2 < indices.size(); i+=3) {
 			newIndices[i*2] = indices[i];
 			newIndices[i*2+1] = indices[i + 1];
 			newIndices[i*2+2] = indices[i + 1];
@@ -232,17 +201,13 @@ namespace StevEngine::Renderer {
 			newIndices[i*2+4] = indices[i + 2];
 			newIndices[i*2+5] = indices[i];
 		}
-		size *= 2;
-		delete[] indices;
 		return newIndices;
 	}
-	uint32_t* WireframeToSolid(uint32_t* indices, uint32_t& size) {
-		size /= 2;
-		uint32_t* newIndices = new uint32_t[size];
-		for(int i = 0; i < size; i++) {
+	std::vector<uint32_t> WireframeToSolid(std::span<const uint32_t> indices) {
+		std::vector<uint32_t> newIndices(indices.size() / 2);
+		for(int i = 0; i < newIndices.size(); i++) {
 			newIndices[i] = indices[i * 2];
 		}
-		delete[] indices;
 		return newIndices;
 	}
 }
@@ -3,12 +3,15 @@
 #ifdef StevEngine_RENDERER_GL
 #include <vector>
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <SDL.h>
 #include <glad/gl.h>
 
 #include "utilities/Vertex.hpp"
 #include "utilities/Matrix4.hpp"
 #include "visuals/Material.hpp"
+#include "visuals/renderer/MeshBuffers.hpp"
 #include "visuals/shaders/ShaderProgram.hpp"
 
 namespace StevEngine::Renderer {
@@ -22,9 +25,17 @@ namespace StevEngine::Renderer {
 		public:
 			/**
 			 * @brief Draw the object with transform
-			 * @param transform World transform matrix to apply
+			 * @param transform Transform relative to the camera to apply
 			 */
-			virtual void Draw(Utilities::Matrix4 transform) const = 0;
+			virtual void Draw(const Utilities::Matrix4f& transform) const = 0;
+
+			/**
+			 * @brief Get key of the GL state the object is drawn with
+			 *
+			 * Render queues sort by this key, so objects drawn with the same state are drawn one after another.
+			 * @return 48 bit state key, objects with the same key should need no state changes between them
+			 */
+			virtual uint64_t GetStateKey() const { return 0; }
 	};
 
 	enum RenderType {
@@ -32,6 +43,59 @@ namespace StevEngine::Renderer {
 		WIREFRAME
 	};
 
+	/**
+	 * @brief Vertex and index data of an object
+	 *
+	 * Shared by every copy of an object and every object created from the same mesh asset,
+	 * so they are uploaded once and drawn from the same geometry.
+	 */
+	struct ObjectGeometry {
+		/**
+		 * @brief Create geometry from vertices and indices
+		 * @param vertices Array of vertex data
+		 * @param indices Array of vertex indices, of triangles
+		 */
+		ObjectGeometry(const std::vector<Utilities::Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+		/**
+		 * @brief Create geometry from unindexed vertices, merging vertices with the same attributes
+		 * @param vertices Array of vertex data, three for each triangle
+		 */
+		ObjectGeometry(const std::vector<Utilities::Vertex>& vertices);
+
+		/**
+		 * @brief Create geometry from vertex data in a memory mapped file, such as a baked model
+		 *
+		 * The data is not copied, it is uploaded straight from the file.
+		 * @param vertices Vertex data, VERTEX_COUNT floats per vertex
+		 * @param indices Array of vertex indices, of triangles
+		 * @param boundingBox Bounding box of the vertices
+		 * @param file Owner of the mapped data, kept alive by the geometry
+		 */
+		ObjectGeometry(std::span<const float> vertices, std::span<const uint32_t> indices, const Utilities::Range3& boundingBox, std::shared_ptr<const void> file);
+
+		/**
+		 * @brief Get vertex data, from the mapped file or owned
+		 * @return VERTEX_COUNT floats per vertex
+		 */
+		std::span<const float> GetVertices() const { return file ? fileVertices : std::span<const float>(vertices); }
+
+		/**
+		 * @brief Get index data, from the mapped file or owned
+		 * @return Vertex indices
+		 */
+		std::span<const uint32_t> GetIndices() const { return file && fileIndices.data() ? fileIndices : std::span<const uint32_t>(indices); }
+
+		std::vector<float> vertices;	   ///< Owned vertex data, VERTEX_COUNT floats per vertex, empty if in a mapped file
+		std::vector<uint32_t> indices;	 ///< Owned index data, empty if in a mapped file
+		std::shared_ptr<const void> file;	   ///< Owner of mapped vertex data, nullptr if owned
+		std::span<const float> fileVertices;	   ///< Vertex data in the mapped file
+		std::span<const uint32_t> fileIndices;  ///< Index data in the mapped file, empty once converted to owned indices
+		Utilities::Range3 boundingBox;	 ///< Bounding box of the vertices
+		std::shared_ptr<GPUMesh> gpuMesh;  ///< Uploaded geometry, nullptr before the first upload
+		std::weak_ptr<ObjectGeometry> converted;  ///< Same vertices with the indices of the other render type, if in use
+	};
+
 	/**
 	 * @brief Standard renderable mesh object
 	 *
@@ -42,6 +106,8 @@ namespace StevEngine::Renderer {
 		public:
 			/**
 			 * @brief Create object from vertices
+			 *
+			 * Vertices with the same attributes are merged, and drawn through indices.
 			 * @param vertices Array of vertex data
 			 * @param material Material to render with
 			 */
@@ -56,7 +122,14 @@ namespace StevEngine::Renderer {
 			Object(const std::vector<Utilities::Vertex>& vertices, const std::vector<uint32_t>& indices, const Visuals::Material& material, RenderType renderType = SOLID);
 
 			/**
-			 * @brief Copy constructor
+			 * @brief Create object from shared geometry
+			 * @param geometry Geometry of triangles, such as a mesh asset
+			 * @param material Material to render with
+			 */
+			Object(std::shared_ptr<ObjectGeometry> geometry, const Visuals::Material& material, RenderType renderType = SOLID);
+
+			/**
+			 * @brief Copy constructor, the copy shares the geometry of the object
 			 * @param instance Object to copy
 			 */
 			Object(const Object& instance);
@@ -78,12 +151,54 @@ namespace StevEngine::Renderer {
 
 			/**
 			 * @brief Draw object with transform
-			 * @param transform World transform matrix
+			 * @param transform Transform relative to the camera
+			 */
+			void Draw(const Utilities::Matrix4f& transform) const;
+
+			/**
+			 * @brief Draw copies of the object in one draw call, with transforms and colors from the instance buffer
+			 * @param firstInstance First instance in the instance buffer
+			 * @param instanceCount Number of instances
+			 */
+			void DrawInstanced(uint32_t firstInstance, uint32_t instanceCount) const;
+
+			/**
+			 * @brief Get key of the GL state the object is drawn with
+			 *
+			 * From most to least significant: shader pipeline, material without color, textures and geometry.
+			 * @return 48 bit state key
+			 */
+			uint64_t GetStateKey() const;
+
+			/**
+			 * @brief Check if the object can be drawn in the same instanced draw as another object
+			 *
+			 * Needs both to use the same uploaded geometry and the default shaders,
+			 * and materials that only differ in color.
+			 * @param other Object to compare with
+			 * @return Whether the objects can be drawn together
 			 */
-			void Draw(Utilities::Matrix4 transform) const;
+			bool CanInstanceWith(const Object& other) const;
 
 			/**
-			 * @brief Update GPU buffers with object vertex and index data
+			 * @brief Set if the object may be drawn together with other objects using the same geometry and material
+			 * @param instanced Whether instancing is allowed, true by default
+			 */
+			void SetInstanced(bool instanced) { this->instanced = instanced; }
+			/**
+			 * @brief Get if the object may be drawn together with other objects using the same geometry and material
+			 * @return Whether instancing is allowed
+			 */
+			bool IsInstanced() const { return instanced && shaders.empty(); }
+
+			/**
+			 * @brief Get uploaded geometry of the object
+			 * @return Uploaded geometry, or nullptr before the first upload
+			 */
+			const GPUMesh* GetGPUMesh() const { return geometry->gpuMesh.get(); }
+
+			/**
+			 * @brief Upload object vertex and index data to the GPU, if not uploaded since it changed
 			 */
 			void UpdateBuffers() const;
 
@@ -96,17 +211,22 @@ namespace StevEngine::Renderer {
 			 * @brief Get the number of indices in object
 			 * @return Number of indices
 			 */
-			uint32_t GetIndexCount() const { return indexCount; }
+			uint32_t GetIndexCount() const { return geometry->GetIndices().size(); }
 			/**
-			 * @brief Get the number of indices in object
-			 * @return Number of indices
+			 * @brief Get the number of vertices in object
+			 * @return Number of vertices
 			 */
-			uint32_t GetVertexCount() const { return vertexCount; }
+			uint32_t GetVertexCount() const { return geometry->GetVertices().size() / Utilities::VERTEX_COUNT; }
 			/**
 			 * @brief Get bouning box of object
 			 * @return Bounding box
 			 */
-			Utilities::Range3 GetBoundingBox() const { return boundingBox; }
+			Utilities::Range3 GetBoundingBox() const { return geometry->boundingBox; }
+			/**
+			 * @brief Get geometry of the object
+			 * @return Geometry shared with copies of the object
+			 */
+			const std::shared_ptr<ObjectGeometry>& GetGeometry() const { return geometry; }
 			/**
 			 * @brief Get the type of rendering used by this object
 			 * @return Render type
@@ -119,13 +239,10 @@ namespace StevEngine::Renderer {
 			void SetRenderType(RenderType type);
 
 		private:
-			float* vertices;	  ///< Vertex data array
-			uint32_t vertexCount;  ///< Number of vertices
-			uint32_t* indices;	///< Index data array
-			uint32_t indexCount;   ///< Number of indices
+			std::shared_ptr<ObjectGeometry> geometry;  ///< Vertex and index data, shared with copies of this object
 			std::map<Renderer::ShaderType, Renderer::ShaderProgram> shaders;  ///< Shader programs by type
-			Utilities::Range3 boundingBox; ///< Bounding box
 			RenderType renderType; ///> Render type
+			bool instanced = true;  ///< Whether the object may be drawn in instanced draws
 	};
 }
 #endif
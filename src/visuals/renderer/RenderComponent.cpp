@@ -1,6 +1,7 @@
 #ifdef StevEngine_RENDERER_GL
 #include "RenderComponent.hpp"
 #include "RenderSystem.hpp"
+#include "main/GameObject.hpp"
 #include "visuals/renderer/Object.hpp"
 #include "visuals/shaders/Shader.hpp"
 #include "utilities/Vector3.hpp"
@@ -10,7 +11,7 @@ namespace StevEngine::Renderer {
 	RenderComponent::RenderComponent(const Object& object)
 	  : object(object) {}
 	RenderComponent::RenderComponent(const Object& object, Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale)
-	  : position(position), rotation(rotation), scale(scale), object(object) {}
+	  : object(object), position(position), rotation(rotation), scale(scale) { UpdateOffset(); }
 	RenderComponent::RenderComponent(const Object& object, Utilities::Stream& stream)
 	  : object(object), position(stream.Read<Utilities::Vector3>()), rotation(stream.Read<Utilities::Quaternion>()), scale(stream.Read<Utilities::Vector3>())
 	{
@@ -21,18 +22,60 @@ namespace StevEngine::Renderer {
 		uint32_t shaderCount = stream.Read<uint32_t>();
 		for(uint32_t i = 0; i < shaderCount; i++)
 			AddShader(ShaderProgram(stream));
+		UpdateOffset();
 	}
 	//Destructor
 	RenderComponent::~RenderComponent() {
+		render.GetVisibility().Remove(*this);
 		object.material.FreeAlbedo();
 		object.material.FreeNormal();
 	}
+	//Visibility
+	void RenderComponent::Start() {
+		render.GetVisibility().Add(*this);
+	}
+	void RenderComponent::Deactivate() {
+		render.GetVisibility().Remove(*this);
+	}
+	void RenderComponent::UpdateOffset() {
+		offset = Utilities::Matrix4::FromTranslationRotationScale(position, rotation, scale);
+		//Culled components are not drawn, so the box has to follow right away
+		render.GetVisibility().Move(*this);
+	}
+	Utilities::Range3 RenderComponent::GetWorldBounds() {
+		return object.GetBoundingBox().Transformed(GetParent().GetWorldMatrix() * offset);
+	}
+	//Offsets
+	void RenderComponent::SetPosition(Utilities::Vector3 position) {
+		this->position = position;
+		UpdateOffset();
+	}
+	void RenderComponent::SetRotation(Utilities::Quaternion rotation) {
+		this->rotation = rotation;
+		UpdateOffset();
+	}
+	void RenderComponent::SetScale(Utilities::Vector3 scale) {
+		this->scale = scale;
+		UpdateOffset();
+	}
+	void RenderComponent::SetTransform(Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale) {
+		this->position = position;
+		this->rotation = rotation;
+		this->scale = scale;
+		UpdateOffset();
+	}
+	//Object
+	void RenderComponent::SetRenderObject(const Object& object) {
+		this->object = object;
+		render.GetVisibility().Move(*this);
+	}
+	void RenderComponent::SetRenderType(RenderType type) {
+		object.SetRenderType(type);
+		render.GetVisibility().Move(*this);
+	}
 	//Main draw function
-	void RenderComponent::Draw(const Utilities::Matrix4& transform) {
-		//New transform
-		Utilities::Matrix4 trnsfm = transform * Utilities::Matrix4::FromTranslationRotationScale(position, rotation, scale);
-		//Draw
-		Renderer::render.DrawObject(object, trnsfm);
+	void RenderComponent::Submit() {
+		render.DrawObject(object, GetParent().GetWorldMatrix() * offset);
 	}
 	void RenderComponent::AddShader(ShaderProgram program) {
 		object.AddShader(program);
@@ -2,8 +2,11 @@
 #ifdef StevEngine_RENDERER_GL
 #include "Object.hpp"
 #include "main/Component.hpp"
+#include "utilities/Matrix4.hpp"
+#include "utilities/Range3.hpp"
 #include "utilities/Vector3.hpp"
 #include "utilities/Quaternion.hpp"
+#include "utilities/BoundingVolumeTree.hpp"
 #include "visuals/shaders/Shader.hpp"
 
 #include <SDL.h>
@@ -15,8 +18,11 @@ namespace StevEngine::Renderer {
 	 *
 	 * Component that adds rendering capability to game objects.
 	 * Handles transform offsets and shader management.
+	 * While active it is tracked by the VisibilitySystem, which only submits it to the renderer when it is in view.
 	 */
 	class RenderComponent : public Component {
+		friend class VisibilitySystem;
+
 		public:
 			/**
 			 * @brief Create render component
@@ -46,16 +52,67 @@ namespace StevEngine::Renderer {
 			 */
 			virtual std::string GetType() const { return "RenderComponent"; }
 
+			/**
+			 * @brief Get local position offset
+			 * @return Position offset
+			 */
+			Utilities::Vector3 GetPosition() const { return position; }
+
+			/**
+			 * @brief Get local rotation offset
+			 * @return Rotation offset
+			 */
+			Utilities::Quaternion GetRotation() const { return rotation; }
+
+			/**
+			 * @brief Get local scale modifier
+			 * @return Scale modifier
+			 */
+			Utilities::Vector3 GetScale() const { return scale; }
 
-			Utilities::Vector3 position = Utilities::Vector3(); /// Local position offset
-			Utilities::Quaternion rotation = Utilities::Quaternion(); /// Local rotation offset
-			Utilities::Vector3 scale = Utilities::Vector3(1, 1, 1); /// Local scale modifier
+			/**
+			 * @brief Set local position offset
+			 * @param position New position offset
+			 */
+			void SetPosition(Utilities::Vector3 position);
+
+			/**
+			 * @brief Set local rotation offset
+			 * @param rotation New rotation offset
+			 */
+			void SetRotation(Utilities::Quaternion rotation);
+
+			/**
+			 * @brief Set local scale modifier
+			 * @param scale New scale modifier
+			 */
+			void SetScale(Utilities::Vector3 scale);
+
+			/**
+			 * @brief Set all local offsets
+			 * @param position New position offset
+			 * @param rotation New rotation offset
+			 * @param scale New scale modifier
+			 */
+			void SetTransform(Utilities::Vector3 position, Utilities::Quaternion rotation, Utilities::Vector3 scale);
 
 			/**
 			 * @brief Get renderable object
 			 * @return Reference to object
 			 */
-			Object& GetObject() { return object; };
+			const Object& GetObject() const { return object; };
+
+			/**
+			 * @brief Replace renderable object
+			 * @param object New renderable object
+			 */
+			void SetRenderObject(const Object& object);
+
+			/**
+			 * @brief Set how the object is drawn
+			 * @param type New render type
+			 */
+			void SetRenderType(RenderType type);
 
 			/**
 			 * @brief Get material
@@ -75,6 +132,18 @@ namespace StevEngine::Renderer {
 			 */
 			void RemoveShader(ShaderType type);
 
+			/**
+			 * @brief Get world space bounding box
+			 * @return Bounding box of the object after the object and offset transforms
+			 */
+			Utilities::Range3 GetWorldBounds();
+
+			/** @brief Start tracking visibility */
+			void Start();
+
+			/** @brief Stop tracking visibility */
+			void Deactivate();
+
 			/**
 			 * @brief Clean up component resources
 			 */
@@ -94,11 +163,19 @@ namespace StevEngine::Renderer {
 			std::map<ShaderType, ShaderProgram> shaders;
 
 		private:
+			/** @brief Queue the object for drawing, called by the VisibilitySystem when in view */
+			void Submit();
+
 			/**
-			 * @brief Draw component
-			 * @param transform World transform matrix
+			 * @brief Recalculate the offset matrix, and move the bounding box in the VisibilitySystem
 			 */
-			void Draw(const Utilities::Matrix4& transform);
+			void UpdateOffset();
+
+			Utilities::Vector3 position = Utilities::Vector3();				 ///< Local position offset
+			Utilities::Quaternion rotation = Utilities::Quaternion();		 ///< Local rotation offset
+			Utilities::Vector3 scale = Utilities::Vector3(1, 1, 1);			 ///< Local scale modifier
+			uint32_t visibilityProxy = Utilities::BoundingVolumeTree::none;  ///< Proxy in the VisibilitySystem's tree
+			Utilities::Matrix4 offset = Utilities::Matrix4();				 ///< Offset matrix of the current offsets
 	};
 }
 #endif
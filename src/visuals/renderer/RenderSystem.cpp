@@ -3,6 +3,7 @@
 #include "main/Log.hpp"
 #include "main/Engine.hpp"
 #include "main/EngineEvents.hpp"
+#include "main/Profiler.hpp"
 #include "data/Settings.hpp"
 #include "main/SceneManager.hpp"
 #include "visuals/renderer/Object.hpp"
@@ -12,6 +13,8 @@
 #include "visuals/Camera.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <string_view>
 #include <glad/gl.h>
 
 using namespace StevEngine::Visuals;
@@ -66,23 +69,28 @@ namespace StevEngine::Renderer {
 		//Clear viewport
 		glClearColor(backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
 		//Buffers
-		glGenVertexArrays(1, &VAO);
-		glBindVertexArray(VAO);
-		glGenBuffers(1, &VBO);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glGenBuffers(1, &EBO);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-		// position layout
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, Utilities::VERTEX_SIZE, (void*)0);
-		glEnableVertexAttribArray(0);
-		// uv layout
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, Utilities::VERTEX_SIZE, (void*)((3) * sizeof(float)));
-		glEnableVertexAttribArray(1);
-		// Normal and Tangent layout
-		glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, Utilities::VERTEX_SIZE, (void*)((3 + 2) * sizeof(float)));
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, Utilities::VERTEX_SIZE, (void*)((3 + 2 + 3) * sizeof(float)));
-		glEnableVertexAttribArray(3);
+		meshBuffers = std::make_shared<MeshBuffers>();
+		meshBuffers->Init();
+		//  Uniform blocks, in one buffer at offsets aligned as required
+		GLint alignment = 256;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		auto align = [alignment] (size_t offset) { return (uint32_t)((offset + alignment - 1) / alignment * alignment); };
+		lightsOffset = align(sizeof(CameraBlock));
+		uniformBufferSize = lightsOffset + sizeof(LightsBlock);
+		glGenBuffers(1, &uniformBuffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+		glBufferData(GL_UNIFORM_BUFFER, uniformBufferSize, NULL, GL_STREAM_DRAW);
+		glBindBufferRange(GL_UNIFORM_BUFFER, CAMERA_BLOCK, uniformBuffer, 0, sizeof(CameraBlock));
+		glBindBufferRange(GL_UNIFORM_BUFFER, LIGHTS_BLOCK, uniformBuffer, lightsOffset, sizeof(LightsBlock));
+		//  Materials storage block, zeroed so nothing is read from uninitialized memory before the first frame
+		std::vector<MaterialData> emptyMaterials(INITIAL_MATERIALS);
+		materialsCapacity = INITIAL_MATERIALS;
+		glGenBuffers(1, &materialsBuffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, materialsBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, materialsCapacity * sizeof(MaterialData), emptyMaterials.data(), GL_STREAM_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MATERIALS_BLOCK, materialsBuffer);
+		//  Light storage blocks
+		lightClusters.Init();
 
 		//Shaders
 		ResetGlobalShader(VERTEX);
@@ -153,6 +161,9 @@ namespace StevEngine::Renderer {
 		glBindProgramPipeline(shaderPipeline);
 		glUseProgramStages(shaderPipeline, GL_VERTEX_SHADER_BIT, vertexShaderProgram.GetLocation());
 		glUseProgramStages(shaderPipeline, GL_FRAGMENT_SHADER_BIT, fragmentShaderProgram.GetLocation());
+		boundPipeline = shaderPipeline;
+		currentMaterial = nullptr;
+		ClearPipelines();
 	}
 
 	void RenderSystem::AddGlobalShader(ShaderProgram shader) {
@@ -170,61 +181,302 @@ namespace StevEngine::Renderer {
 		glBindProgramPipeline(shaderPipeline);
 		glUseProgramStages(shaderPipeline, GL_VERTEX_SHADER_BIT, vertexShaderProgram.GetLocation());
 		glUseProgramStages(shaderPipeline, GL_FRAGMENT_SHADER_BIT, fragmentShaderProgram.GetLocation());
+		boundPipeline = shaderPipeline;
+		currentMaterial = nullptr;
+		ClearPipelines();
 	}
 
 	void RenderSystem::ResetGPUBuffers() {
-		glBindVertexArray(VAO);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+		meshBuffers->Bind();
 	}
 
-	void RenderSystem::DrawObject(const CustomObject& object, Utilities::Matrix4 transform, RenderQueue queue) {
-		queues[queue].emplace_back(object, transform);
+	void RenderSystem::DrawObject(const CustomObject& object, const Utilities::Matrix4& transform, RenderQueue queue) {
+		queues[queue].emplace_back(object, transform.ToFloatRelative(GetRenderOrigin()));
 	};
 
+	const Utilities::Vector3& RenderSystem::GetRenderOrigin() {
+		if(!hasRenderOrigin) {
+			renderOrigin = sceneManager.GetActiveScene().GetCamera()->GetParent().GetWorldPosition();
+			hasRenderOrigin = true;
+		}
+		return renderOrigin;
+	}
+
 	void RenderSystem::DrawFrame() {
-		if(!enabled) return;
+		if(!enabled) {
+			for(std::vector<RenderObject>& queue : queues) queue.clear();
+			hasRenderOrigin = false;
+			return;
+		}
+		StevEngine_PROFILE_ZONE("RenderSystem::DrawFrame");
 		glUseProgram(0);
-		glBindProgramPipeline(render.GetShaderPipeline());
+		ResetDrawState();
 		//Clear color and depth buffers
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		//Bind vertex array
 		ResetGPUBuffers();
 
+		//Sort queues, and collect their instances and materials
+		instances.clear();
+		materials.clear();
+		materialIndices.clear();
+		materialsByContent.clear();
+		uniformsUploaded = false;
+		for(int i = 0; i < queues.size(); i++) {
+			PrepareQueue(queues[i], drawLists[i], (RenderQueue)i);
+		}
+
 		//Camera matrices
 		Visuals::Camera* camera = sceneManager.GetActiveScene().GetCamera();
-		//  View matrix
-		vertexShaderProgram.SetShaderUniform("viewTransform", camera->GetView());
-		fragmentShaderProgram.SetShaderUniform("viewPosition", camera->GetParent().GetWorldPosition());
-		fragmentShaderProgram.SetShaderUniform("viewDirection", camera->GetParent().GetWorldRotation().Forward());
+		Utilities::Matrix4 view = camera->GetRelativeView();
+		Utilities::Matrix4 projection = camera->GetProjection();
+		//  View matrix, positions are relative to the camera
+		cameraBlock.viewTransform = view.ToFloat();
+		cameraBlock.viewPosition = Utilities::Vector3().ToFloat();
+		cameraBlock.viewDirection = camera->GetParent().GetWorldRotation().Forward().ToFloat();
 		//  Projection matrix
-		vertexShaderProgram.SetShaderUniform("projectionTransform", camera->GetProjection());
+		cameraBlock.projectionTransform = projection.ToFloat();
 		//Lights
-		for(Light* light : lights) {
-			light->UpdateShader(fragmentShaderProgram);
-		}
+		PrepareLights(view, projection);
+		//Upload everything for the frame
+		UploadUniforms();
+		meshBuffers->UploadInstances(instances.data(), instances.size());
 
 		//Set background color
 		glClearColor(backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
 
 		//Render objects from each render queue
+		drawCallCount = 0;
 		for(int i = 0; i < queues.size(); i++) {
 			//Enable depth masking?
 			if(i == RenderQueue::TRANSPARENT) glDepthMask(GL_FALSE);
 			else glDepthMask(GL_TRUE);
 			//Draw objects
-			for(RenderObject& object : queues[i]) {
-				object.Draw();
-			}
-			//Clear queue
-			queues[i].clear();
+			DrawQueue(queues[i], drawLists[i]);
 		}
+		ResetDrawState();
+		//Read camera position again next frame
+		hasRenderOrigin = false;
 
 		// Refresh OpenGL window
 		SDL_GL_SwapWindow(engine->window);
 	}
 
+	//Depth for sort keys, the top 16 bits of the squared distance to the camera, which sort the same as the float
+	static uint64_t DepthKey(const Utilities::Matrix4f& transform) {
+		const float* values = transform.data();
+		float distance = values[12] * values[12] + values[13] * values[13] + values[14] * values[14];
+		uint32_t bits;
+		std::memcpy(&bits, &distance, sizeof(bits));
+		return bits >> 16;
+	}
+
+	void RenderSystem::PrepareQueue(const std::vector<RenderObject>& queue, QueueDrawList& list, RenderQueue type) {
+		StevEngine_PROFILE_ZONE("RenderSystem::PrepareQueue");
+		//Sort keys
+		std::vector<DrawItem>& order = list.order;
+		order.resize(queue.size());
+		for(uint32_t i = 0; i < queue.size(); i++) {
+			const Object* object = dynamic_cast<const Object*>(&queue[i].object);
+			if(object) {
+				object->UpdateBuffers();
+				GetMaterialIndex(object->material);
+			}
+			uint64_t state = queue[i].object.GetStateKey() & 0xFFFFFFFFFFFF;
+			uint64_t depth = DepthKey(queue[i].transform);
+			uint64_t key = 0;
+			if(type == RenderQueue::STANDARD) key = (state << 16) | depth;
+			else if(type == RenderQueue::TRANSPARENT) key = ((0xFFFF - depth) << 48) | state;
+			order[i] = { key, i, object };
+		}
+		if(type != RenderQueue::OVERLAY) {
+			std::sort(order.begin(), order.end(), [] (const DrawItem& a, const DrawItem& b) {
+				return a.key != b.key ? a.key < b.key : a.index < b.index;
+			});
+		}
+		//Group objects by geometry, then by material, keeping transparent objects in depth order
+		std::vector<InstanceBatch>& batches = list.batches;
+		batches.clear();
+		meshBatches.clear();
+		list.objectBatches.assign(queue.size(), noBatch);
+		for(uint32_t i = 0; i < order.size(); i++) {
+			const Object* object = order[i].object;
+			if(!object || !object->IsInstanced() || type == RenderQueue::TRANSPARENT) continue;
+			uint32_t& head = meshBatches.try_emplace(object->GetGPUMesh(), noBatch).first->second;
+			uint32_t batch = head;
+			while(batch != noBatch && !object->CanInstanceWith(*batches[batch].object)) batch = batches[batch].next;
+			if(batch == noBatch) {
+				batch = batches.size();
+				batches.push_back({ object, i, 0, 0, 0, head });
+				head = batch;
+			}
+			batches[batch].count++;
+			list.objectBatches[i] = batch;
+		}
+		//Give each batch of more than one object a range of instances, after those of earlier queues
+		uint32_t instanceCount = instances.size();
+		for(InstanceBatch& batch : batches) {
+			batch.firstInstance = instanceCount;
+			if(batch.count > 1) instanceCount += batch.count;
+		}
+		instances.resize(instanceCount);
+		for(uint32_t i = 0; i < order.size(); i++) {
+			if(list.objectBatches[i] == noBatch) continue;
+			InstanceBatch& batch = batches[list.objectBatches[i]];
+			if(batch.count < 2) continue;
+			InstanceData& instance = instances[batch.firstInstance + batch.added++];
+			instance.transform = queue[order[i].index].transform;
+			const Utilities::Color& color = order[i].object->material.color;
+			instance.color[0] = color.r / 255.0f;
+			instance.color[1] = color.g / 255.0f;
+			instance.color[2] = color.b / 255.0f;
+			instance.color[3] = color.a / 255.0f;
+		}
+	}
+
+	void RenderSystem::DrawQueue(std::vector<RenderObject>& queue, const QueueDrawList& list) {
+		StevEngine_PROFILE_ZONE("RenderSystem::DrawQueue");
+		//Draw single objects, and batches in place of their first object
+		for(uint32_t i = 0; i < list.order.size(); i++) {
+			const DrawItem& item = list.order[i];
+			uint32_t batchIndex = list.objectBatches[i];
+			if(!item.object) {
+				//Custom objects may change any state
+				ResetDrawState();
+				queue[item.index].Draw();
+				ResetDrawState();
+				drawCallCount++;
+			} else if(batchIndex == noBatch || list.batches[batchIndex].count < 2) {
+				queue[item.index].Draw();
+				drawCallCount++;
+			} else if(list.batches[batchIndex].firstObject == i) {
+				const InstanceBatch& batch = list.batches[batchIndex];
+				batch.object->DrawInstanced(batch.firstInstance, batch.count);
+				drawCallCount++;
+			}
+		}
+		//Clear queue
+		queue.clear();
+	}
+
+	void RenderSystem::PrepareLights(const Utilities::Matrix4& view, const Utilities::Matrix4& projection) {
+		StevEngine_PROFILE_ZONE("RenderSystem::PrepareLights");
+		frameLights.Clear();
+		for(Light* light : lights) {
+			light->UpdateShader(frameLights);
+		}
+		lightClusters.Build(view, projection, frameLights);
+		lightClusters.Upload(frameLights);
+		//Lights block
+		lightsBlock.ambientColor[0] = ambientLightColor.r / 255.0f;
+		lightsBlock.ambientColor[1] = ambientLightColor.g / 255.0f;
+		lightsBlock.ambientColor[2] = ambientLightColor.b / 255.0f;
+		lightsBlock.ambientColor[3] = ambientLightColor.a / 255.0f;
+		lightsBlock.ambientStrength = ambientLightStrength;
+		lightsBlock.directionalLightCount = frameLights.directionalLights.size();
+		lightsBlock.spotLightCount = frameLights.spotLights.size();
+		lightClusters.FillLightsBlock(lightsBlock);
+	}
+
+	static MaterialData ToMaterialData(const Visuals::Material& material) {
+		MaterialData data;
+		data.color[0] = material.color.r / 255.0f;
+		data.color[1] = material.color.g / 255.0f;
+		data.color[2] = material.color.b / 255.0f;
+		data.color[3] = material.color.a / 255.0f;
+		data.ambient = material.ambient.ToFloat();
+		data.diffuse = material.diffuse.ToFloat();
+		data.specular = material.specular.ToFloat();
+		data.shininess = material.shininess;
+		return data;
+	}
+
+	uint32_t RenderSystem::GetMaterialIndex(const Visuals::Material& material) {
+		auto known = materialIndices.find(&material);
+		if(known != materialIndices.end()) return known->second;
+		//Reuse an entry with the same values
+		MaterialData data = ToMaterialData(material);
+		size_t hash = std::hash<std::string_view>()(std::string_view((const char*)&data, sizeof(MaterialData)));
+		auto same = materialsByContent.find(hash);
+		if(same != materialsByContent.end() && std::memcmp(&materials[same->second], &data, sizeof(MaterialData)) == 0) {
+			materialIndices.insert({ &material, same->second });
+			return same->second;
+		}
+		//Add a new entry
+		uint32_t index = materials.size();
+		materials.push_back(data);
+		materialIndices.insert({ &material, index });
+		materialsByContent.insert_or_assign(hash, index);
+		//Entries added while drawing are uploaded on their own, or with the whole block if it has to grow
+		if(uniformsUploaded) {
+			if(index >= materialsCapacity) UploadMaterials();
+			else {
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, materialsBuffer);
+				glBufferSubData(GL_SHADER_STORAGE_BUFFER, index * sizeof(MaterialData), sizeof(MaterialData), &data);
+			}
+		}
+		return index;
+	}
+
+	void RenderSystem::UploadUniforms() {
+		//Copy the blocks into one upload, at their offsets in the buffer
+		uniformData.resize(uniformBufferSize);
+		std::memcpy(uniformData.data(), &cameraBlock, sizeof(CameraBlock));
+		std::memcpy(uniformData.data() + lightsOffset, &lightsBlock, sizeof(LightsBlock));
+		//Give the last frame's contents to the driver, so the upload does not wait for draws still reading them
+		glBindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+		glBufferData(GL_UNIFORM_BUFFER, uniformBufferSize, NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, uniformBufferSize, uniformData.data());
+		UploadMaterials();
+		uniformsUploaded = true;
+	}
+
+	void RenderSystem::UploadMaterials() {
+		while(materialsCapacity < materials.size()) materialsCapacity *= 2;
+		//New storage every time, so draws still reading the old contents are not waited for
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, materialsBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, materialsCapacity * sizeof(MaterialData), NULL, GL_STREAM_DRAW);
+		if(!materials.empty()) glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, materials.size() * sizeof(MaterialData), materials.data());
+	}
+
+	void RenderSystem::UseShaderPrograms(const ShaderProgram& vertexProgram, const ShaderProgram& fragmentProgram) {
+		uint32_t pipeline = shaderPipeline;
+		if(vertexProgram.GetLocation() != vertexShaderProgram.GetLocation() || fragmentProgram.GetLocation() != fragmentShaderProgram.GetLocation()) {
+			//Custom pipeline
+			auto [entry, created] = pipelines.try_emplace({ vertexProgram.GetLocation(), fragmentProgram.GetLocation() }, 0);
+			if(created) {
+				glGenProgramPipelines(1, &entry->second);
+				glUseProgramStages(entry->second, GL_VERTEX_SHADER_BIT, vertexProgram.GetLocation());
+				glUseProgramStages(entry->second, GL_FRAGMENT_SHADER_BIT, fragmentProgram.GetLocation());
+			}
+			pipeline = entry->second;
+		}
+		if(pipeline == boundPipeline) return;
+		glBindProgramPipeline(pipeline);
+		boundPipeline = pipeline;
+	}
+
+	const Visuals::Material* RenderSystem::GetCurrentMaterial(const ShaderProgram& fragmentProgram) const {
+		return materialProgram == fragmentProgram.GetLocation() ? currentMaterial : nullptr;
+	}
+
+	void RenderSystem::SetCurrentMaterial(const ShaderProgram& fragmentProgram, const Visuals::Material& material) {
+		materialProgram = fragmentProgram.GetLocation();
+		currentMaterial = &material;
+	}
+
+	void RenderSystem::ResetDrawState() {
+		glBindProgramPipeline(shaderPipeline);
+		boundPipeline = shaderPipeline;
+		currentMaterial = nullptr;
+	}
+
+	void RenderSystem::ClearPipelines() {
+		for(auto& [programs, pipeline] : pipelines) glDeleteProgramPipelines(1, &pipeline);
+		pipelines.clear();
+	}
+
 	void RenderSystem::SetEnabled(bool enabled) {
 		this->enabled = enabled;
 	}
@@ -236,22 +488,6 @@ namespace StevEngine::Renderer {
 	void RenderSystem::SetAmbientLight(float strength, const Utilities::Color& color) {
 		ambientLightColor = color;
 		ambientLightStrength = strength;
-		fragmentShaderProgram.SetShaderUniform("ambientColor", color);
-		fragmentShaderProgram.SetShaderUniform("ambientStrength", strength);
-	}
-
-	uint32_t RenderSystem::GetLightID(std::string type) {
-		uint32_t next = 0;
-		for(Visuals::Light* light : lights) {
-			if(light->GetType() == type) {
-				if(next == light->GetShaderLightID()) {
-					next++;
-				} else {
-					break;
-				}
-			}
-		}
-		return next;
 	}
 
 	void RenderSystem::AddLight(Visuals::Light* light) {
@@ -1,15 +1,21 @@
 #pragma once
 #ifdef StevEngine_RENDERER_GL
 #include "Object.hpp"
+#include "MeshBuffers.hpp"
+#include "LightClusters.hpp"
+#include "VisibilitySystem.hpp"
 #include "utilities/Color.hpp"
 #include "visuals/shaders/Shader.hpp"
 #include "visuals/shaders/ShaderProgram.hpp"
+#include "visuals/shaders/UniformBlocks.hpp"
 
 #include <SDL.h>
 
 #include <vector>
 #include <array>
 #include <cstdint>
+#include <unordered_map>
+#include <map>
 
 #define OPENGL_MAJOR 4
 #define OPENGL_MINOR 4
@@ -28,18 +34,18 @@ namespace StevEngine {
 		//Object
 		/**
 		 * @brief Container for renderable object and transform
-		 * Groups an object with its world transform for rendering
+		 * Groups an object with its camera relative transform for rendering
 		 */
 		struct RenderObject {
-			const CustomObject& object;		  ///< Object to render
-			const Utilities::Matrix4 transform;  ///< World transform matrix
+			const CustomObject& object;		   ///< Object to render
+			const Utilities::Matrix4f transform;  ///< Transform relative to the camera
 
 			/**
 			 * @brief Create render object
 			 * @param object Object to render
-			 * @param transform World transform matrix
+			 * @param transform Transform relative to the camera
 			 */
-			RenderObject(const CustomObject& object, const Utilities::Matrix4& transform) : object(object), transform(transform) {}
+			RenderObject(const CustomObject& object, const Utilities::Matrix4f& transform) : object(object), transform(transform) {}
 
 			/**
 			 * @brief Draw the object
@@ -49,13 +55,43 @@ namespace StevEngine {
 			}
 		};
 
+		/**
+		 * @brief Position of an object in the sorted draw order of a render queue
+		 */
+		struct DrawItem {
+			uint64_t key;		  ///< Sort key, state and depth
+			uint32_t index;		///< Index of the object in the queue
+			const Object* object;  ///< Object as a standard object, or nullptr for other custom objects
+		};
+
+		/**
+		 * @brief Objects in a render queue drawn together in one instanced draw
+		 */
+		struct InstanceBatch {
+			const Object* object;	///< Object drawn for every instance
+			uint32_t firstObject;	///< Position in the draw order of the first object, where the batch is drawn
+			uint32_t firstInstance;  ///< First instance in the instance buffer
+			uint32_t count;		  ///< Number of objects in the batch
+			uint32_t added;		  ///< Number of objects whose instance data has been added
+			uint32_t next;		   ///< Next batch with the same geometry
+		};
+
+		/**
+		 * @brief Sorted draw order and instance batches of a render queue, rebuilt every frame
+		 */
+		struct QueueDrawList {
+			std::vector<DrawItem> order;		   ///< Objects in draw order
+			std::vector<InstanceBatch> batches;	///< Instance batches
+			std::vector<uint32_t> objectBatches;   ///< Batch of each object in draw order
+		};
+
 		/**
 		 * @brief Render queue types for sorting objects
 		 */
 		enum RenderQueue {
-			STANDARD,	 ///< Default opaque objects
-			TRANSPARENT,  ///< Transparent objects
-			OVERLAY,	  ///< UI and overlay objects
+			STANDARD,	 ///< Default opaque objects, sorted by state then front to back
+			TRANSPARENT,  ///< Transparent objects, sorted back to front then by state
+			OVERLAY,	  ///< UI and overlay objects, drawn in the order they were added
 			MUST_BE_LAST  ///< Queue count marker
 		};
 
@@ -75,11 +111,23 @@ namespace StevEngine {
 
 				/**
 				 * @brief Queue object for rendering
+				 *
+				 * The transform is converted to floats relative to the camera right away,
+				 * so world positions far from the origin keep their precision.
 				 * @param object Object to render
 				 * @param transform World transform matrix
 				 * @param queue Queue to add to
 				 */
-				void DrawObject(const CustomObject& object, Utilities::Matrix4 transform, RenderQueue queue = STANDARD);
+				void DrawObject(const CustomObject& object, const Utilities::Matrix4& transform, RenderQueue queue = STANDARD);
+
+				/**
+				 * @brief Get world position everything is rendered relative to this frame
+				 *
+				 * Read from the active camera on first use each frame.
+				 * Positions sent to shaders should have this subtracted, as the camera is at the shaders origin.
+				 * @return Camera world position
+				 */
+				const Utilities::Vector3& GetRenderOrigin();
 
 				/**
 				 * @brief Set background clear color
@@ -127,13 +175,6 @@ namespace StevEngine {
 				float GetAmbientLightStrength() const { return ambientLightStrength; }
 
 				// Light management
-				/**
-				 * @brief Get next available light ID for type
-				 * @param type Light type string
-				 * @return Available light index
-				 */
-				uint32_t GetLightID(std::string type);
-
 				/**
 				 * @brief Get all active lights
 				 * @return Vector of light pointers
@@ -153,11 +194,108 @@ namespace StevEngine {
 				void RemoveLight(Visuals::Light* light);
 
 				/**
-			 	 * @brief Rebinds the GPU buffers (VBO, EBO, VAO) to the renderers
+			 	 * @brief Rebinds the shared mesh buffers (VBO, EBO, VAO) to the renderers
 				*/
 				void ResetGPUBuffers();
 
+				/**
+				 * @brief Get buffers every object's geometry is uploaded to
+				 * @return Shared mesh buffers
+				 */
+				MeshBuffers& GetMeshBuffers() { return *meshBuffers; }
+
+				/**
+				 * @brief Get number of draw calls in the last frame
+				 * @return Draw call count
+				 */
+				uint32_t GetDrawCallCount() const { return drawCallCount; }
+
+				/**
+				 * @brief Get system deciding which render components are in view
+				 * @return Visibility system
+				 */
+				VisibilitySystem& GetVisibility() { return visibility; }
+
+				/**
+				 * @brief Bind the pipeline of a vertex and fragment shader program, if not already bound
+				 *
+				 * Pipelines are created on first use and kept.
+				 * @param vertexProgram Vertex shader program
+				 * @param fragmentProgram Fragment shader program
+				 */
+				void UseShaderPrograms(const ShaderProgram& vertexProgram, const ShaderProgram& fragmentProgram);
+
+				/**
+				 * @brief Get material last set in a fragment shader program this frame
+				 * @param fragmentProgram Fragment shader program
+				 * @return Material last set, or nullptr if unknown
+				 */
+				const Visuals::Material* GetCurrentMaterial(const ShaderProgram& fragmentProgram) const;
+
+				/**
+				 * @brief Remember the material set in a fragment shader program, so setting it again can be skipped
+				 * @param fragmentProgram Fragment shader program
+				 * @param material Material set, must stay alive until the end of the frame
+				 */
+				void SetCurrentMaterial(const ShaderProgram& fragmentProgram, const Visuals::Material& material);
+
+				/**
+				 * @brief Get index of a material in the materials storage block
+				 *
+				 * Materials of queued objects are added before the frame is drawn.
+				 * Materials added while drawing are uploaded on their own, growing the block if it is full.
+				 * @param material Material to find or add, must stay alive until the end of the frame
+				 * @return Index in the materials block
+				 */
+				uint32_t GetMaterialIndex(const Visuals::Material& material);
+
 			private:
+				/**
+				 * @brief Sort a render queue, group it into instance batches, and collect its instances and materials
+				 *
+				 * Objects are sorted by state key and depth, except in the overlay queue.
+				 * Objects using the same geometry, with materials that only differ in color, are drawn in one instanced draw call,
+				 * except in the transparent queue where that would break the back to front order.
+				 * @param queue Queue to prepare
+				 * @param list Draw list to fill
+				 * @param type Type of the queue
+				 */
+				void PrepareQueue(const std::vector<RenderObject>& queue, QueueDrawList& list, RenderQueue type);
+
+				/**
+				 * @brief Draw and clear a render queue
+				 *
+				 * Batches are drawn where their first object is in the draw order.
+				 * @param queue Queue to draw
+				 * @param list Draw list of the queue
+				 */
+				void DrawQueue(std::vector<RenderObject>& queue, const QueueDrawList& list);
+
+				/**
+				 * @brief Collect the lights of the frame, bin them into clusters, and upload them
+				 * @param view View matrix for positions relative to the camera
+				 * @param projection Projection matrix
+				 */
+				void PrepareLights(const Utilities::Matrix4& view, const Utilities::Matrix4& projection);
+
+				/** @brief Upload the camera and lights uniform blocks and the materials storage block of the frame */
+				void UploadUniforms();
+
+				/**
+				 * @brief Replace the contents of the materials storage block, growing it if needed
+				 */
+				void UploadMaterials();
+
+				/**
+				 * @brief Bind the default pipeline and forget the current material
+				 *
+				 * Used where state may have been changed outside of the tracking, like by custom objects.
+				 */
+				void ResetDrawState();
+
+				/** @brief Delete the pipelines of custom shader programs */
+				void ClearPipelines();
+
 				SDL_GLContext context;  ///< OpenGL context
 
 				/** @brief Render queues for different types of objects */
@@ -168,14 +306,46 @@ namespace StevEngine {
 				ShaderProgram fragmentShaderProgram;  ///< Default fragment shader
 				uint32_t shaderPipeline;			 ///< Current shader pipeline
 
+				// Draw state
+				std::map<std::pair<uint32_t, uint32_t>, uint32_t> pipelines;  ///< Pipelines of custom shader programs, by vertex and fragment program
+				uint32_t boundPipeline = 0;  ///< Pipeline currently bound
+				uint32_t materialProgram = 0;  ///< Fragment program currentMaterial was set in
+				const Visuals::Material* currentMaterial = nullptr;  ///< Material last set, or nullptr if unknown
+
+				// Uniform blocks
+				uint32_t uniformBuffer = 0;	   ///< Buffer holding every uniform block
+				uint32_t uniformBufferSize = 0;   ///< Size of the uniform buffer
+				uint32_t lightsOffset = 0;		///< Offset of the lights block in the uniform buffer
+				CameraBlock cameraBlock;		  ///< Camera block of the frame
+				LightsBlock lightsBlock;		  ///< Lights block of the frame
+				uint32_t materialsBuffer = 0;	 ///< Storage buffer of the materials block
+				size_t materialsCapacity = 0;	 ///< Number of materials the storage buffer holds
+				std::vector<MaterialData> materials;  ///< Materials block entries of the frame
+				std::unordered_map<const Visuals::Material*, uint32_t> materialIndices;  ///< Index of each material used this frame
+				std::unordered_map<size_t, uint32_t> materialsByContent;  ///< Index of materials by a hash of their values
+				std::vector<uint8_t> uniformData;  ///< Uniform buffer contents staged for upload
+				bool uniformsUploaded = false;	 ///< Whether the uniform buffer was uploaded this frame
+
 				// GPU Buffers
-				uint32_t VBO;  ///< Vertex Buffer Object
-				uint32_t EBO;  ///< Element Buffer Object
-				uint32_t VAO;  ///< Vertex Array Object
+				std::shared_ptr<MeshBuffers> meshBuffers;  ///< Shared vertex and index buffers, kept alive by meshes using them
+
+				// Camera relative rendering
+				Utilities::Vector3 renderOrigin;  ///< Camera world position of the current frame
+				bool hasRenderOrigin = false;	 ///< Whether renderOrigin has been read this frame
+
+				// Instancing, kept between frames to reuse their memory
+				static constexpr uint32_t noBatch = UINT32_MAX;  ///< Batch index of objects not drawn instanced
+				std::array<QueueDrawList, RenderQueue::MUST_BE_LAST> drawLists;  ///< Draw list of each render queue
+				std::unordered_map<const GPUMesh*, uint32_t> meshBatches;  ///< Last batch created for each geometry, in the queue being prepared
+				std::vector<InstanceData> instances;  ///< Instance data of every queue
+				uint32_t drawCallCount = 0;  ///< Draw calls in the last frame
 
 				// Scene properties
 				Utilities::Color backgroundColor = {0, 0, 0, 255};  ///< Background clear color
 				std::vector<Visuals::Light*> lights;  ///< Active lights
+				FrameLights frameLights;			  ///< Lights of the current frame, kept between frames to reuse their memory
+				LightClusters lightClusters;		  ///< Point lights reaching each part of the view
+				VisibilitySystem visibility;		  ///< Render components in view
 				Utilities::Color ambientLightColor;   ///< Ambient light color
 				float ambientLightStrength;		  ///< Ambient light intensity
 		};
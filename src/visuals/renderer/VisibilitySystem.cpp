@@ -0,0 +1,60 @@
+#ifdef StevEngine_RENDERER_GL
+#include "VisibilitySystem.hpp"
+#include "RenderComponent.hpp"
+#include "main/GameObject.hpp"
+#include "main/Scene.hpp"
+#include "main/Profiler.hpp"
+#include "utilities/Frustum.hpp"
+#include "visuals/Camera.hpp"
+
+using namespace StevEngine::Utilities;
+
+namespace StevEngine::Renderer {
+	void VisibilitySystem::Add(RenderComponent& component) {
+		if(component.visibilityProxy != BoundingVolumeTree::none) return;
+		component.visibilityProxy = tree.Insert(component.GetWorldBounds(), &component);
+		byTransform.emplace(component.GetParent().GetTransformHandle(), &component);
+		//Follow the component when its object moves
+		component.GetParent().GetScene().transforms.SetTrackChanges(true);
+	}
+
+	void VisibilitySystem::Remove(RenderComponent& component) {
+		if(component.visibilityProxy == BoundingVolumeTree::none) return;
+		tree.Remove(component.visibilityProxy);
+		component.visibilityProxy = BoundingVolumeTree::none;
+		auto [begin, end] = byTransform.equal_range(component.GetParent().GetTransformHandle());
+		for(auto i = begin; i != end; i++) {
+			if(i->second == &component) {
+				byTransform.erase(i);
+				break;
+			}
+		}
+	}
+
+	void VisibilitySystem::Move(RenderComponent& component) {
+		if(component.visibilityProxy == BoundingVolumeTree::none) return;
+		tree.Move(component.visibilityProxy, component.GetWorldBounds());
+	}
+
+	void VisibilitySystem::Update(TransformHierarchy& transforms) {
+		StevEngine_PROFILE_ZONE("VisibilitySystem::Update");
+		for(uint32_t handle : transforms.GetChanged()) {
+			auto [begin, end] = byTransform.equal_range(handle);
+			for(auto i = begin; i != end; i++) Move(*i->second);
+		}
+		transforms.ClearChanged();
+	}
+
+	void VisibilitySystem::Draw(const Visuals::Camera& camera) {
+		StevEngine_PROFILE_ZONE("VisibilitySystem::Draw");
+		Frustum frustum(camera.GetProjection() * camera.GetView());
+		//Collect first, since submitting can move components in the tree
+		visible.clear();
+		tree.Query(
+			[&frustum] (const Range3& bounds) { return frustum.Test(bounds); },
+			[this] (void* data) { visible.push_back((RenderComponent*)data); }
+		);
+		for(RenderComponent* component : visible) component->Submit();
+	}
+}
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+#ifdef StevEngine_RENDERER_GL
+#include "main/TransformHierarchy.hpp"
+#include "utilities/BoundingVolumeTree.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace StevEngine::Visuals {
+	class Camera;
+}
+
+namespace StevEngine::Renderer {
+	class RenderComponent;
+
+	/**
+	 * @brief Finds the render components seen by the camera
+	 *
+	 * Keeps the world space bounding box of every active render component in a bounding volume tree.
+	 * Boxes are only updated for objects whose transform changed, and each frame the tree is tested against the camera frustum,
+	 * so only components in view are submitted to the renderer.
+	 */
+	class VisibilitySystem {
+		public:
+			/**
+			 * @brief Start tracking a render component
+			 * @param component Component to add
+			 */
+			void Add(RenderComponent& component);
+
+			/**
+			 * @brief Stop tracking a render component
+			 * @param component Component to remove
+			 */
+			void Remove(RenderComponent& component);
+
+			/**
+			 * @brief Update the bounding box of a render component
+			 * @param component Component to update
+			 */
+			void Move(RenderComponent& component);
+
+			/**
+			 * @brief Update the bounding boxes of components whose transforms changed
+			 *
+			 * Adding a component makes its scene track changed transforms, which have to be cleared here every frame.
+			 * @param transforms Transforms of the active scene
+			 */
+			void Update(TransformHierarchy& transforms);
+
+			/**
+			 * @brief Submit the components seen by a camera to the renderer
+			 * @param camera Camera to test against
+			 */
+			void Draw(const Visuals::Camera& camera);
+
+			/**
+			 * @brief Get number of components submitted by the last draw
+			 * @return Visible component count
+			 */
+			uint32_t GetVisibleCount() const { return visible.size(); }
+
+			/**
+			 * @brief Get number of tracked components
+			 * @return Component count
+			 */
+			uint32_t GetCount() const { return tree.GetCount(); }
+
+		private:
+			Utilities::BoundingVolumeTree tree;  ///< World space bounding boxes of the components
+			std::unordered_multimap<uint32_t, RenderComponent*> byTransform;  ///< Components by the transform handle of their object
+			std::vector<RenderComponent*> visible;  ///< Components found by the last draw
+	};
+}
+#endif
@@ -67,6 +67,33 @@ namespace StevEngine::Renderer {
 			Log::Error("Shader program failed to compile!\n" + std::string(infoLog));
 		}
 		modified = false;
+		//Cache locations of the active uniforms
+		uniformLocations->clear();
+		if(!success) return;
+		GLint uniformCount = 0, maxNameLength = 0;
+		glGetProgramiv(location, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(location, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		std::string name(maxNameLength, '\0');
+		for(GLint i = 0; i < uniformCount; i++) {
+			GLsizei length = 0;
+			glGetActiveUniformName(location, i, maxNameLength, &length, name.data());
+			std::string uniform = name.substr(0, length);
+			//Uniform block members have no location
+			GLint uniformLocation = glGetUniformLocation(location, uniform.c_str());
+			if(uniformLocation < 0) continue;
+			uniformLocations->insert({ uniform, uniformLocation });
+			//Arrays can be named without their first index
+			if(uniform.ends_with("[0]")) uniformLocations->insert({ uniform.substr(0, uniform.size() - 3), uniformLocation });
+		}
+	}
+
+	int32_t ShaderProgram::GetUniformLocation(const char* name) const {
+		auto cached = uniformLocations->find(std::string_view(name));
+		if(cached != uniformLocations->end()) return cached->second;
+		//Not an active uniform, or an array element after the first
+		int32_t uniformLocation = glGetUniformLocation(location, name);
+		uniformLocations->insert({ name, uniformLocation });
+		return uniformLocation;
 	}
 
 	void ShaderProgram::DeleteProgram() {
@@ -93,31 +120,37 @@ namespace StevEngine::Renderer {
 
 	//Set uniforms
 	void ShaderProgram::SetShaderUniform(const char* name, Utilities::Matrix4 value) const {
-		glProgramUniformMatrix4fv(location, glGetUniformLocation(location, name), 1, GL_FALSE, value.data());
+		SetShaderUniform(name, value.ToFloat());
+	}
+	void ShaderProgram::SetShaderUniform(const char* name, const Utilities::Matrix4f& value) const {
+		glProgramUniformMatrix4fv(location, GetUniformLocation(name), 1, GL_FALSE, value.data());
 	}
 	void ShaderProgram::SetShaderUniform(const char* name, Utilities::Color value) const {
-		glProgramUniform4fv(location, glGetUniformLocation(location, name), 1, value.data());
+		glProgramUniform4f(location, GetUniformLocation(name), value.r / 255.0f, value.g / 255.0f, value.b / 255.0f, value.a / 255.0f);
 	}
 	void ShaderProgram::SetShaderUniform(const char* name, Utilities::Vector3 value) const {
-		glProgramUniform3fv(location, glGetUniformLocation(location, name), 1, value.data());
+		SetShaderUniform(name, value.ToFloat());
+	}
+	void ShaderProgram::SetShaderUniform(const char* name, const Utilities::Vector3f& value) const {
+		glProgramUniform3fv(location, GetUniformLocation(name), 1, value.data());
 	}
 	void ShaderProgram::SetShaderUniform(const char* name, Utilities::Vector2 value) const {
-		glProgramUniform2fv(location, glGetUniformLocation(location, name), 1, value.data());
+		glProgramUniform2f(location, GetUniformLocation(name), (float)value.X, (float)value.Y);
 	}
 	void ShaderProgram::SetShaderUniform(const char* name, bool value) const {
-		glProgramUniform1i(location, glGetUniformLocation(location, name), value);
+		glProgramUniform1i(location, GetUniformLocation(name), value);
 	}
 	void ShaderProgram::SetShaderUniform(const char* name, int32_t value) const {
-		glProgramUniform1i(location, glGetUniformLocation(location, name), value);
+		glProgramUniform1i(location, GetUniformLocation(name), value);
 	}
 	void ShaderProgram::SetShaderUniform(const char* name, uint32_t value) const {
-		glProgramUniform1ui(location, glGetUniformLocation(location, name), value);
+		glProgramUniform1ui(location, GetUniformLocation(name), value);
 	}
 	void ShaderProgram::SetShaderUniform(const char* name, float value) const {
-		glProgramUniform1f(location, glGetUniformLocation(location, name), value);
+		glProgramUniform1f(location, GetUniformLocation(name), value);
 	}
 	void ShaderProgram::SetShaderUniform(const char* name, double value) const {
-		glProgramUniform1d(location, glGetUniformLocation(location, name), value);
+		glProgramUniform1d(location, GetUniformLocation(name), value);
 	}
 
 
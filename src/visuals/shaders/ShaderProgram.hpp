@@ -9,6 +9,10 @@
 #include "visuals/Texture.hpp"
 
 #include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <cstdint>
 #include <glad/gl.h>
 
@@ -74,6 +78,13 @@ namespace StevEngine::Renderer {
 			 */
 			void SetShaderUniform(const char* name, Utilities::Matrix4 value) const;
 
+			/**
+			 * @brief Set matrix uniform from float matrix
+			 * @param name Uniform name in shader
+			 * @param value Matrix value
+			 */
+			void SetShaderUniform(const char* name, const Utilities::Matrix4f& value) const;
+
 			/**
 			 * @brief Set color uniform
 			 * @param name Uniform name in shader
@@ -88,6 +99,13 @@ namespace StevEngine::Renderer {
 			 */
 			void SetShaderUniform(const char* name, Utilities::Vector3 value) const;
 
+			/**
+			 * @brief Set vector3 uniform from float vector
+			 * @param name Uniform name in shader
+			 * @param value Vector value
+			 */
+			void SetShaderUniform(const char* name, const Utilities::Vector3f& value) const;
+
 			/**
 			 * @brief Set vector2 uniform
 			 * @param name Uniform name in shader
@@ -130,6 +148,17 @@ namespace StevEngine::Renderer {
 			 */
 			void SetShaderUniform(const char* name, double value) const;
 
+			/**
+			 * @brief Get location of a uniform
+			 *
+			 * Locations of the active uniforms are cached when the program is linked,
+			 * other names are looked up on first use and cached too.
+			 * The cache is shared with copies of the program.
+			 * @param name Uniform name in shader
+			 * @return Uniform location, or -1 if the program has no such uniform
+			 */
+			int32_t GetUniformLocation(const char* name) const;
+
 			/**
 			 * @brief Get OpenGL program ID
 			 * @return Program location in OpenGL
@@ -160,6 +189,14 @@ namespace StevEngine::Renderer {
 			ShaderType shaderType = ShaderType::VERTEX;		///< Type of shaders in program
 			bool modified = false;							///< Whether program needs relinking
 			std::map<uint32_t, Shader> shaders;				///< Shaders by OpenGL ID
+
+			/** @brief Hash of uniform names, which can look up names without creating a string */
+			struct UniformNameHash {
+				using is_transparent = void;
+				size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+			};
+			using UniformLocations = std::unordered_map<std::string, int32_t, UniformNameHash, std::equal_to<>>;
+			std::shared_ptr<UniformLocations> uniformLocations = std::make_shared<UniformLocations>();  ///< Cached uniform locations by name
 	};
 
 	class ComputeShader : public ShaderProgram {
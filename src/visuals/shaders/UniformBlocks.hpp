@@ -0,0 +1,112 @@
+#pragma once
+#ifdef StevEngine_RENDERER_GL
+#include "utilities/Matrix4.hpp"
+#include "utilities/Vector3.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+//Number of materials the materials storage block starts with, it grows when more are used
+#define INITIAL_MATERIALS 256
+
+namespace StevEngine::Renderer {
+	/**
+	 * @brief Binding points of the uniform blocks
+	 *
+	 * The same for every shader program, so custom programs read the same blocks as the default ones.
+	 */
+	enum UniformBlockBinding : uint32_t {
+		CAMERA_BLOCK = 0,	///< CameraData block
+		LIGHTS_BLOCK = 1	///< LightData block
+	};
+
+	/** @brief Binding points of the shader storage blocks */
+	enum StorageBlockBinding : uint32_t {
+		DIRECTIONAL_LIGHTS_BLOCK = 0,  ///< DirectionalLights block
+		POINT_LIGHTS_BLOCK = 1,		///< PointLights block
+		SPOT_LIGHTS_BLOCK = 2,		 ///< SpotLights block
+		LIGHT_CLUSTERS_BLOCK = 3,	  ///< LightClusters block
+		LIGHT_INDICES_BLOCK = 4,	   ///< LightIndices block
+		MATERIALS_BLOCK = 5			///< Materials block
+	};
+
+	//Memory layouts of the std140 uniform blocks and std430 storage blocks, where vec3 members take up 16 bytes unless followed by a float
+
+	/** @brief Camera data, updated once per frame */
+	struct CameraBlock {
+		Utilities::Matrix4f viewTransform;		///< View rotation, positions are relative to the camera
+		Utilities::Matrix4f projectionTransform;  ///< Projection matrix
+		Utilities::Vector3f viewPosition;		 ///< Camera position relative to itself, always zero
+		float padding0 = 0;
+		Utilities::Vector3f viewDirection;		///< Camera forward direction
+		float padding1 = 0;
+	};
+
+	/** @brief Directional light in the directional lights block */
+	struct DirectionalLightData {
+		Utilities::Vector3f direction;  ///< Light direction
+		float padding0 = 0;
+		Utilities::Vector3f diffuse;	///< Diffuse light color
+		float padding1 = 0;
+		Utilities::Vector3f specular;   ///< Specular light color
+		float padding2 = 0;
+	};
+
+	/** @brief Point light in the point lights block */
+	struct PointLightData {
+		Utilities::Vector3f position;  ///< Position relative to the camera
+		float constant;				///< Constant attenuation factor
+		Utilities::Vector3f diffuse;   ///< Diffuse light color
+		float linear;				  ///< Linear attenuation factor
+		Utilities::Vector3f specular;  ///< Specular light color
+		float quadratic;			   ///< Quadratic attenuation factor
+	};
+
+	/** @brief Spot light in the spot lights block */
+	struct SpotLightData {
+		Utilities::Vector3f position;   ///< Position relative to the camera
+		float cutOff;				   ///< Inner cone angle
+		Utilities::Vector3f direction;  ///< Light direction
+		float outerCutOff;			  ///< Outer cone angle
+		Utilities::Vector3f diffuse;	///< Diffuse light color
+		float padding0 = 0;
+		Utilities::Vector3f specular;   ///< Specular light color
+		float padding1 = 0;
+	};
+
+	/** @brief Light cluster in the light clusters block, a range of the light indices block */
+	struct LightClusterData {
+		uint32_t offset;  ///< First point light index of the cluster
+		uint32_t count;   ///< Number of point lights in the cluster
+	};
+
+	/** @brief Ambient light, light counts and cluster grid, updated once per frame */
+	struct LightsBlock {
+		float ambientColor[4];			 ///< Ambient light color, normalized RGBA
+		float ambientStrength;			 ///< Ambient light intensity
+		uint32_t directionalLightCount;	///< Directional lights in the directional lights block
+		uint32_t spotLightCount;		   ///< Spot lights in the spot lights block
+		float clusterNear;				 ///< View depth where the first depth slice starts
+		uint32_t clusterSize[3];		   ///< Number of clusters along screen width, screen height and depth
+		float clusterDepthScale;		   ///< Depth slices per logarithmic unit of view depth
+	};
+
+	/** @brief Material in the materials block */
+	struct MaterialData {
+		float color[4];				///< Base color, normalized RGBA
+		Utilities::Vector3f ambient;   ///< Ambient light reflection
+		float padding0 = 0;
+		Utilities::Vector3f diffuse;   ///< Diffuse light reflection
+		float padding1 = 0;
+		Utilities::Vector3f specular;  ///< Specular light reflection
+		float shininess;			   ///< Specular highlight size
+	};
+
+	static_assert(sizeof(Utilities::Vector3f) == 12, "Vector3f must be three packed floats");
+	static_assert(sizeof(CameraBlock) == 160);
+	static_assert(sizeof(DirectionalLightData) == 48 && sizeof(PointLightData) == 48 && sizeof(SpotLightData) == 64);
+	static_assert(sizeof(LightClusterData) == 8);
+	static_assert(offsetof(LightsBlock, clusterSize) == 32 && sizeof(LightsBlock) == 48);
+	static_assert(sizeof(MaterialData) == 64);
+}
+#endif
@@ -8,4 +8,15 @@ struct Material {
 	vec3 specular;
 	float shininess;
 };
+
+layout(std140, binding = 0) uniform CameraData {
+	mat4 viewTransform;
+	mat4 projectionTransform;
+	vec3 viewPosition;
+	vec3 viewDirection;
+};
+
+layout(std430, binding = 5) readonly buffer Materials {
+	Material materials[];
+};
 )"
\ No newline at end of file
@@ -5,4 +5,11 @@ struct Vertex {
 	vec3 normal;
 	vec3 tangent;
 };
+
+layout(std140, binding = 0) uniform CameraData {
+	mat4 viewTransform;
+	mat4 projectionTransform;
+	vec3 viewPosition;
+	vec3 viewDirection;
+};
 )"
\ No newline at end of file
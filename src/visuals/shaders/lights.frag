@@ -8,27 +8,70 @@ Material GetObjectMaterial();
 vec3 GetViewDirection();
 vec3 GetViewPosition();
 
-//Global ambient lighting
-uniform float ambientStrength;
-uniform vec4 ambientColor;
-
 //Lights
-struct Light {
+struct DirectionalLight {
+	vec3 direction;
+	vec3 diffuse;
+	vec3 specular;
+};
+struct PointLight {
+	vec3 position;
+	float constant;
+	vec3 diffuse;
+	float linear;
+	vec3 specular;
+	float quadratic;
+};
+struct SpotLight {
+	vec3 position;
+	float cutOff;
+	vec3 direction;
+	float outerCutOff;
 	vec3 diffuse;
 	vec3 specular;
 };
+layout(std140, binding = 1) uniform LightData {
+	//Global ambient lighting
+	vec4 ambientColor;
+	float ambientStrength;
+	//Lights used by every fragment
+	uint directionalLightCount;
+	uint spotLightCount;
+	//Cluster grid
+	float clusterNear;
+	uvec3 clusterSize;
+	float clusterDepthScale;
+};
+layout(std430, binding = 0) readonly buffer DirectionalLights {
+	DirectionalLight directionalLights[];
+};
+layout(std430, binding = 1) readonly buffer PointLights {
+	PointLight pointLights[];
+};
+layout(std430, binding = 2) readonly buffer SpotLights {
+	SpotLight spotLights[];
+};
+//Range of lightIndices with the point lights reaching each cluster
+layout(std430, binding = 3) readonly buffer LightClusters {
+	uvec2 lightClusters[];
+};
+layout(std430, binding = 4) readonly buffer LightIndices {
+	uint lightIndices[];
+};
 
-#define MAX_DIRECTIONAL_LIGHTS 10
-#define MAX_POINT_LIGHTS 50
-#define MAX_SPOT_LIGHTS 50
+//Cluster of a position relative to the camera, from its screen tile and depth slice
+uint GetLightCluster(vec3 position)
+{
+	vec4 viewPos = viewTransform * vec4(position, 1.0);
+	vec4 clipPos = projectionTransform * viewPos;
+	vec2 screen = clamp(clipPos.xy / clipPos.w * 0.5 + 0.5, 0.0, 1.0);
+	uvec2 tile = min(uvec2(screen * vec2(clusterSize.xy)), clusterSize.xy - 1u);
+	float depth = max(-viewPos.z, clusterNear);
+	uint slice = min(uint(log(depth / clusterNear) * clusterDepthScale), clusterSize.z - 1u);
+	return tile.x + clusterSize.x * (tile.y + clusterSize.y * slice);
+}
 
 //Directional lights
-struct DirectionalLight {
-	vec3 direction;
-
-	Light basic;
-};
-uniform DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
 vec3 CalculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec4 objectColor)
 {
 	Material objectMaterial = GetObjectMaterial();
@@ -39,21 +82,11 @@ vec3 CalculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir
 	vec3 reflectDir = reflect(-lightDir, normal);
 	float spec = pow(max(dot(viewDir, reflectDir), 0.0), objectMaterial.shininess);
 	// combine results
-	vec3 diffuse  = light.basic.diffuse  * diff * objectMaterial.diffuse * vec3(objectColor);
-	vec3 specular = light.basic.specular * spec * objectMaterial.specular;
+	vec3 diffuse  = light.diffuse  * diff * objectMaterial.diffuse * vec3(objectColor);
+	vec3 specular = light.specular * spec * objectMaterial.specular;
 	return (diffuse + specular);
 }
 //Point lights
-struct PointLight {
-	vec3 position;
-
-	float constant;
-	float linear;
-	float quadratic;
-
-	Light basic;
-};
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
 vec3 CalculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec4 objectColor)
 {
 	Material objectMaterial = GetObjectMaterial();
@@ -68,21 +101,11 @@ vec3 CalculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewD
 	float a = (light.constant + light.linear * distance + light.quadratic * (distance * distance));
 	float attenuation = (a == 0 ? 0 : (1.0 / a));
 	// combine results
-	vec3 diffuse  = light.basic.diffuse  * diff * objectMaterial.diffuse * attenuation * vec3(objectColor);
-	vec3 specular = light.basic.specular * spec * objectMaterial.specular * attenuation;
+	vec3 diffuse  = light.diffuse  * diff * objectMaterial.diffuse * attenuation * vec3(objectColor);
+	vec3 specular = light.specular * spec * objectMaterial.specular * attenuation;
 	return (diffuse + specular);
 }
 //Spot lights
-struct SpotLight {
-	vec3 position;
-	vec3 direction;
-
-	float cutOff;
-	float outerCutOff;
-
-	Light basic;
-};
-uniform SpotLight spotLights[MAX_SPOT_LIGHTS];
 vec3 CalculateSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec4 objectColor)
 {
 	Material objectMaterial = GetObjectMaterial();
@@ -90,8 +113,8 @@ vec3 CalculateSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir
 	float epsilon   = light.cutOff - light.outerCutOff;
 	float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
 	// combine results
-	vec3 diffuse  = light.basic.diffuse  * intensity * objectMaterial.diffuse * vec3(objectColor);
-	vec3 specular = light.basic.specular * intensity * objectMaterial.specular;
+	vec3 diffuse  = light.diffuse  * intensity * objectMaterial.diffuse * vec3(objectColor);
+	vec3 specular = light.specular * intensity * objectMaterial.specular;
 	return (diffuse + specular);
 }
 
@@ -104,13 +127,14 @@ vec4 GetLights(vec4 objectColor)
 	vec3 viewDir = normalize(GetViewPosition() - FragPos);
 	vec4 lights = vec4(objectMaterial.ambient * ambientStrength, 1.0) * ambientColor * objectColor;
 	// Directional lights
-	for(int i = 0; i < MAX_DIRECTIONAL_LIGHTS; i++)
+	for(uint i = 0; i < directionalLightCount; i++)
 	lights += vec4(CalculateDirectionalLight(directionalLights[i], normal, viewDir, objectColor), 1.0);
-	// Point lights
-	for(int i = 0; i < MAX_POINT_LIGHTS; i++)
-	lights += vec4(CalculatePointLight(pointLights[i], normal, FragPos, viewDir, objectColor), 1.0);
+	// Point lights reaching the cluster
+	uvec2 cluster = lightClusters[GetLightCluster(FragPos)];
+	for(uint i = cluster.x; i < cluster.x + cluster.y; i++)
+	lights += vec4(CalculatePointLight(pointLights[lightIndices[i]], normal, FragPos, viewDir, objectColor), 1.0);
 	// Spot lights
-	for(int i = 0; i < MAX_SPOT_LIGHTS; i++)
+	for(uint i = 0; i < spotLightCount; i++)
 	lights += vec4(CalculateSpotLight(spotLights[i], normal, FragPos, viewDir, objectColor), 1.0);
 	// Return combined lights
 	return lights;
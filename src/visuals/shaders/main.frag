@@ -6,19 +6,19 @@ in VS_OUT {
 	vec3 Position;
 	vec2 UV;
 	mat3 TBN;
+	vec4 Color;
 } fs_in;
 vec3 GetFragPosition() { return fs_in.Position; }
 vec2 GetFragUV() { return fs_in.UV; }
 mat3 GetFragTBN() { return fs_in.TBN; }
-uniform vec3 viewPosition;
-uniform vec3 viewDirection;
 vec3 GetViewPosition() { return viewPosition; }
 vec3 GetViewDirection() { return viewDirection; }
 
 //Material
-uniform Material objectMaterial;
-Material GetObjectMaterial() { return objectMaterial; }
-vec4 GetObjectColor() { return objectMaterial.color; }
+uniform uint materialIndex;
+uniform bool instanced;
+Material GetObjectMaterial() { return materials[materialIndex]; }
+vec4 GetObjectColor() { return instanced ? fs_in.Color : materials[materialIndex].color; }
 //Textures
 uniform sampler2D albedoTexture;
 uniform bool usingAlbedoTexture;
@@ -5,28 +5,31 @@ layout(location = 0) in vec3 vertexPosition;
 layout(location = 1) in vec2 vertexUV;
 layout(location = 2) in vec3 vertexNormal;
 layout(location = 3) in vec3 vertexTangent;
+layout(location = 4) in mat4 instanceTransform;
+layout(location = 8) in vec4 instanceColor;
 
 Vertex getVertex() {
 	return Vertex(vertexPosition, vertexUV, vertexNormal, vertexTangent);
 }
 
+uniform bool instanced;
 uniform mat4 objectTransform;
-mat4 getObjectTransform() { return objectTransform; }
-uniform mat4 viewTransform;
+mat4 getObjectTransform() { return instanced ? instanceTransform : objectTransform; }
 mat4 getViewTransform() { return viewTransform; }
-uniform mat4 projectionTransform;
 mat4 getProjectionTransform() { return projectionTransform; }
 
 out VS_OUT {
 	out vec3 Position;
 	out vec2 UV;
 	out mat3 TBN;
+	out vec4 Color;
 } vs_out;
 
 
 void setFragInfo(Vertex info) {
 	vs_out.Position = info.position;
 	vs_out.UV = info.uv;
+	vs_out.Color = instanceColor;
 	//Calculate TBN matrix
 	vec3 Tangent = normalize(info.tangent);
 	vec3 Normal = normalize(info.normal);